@@ -0,0 +1,151 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/al/al_module.hpp"
+#include "hou/aud/aud_module.hpp"
+#include "hou/cor/cor_module.hpp"
+#include "hou/mth/mth_module.hpp"
+
+#include "hou/aud/audio_buffer.hpp"
+#include "hou/aud/audio_context.hpp"
+#include "hou/aud/buffer_audio_source.hpp"
+#include "hou/aud/manual_stream_audio_source.hpp"
+#include "hou/aud/ogg_file_in.hpp"
+#include "hou/aud/wav_file_in.hpp"
+
+#include "hou/cor/stopwatch.hpp"
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+constexpr hou::uint sample_rate = 44100u;
+constexpr hou::uint channel_count = 2u;
+constexpr size_t chunk_frame_count = 1024u;
+constexpr size_t rendered_seconds = 10u;
+
+struct render_times
+{
+  double cpu_ms_per_second;
+  double wall_ms_per_second;
+};
+
+render_times render(hou::audio_context& ctx,
+  std::vector<hou::manual_stream_audio_source>& stream_sources);
+
+void run_benchmark(hou::audio_context& ctx,
+  const std::shared_ptr<hou::audio_buffer>& buffer,
+  const std::string& stream_file, size_t buffer_source_count,
+  size_t stream_source_count);
+
+
+
+render_times render(hou::audio_context& ctx,
+  std::vector<hou::manual_stream_audio_source>& stream_sources)
+{
+  std::vector<int16_t> output(chunk_frame_count * channel_count);
+  size_t chunk_count = rendered_seconds * sample_rate / chunk_frame_count;
+
+  hou::stopwatch sw;
+  sw.start();
+  std::clock_t cpu_start = std::clock();
+  for(size_t i = 0; i < chunk_count; ++i)
+  {
+    // Stream sources are refilled between chunks, as a game would do once
+    // per frame.
+    for(auto& as : stream_sources)
+    {
+      as.update();
+    }
+    ctx.render(output);
+  }
+  std::clock_t cpu_end = std::clock();
+  std::chrono::duration<double, std::milli> wall_elapsed = sw.stop();
+
+  double rendered_time
+    = static_cast<double>(chunk_count * chunk_frame_count) / sample_rate;
+  double cpu_elapsed_ms
+    = 1000. * static_cast<double>(cpu_end - cpu_start) / CLOCKS_PER_SEC;
+  return render_times{
+    cpu_elapsed_ms / rendered_time, wall_elapsed.count() / rendered_time};
+}
+
+
+
+void run_benchmark(hou::audio_context& ctx,
+  const std::shared_ptr<hou::audio_buffer>& buffer,
+  const std::string& stream_file, size_t buffer_source_count,
+  size_t stream_source_count)
+{
+  std::vector<hou::buffer_audio_source> buffer_sources;
+  buffer_sources.reserve(buffer_source_count);
+  for(size_t i = 0; i < buffer_source_count; ++i)
+  {
+    buffer_sources.emplace_back(buffer);
+    buffer_sources.back().set_looping(true);
+    buffer_sources.back().set_position(
+      hou::vec3f(static_cast<float>(i % 8u), 0.f, 1.f));
+    buffer_sources.back().play();
+  }
+
+  std::vector<hou::manual_stream_audio_source> stream_sources;
+  stream_sources.reserve(stream_source_count);
+  for(size_t i = 0; i < stream_source_count; ++i)
+  {
+    stream_sources.emplace_back(
+      std::make_unique<hou::ogg_file_in>(stream_file));
+    stream_sources.back().set_looping(true);
+    stream_sources.back().play();
+  }
+
+  render_times times = render(ctx, stream_sources);
+  std::cout << buffer_source_count << " buffer sources, "
+            << stream_source_count << " stream sources: "
+            << times.cpu_ms_per_second << " ms CPU, "
+            << times.wall_ms_per_second << " ms wall per rendered second"
+            << std::endl;
+}
+
+}  // namespace
+
+
+
+int main(int, char**)
+{
+  // Initialization.
+  // The system module is not needed, and it requires a display.
+  hou::cor_module::initialize();
+  hou::mth_module::initialize();
+  hou::al_module::initialize();
+  hou::aud_module::initialize();
+
+  // The loopback context renders on demand, without any sound card.
+  hou::audio_context ctx
+    = hou::audio_context::create_loopback(sample_rate, channel_count);
+  hou::audio_context::set_current(ctx);
+
+  const std::string data_dir = u8"source/demo/data/";
+  const std::string wav_file = data_dir + u8"test.wav";
+  const std::string ogg_file = data_dir + u8"test.ogg";
+  auto buffer = std::make_shared<hou::audio_buffer>(hou::wav_file_in(wav_file));
+
+  std::cout << "Rendered seconds per run: " << rendered_seconds << std::endl;
+  run_benchmark(ctx, buffer, ogg_file, 0u, 0u);
+  run_benchmark(ctx, buffer, ogg_file, 16u, 0u);
+  run_benchmark(ctx, buffer, ogg_file, 64u, 0u);
+  run_benchmark(ctx, buffer, ogg_file, 128u, 0u);
+  run_benchmark(ctx, buffer, ogg_file, 0u, 4u);
+  run_benchmark(ctx, buffer, ogg_file, 0u, 16u);
+  run_benchmark(ctx, buffer, ogg_file, 64u, 16u);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,123 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/cor/cor_module.hpp"
+#include "hou/gl/gl_module.hpp"
+#include "hou/mth/mth_module.hpp"
+#include "hou/sys/sys_module.hpp"
+
+#include "hou/gl/gl_buffer_handle.hpp"
+#include "hou/gl/gl_context.hpp"
+#include "hou/gl/gl_context_settings.hpp"
+
+#include "hou/cor/stopwatch.hpp"
+
+#include "hou/sys/window.hpp"
+
+#include <chrono>
+#include <iostream>
+
+#include "SDL_video.h"
+
+
+
+namespace
+{
+
+constexpr size_t iteration_count = 1000000u;
+
+// Number of calls to context::get_current performed by bind_buffer when the
+// bound buffer changes. It is read from the bind_buffer implementation and
+// must be kept in sync with it.
+#ifdef HOU_ENABLE_GL_ERROR_CHECKS
+constexpr size_t get_current_calls_per_bind = 6u;
+#else
+constexpr size_t get_current_calls_per_bind = 2u;
+#endif
+
+template <typename Function>
+double time_iterations(Function f);
+
+
+
+template <typename Function>
+double time_iterations(Function f)
+{
+  hou::stopwatch sw;
+  sw.start();
+  for(size_t i = 0; i < iteration_count; ++i)
+  {
+    f(i);
+  }
+  std::chrono::duration<double, std::nano> elapsed = sw.stop();
+  return elapsed.count() / iteration_count;
+}
+
+}  // namespace
+
+
+
+int main(int, char**)
+{
+  // Setup.
+  hou::cor_module::initialize();
+  hou::mth_module::initialize();
+  hou::sys_module::initialize();
+  hou::gl_module::initialize();
+
+  // Context and window.
+  hou::window wnd("GlContextBenchmark", hou::vec2u(64u, 64u));
+  hou::gl::context ctx(hou::gl::context_settings::get_default(), wnd);
+  hou::gl::context::set_current(ctx, wnd);
+
+  hou::gl::buffer_handle b0 = hou::gl::buffer_handle::create();
+  hou::gl::buffer_handle b1 = hou::gl::buffer_handle::create();
+
+  // Benchmarks.
+  // Before the current context was cached, get_current queried SDL for the
+  // current context and then performed a registry lookup every time it was
+  // called.
+  size_t found = 0u;
+  double lookup_time = time_iterations([&](size_t) {
+    hou::gl::context::impl_type* impl = SDL_GL_GetCurrentContext();
+    found += impl != nullptr
+      && &hou::gl::context::get_from_impl(impl) == &ctx;
+  });
+
+  double cached_time = time_iterations(
+    [&](size_t) { found += hou::gl::context::get_current() == &ctx; });
+
+  double is_bound_time = time_iterations([&](size_t) {
+    found += hou::gl::is_buffer_bound(b0, GL_ARRAY_BUFFER);
+  });
+
+  double bind_time = time_iterations([&](size_t i) {
+    hou::gl::bind_buffer(i % 2u == 0u ? b0 : b1, GL_ARRAY_BUFFER);
+  });
+
+  std::cout << "Iterations: " << iteration_count << " (" << found << ")"
+            << std::endl;
+  std::cout << "Measured:" << std::endl;
+  std::cout << "  get_current (SDL query and registry lookup): "
+            << lookup_time << " ns/call" << std::endl;
+  std::cout << "  get_current (cached): " << cached_time << " ns/call"
+            << std::endl;
+  std::cout << "  is_buffer_bound: " << is_bound_time << " ns/call"
+            << std::endl;
+  std::cout << "  bind_buffer: " << bind_time << " ns/call" << std::endl;
+
+  // bind_buffer can't be run without the cache. Its former cost is therefore
+  // estimated, not measured: the difference between the two lookups is added
+  // to the measured bind_buffer cost for each call to get_current.
+  double estimated_uncached_bind_time = bind_time
+    + static_cast<double>(get_current_calls_per_bind)
+      * (lookup_time - cached_time);
+  std::cout << "Estimated, not measured:" << std::endl;
+  std::cout << "  bind_buffer without the cache: "
+            << estimated_uncached_bind_time << " ns/call (bind_buffer + "
+            << get_current_calls_per_bind << " * lookup difference)"
+            << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,206 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/cor/cor_module.hpp"
+#include "hou/mth/mth_module.hpp"
+
+#include "hou/sys/image.hpp"
+
+#include "hou/cor/stopwatch.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+
+
+namespace
+{
+
+constexpr size_t repetition_count = 5u;
+
+template <typename Function>
+double time_ms(Function f);
+
+template <hou::pixel_format PF>
+void set_sub_image_per_pixel(
+  hou::image2<PF>& dst, const hou::vec2u& offset, const hou::image2<PF>& src);
+
+template <hou::pixel_format PF>
+hou::image2<PF> get_sub_image_per_pixel(const hou::image2<PF>& src,
+  const hou::vec2u& offset, const hou::vec2u& size);
+
+template <hou::pixel_format PF>
+hou::image2<PF> make_pattern_image(const hou::vec2u& size);
+
+void print_result(const std::string& name, double per_pixel_ms, double rows_ms);
+
+void run_atlas_benchmark(const hou::vec2u& atlas_size,
+  const hou::vec2u& glyph_size);
+
+void run_sub_image_benchmark(const hou::vec2u& image_size,
+  const hou::vec2u& sub_image_size);
+
+
+
+template <typename Function>
+double time_ms(Function f)
+{
+  hou::stopwatch sw;
+  sw.start();
+  for(size_t i = 0; i < repetition_count; ++i)
+  {
+    f();
+  }
+  std::chrono::duration<double, std::milli> elapsed = sw.stop();
+  return elapsed.count() / repetition_count;
+}
+
+
+
+// Copies the pixels one by one, in the same order used by the original
+// set_sub_image implementation.
+template <hou::pixel_format PF>
+void set_sub_image_per_pixel(
+  hou::image2<PF>& dst, const hou::vec2u& offset, const hou::image2<PF>& src)
+{
+  for(hou::uint x = 0; x < src.get_size().x(); ++x)
+  {
+    for(hou::uint y = 0; y < src.get_size().y(); ++y)
+    {
+      hou::vec2u pos(x, y);
+      dst.set_pixel(offset + pos, src.get_pixel(pos));
+    }
+  }
+}
+
+
+
+template <hou::pixel_format PF>
+hou::image2<PF> get_sub_image_per_pixel(const hou::image2<PF>& src,
+  const hou::vec2u& offset, const hou::vec2u& size)
+{
+  hou::image2<PF> dst(size);
+  for(hou::uint x = 0; x < size.x(); ++x)
+  {
+    for(hou::uint y = 0; y < size.y(); ++y)
+    {
+      hou::vec2u pos(x, y);
+      dst.set_pixel(pos, src.get_pixel(offset + pos));
+    }
+  }
+  return dst;
+}
+
+
+
+template <hou::pixel_format PF>
+hou::image2<PF> make_pattern_image(const hou::vec2u& size)
+{
+  hou::image2<PF> im(size);
+  for(hou::uint y = 0; y < size.y(); ++y)
+  {
+    for(hou::uint x = 0; x < size.x(); ++x)
+    {
+      hou::pixel<PF> px;
+      px.set_r(static_cast<uint8_t>(x + y));
+      im.set_pixel(hou::vec2u(x, y), px);
+    }
+  }
+  return im;
+}
+
+
+
+void print_result(const std::string& name, double per_pixel_ms, double rows_ms)
+{
+  std::cout << name << ": " << per_pixel_ms << " ms per pixel, " << rows_ms
+            << " ms by rows (" << per_pixel_ms / rows_ms << "x)" << std::endl;
+}
+
+
+
+void run_atlas_benchmark(const hou::vec2u& atlas_size,
+  const hou::vec2u& glyph_size)
+{
+  // Fills the whole atlas with glyph images, as glyph_atlas would do when
+  // rasterizing a large character set.
+  hou::image2_r glyph = make_pattern_image<hou::pixel_format::r>(glyph_size);
+  hou::image2_r atlas(atlas_size);
+  auto fill_atlas = [&](auto copy) {
+    for(hou::uint y = 0; y + glyph_size.y() <= atlas_size.y();
+        y += glyph_size.y())
+    {
+      for(hou::uint x = 0; x + glyph_size.x() <= atlas_size.x();
+          x += glyph_size.x())
+      {
+        copy(hou::vec2u(x, y));
+      }
+    }
+  };
+
+  double per_pixel_ms = time_ms([&]() {
+    fill_atlas([&](const hou::vec2u& pos) {
+      set_sub_image_per_pixel(atlas, pos, glyph);
+    });
+  });
+  double set_sub_image_ms = time_ms([&]() {
+    fill_atlas(
+      [&](const hou::vec2u& pos) { atlas.set_sub_image(pos, glyph); });
+  });
+  double blit_ms = time_ms([&]() {
+    fill_atlas([&](const hou::vec2u& pos) {
+      hou::blit(atlas, hou::vec2i(pos), glyph, hou::vec2u::zero(),
+        glyph.get_size());
+    });
+  });
+
+  std::string name = "Atlas " + std::to_string(atlas_size.x()) + "x"
+    + std::to_string(atlas_size.y()) + ", glyphs "
+    + std::to_string(glyph_size.x()) + "x" + std::to_string(glyph_size.y());
+  print_result(name + ", set_sub_image", per_pixel_ms, set_sub_image_ms);
+  print_result(name + ", blit", per_pixel_ms, blit_ms);
+}
+
+
+
+void run_sub_image_benchmark(const hou::vec2u& image_size,
+  const hou::vec2u& sub_image_size)
+{
+  hou::image2_rgba im
+    = make_pattern_image<hou::pixel_format::rgba>(image_size);
+  hou::vec2u offset = (image_size - sub_image_size) / 2u;
+
+  double per_pixel_ms = time_ms(
+    [&]() { get_sub_image_per_pixel(im, offset, sub_image_size); });
+  double rows_ms
+    = time_ms([&]() { im.get_sub_image(offset, sub_image_size); });
+
+  print_result("get_sub_image " + std::to_string(sub_image_size.x()) + "x"
+      + std::to_string(sub_image_size.y()) + " from "
+      + std::to_string(image_size.x()) + "x" + std::to_string(image_size.y())
+      + " rgba",
+    per_pixel_ms, rows_ms);
+}
+
+}  // namespace
+
+
+
+int main(int, char**)
+{
+  hou::cor_module::initialize();
+  hou::mth_module::initialize();
+
+  std::cout << "Repetitions per measurement: " << repetition_count
+            << std::endl;
+  run_atlas_benchmark(hou::vec2u(1024u, 1024u), hou::vec2u(16u, 16u));
+  run_atlas_benchmark(hou::vec2u(2048u, 2048u), hou::vec2u(32u, 32u));
+  run_atlas_benchmark(hou::vec2u(2048u, 2048u), hou::vec2u(64u, 64u));
+  run_sub_image_benchmark(hou::vec2u(2048u, 2048u), hou::vec2u(256u, 256u));
+  run_sub_image_benchmark(hou::vec2u(2048u, 2048u), hou::vec2u(1024u, 1024u));
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/cor/cor_module.hpp"
+#include "hou/mth/mth_module.hpp"
+
+#include "hou/sys/image_loading.hpp"
+
+#include "hou/cor/stopwatch.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+
+namespace
+{
+
+constexpr size_t repetition_count = 5u;
+
+// Number of times each image is loaded in a batch.
+constexpr size_t copy_count = 64u;
+
+template <typename Function>
+double time_ms(Function f);
+
+std::vector<std::string> get_default_paths();
+
+
+
+template <typename Function>
+double time_ms(Function f)
+{
+  hou::stopwatch sw;
+  sw.start();
+  for(size_t i = 0; i < repetition_count; ++i)
+  {
+    f();
+  }
+  std::chrono::duration<double, std::milli> elapsed = sw.stop();
+  return elapsed.count() / repetition_count;
+}
+
+
+
+std::vector<std::string> get_default_paths()
+{
+  return std::vector<std::string>{
+    u8"./source/demo/data/keyboard.png",
+    u8"./source/demo/data/keyboardkeys.png",
+    u8"./source/demo/data/monalisa.png",
+    u8"./source/demo/data/monkey.png",
+    u8"./source/demo/data/mouse.png",
+    u8"./source/demo/data/mousebuttons.png",
+  };
+}
+
+}  // namespace
+
+
+
+int main(int argc, char** argv)
+{
+  hou::cor_module::initialize();
+  hou::mth_module::initialize();
+
+  // The images to load can be passed on the command line, otherwise the demo
+  // images are used.
+  std::vector<std::string> files(argv + 1, argv + argc);
+  if(files.empty())
+  {
+    files = get_default_paths();
+  }
+  std::vector<std::string> paths;
+  for(size_t i = 0; i < copy_count; ++i)
+  {
+    paths.insert(paths.end(), files.begin(), files.end());
+  }
+
+  std::cout << "Repetitions per measurement: " << repetition_count
+            << std::endl;
+  std::cout << "Images per batch: " << paths.size() << std::endl;
+
+  double sequential_ms = time_ms([&]() {
+    for(const auto& path : paths)
+    {
+      hou::read_image<hou::pixel_format::rgba>(path);
+    }
+  });
+  std::cout << "Sequential: " << sequential_ms << " ms" << std::endl;
+
+  size_t max_thread_count
+    = std::max(4u, std::thread::hardware_concurrency());
+  for(size_t thread_count = 1u; thread_count <= max_thread_count;
+      thread_count *= 2u)
+  {
+    // The callback runs on this thread, where the images would be uploaded
+    // into textures.
+    size_t byte_count = 0u;
+    double parallel_ms = time_ms([&]() {
+      hou::load_images<hou::pixel_format::rgba>(paths, thread_count,
+        [&byte_count](size_t, hou::image2_rgba& im) {
+          byte_count += im.get_pixels().size();
+        });
+    });
+    std::cout << thread_count << " threads: " << parallel_ms << " ms ("
+              << sequential_ms / parallel_ms << "x)" << std::endl;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,133 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/cor/cor_module.hpp"
+#include "hou/mth/mth_module.hpp"
+
+#include "hou/sys/image.hpp"
+#include "hou/sys/pixel_conversion.hpp"
+
+#include "hou/cor/stopwatch.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+constexpr size_t repetition_count = 10u;
+
+template <typename Function>
+double time_ms(Function f);
+
+template <hou::pixel_format PF>
+hou::image2<PF> make_pattern_image(const hou::vec2u& size);
+
+template <hou::pixel_format InPF, hou::pixel_format OutPF>
+void run_conversion_benchmark(const std::string& name, const hou::vec2u& size);
+
+
+
+template <typename Function>
+double time_ms(Function f)
+{
+  hou::stopwatch sw;
+  sw.start();
+  for(size_t i = 0; i < repetition_count; ++i)
+  {
+    f();
+  }
+  std::chrono::duration<double, std::milli> elapsed = sw.stop();
+  return elapsed.count() / repetition_count;
+}
+
+
+
+template <hou::pixel_format PF>
+hou::image2<PF> make_pattern_image(const hou::vec2u& size)
+{
+  hou::image2<PF> im(size);
+  for(hou::uint y = 0; y < size.y(); ++y)
+  {
+    for(hou::uint x = 0; x < size.x(); ++x)
+    {
+      im.set_pixel(hou::vec2u(x, y),
+        hou::pixel_rgba(static_cast<uint8_t>(x), static_cast<uint8_t>(y),
+          static_cast<uint8_t>(x + y), 255u));
+    }
+  }
+  return im;
+}
+
+
+
+template <hou::pixel_format InPF, hou::pixel_format OutPF>
+void run_conversion_benchmark(const std::string& name, const hou::vec2u& size)
+{
+  hou::image2<InPF> in = make_pattern_image<InPF>(size);
+  std::vector<hou::pixel<OutPF>> out(in.get_pixels().size());
+  hou::span<const hou::pixel<InPF>> in_pixels(in.get_pixels());
+  hou::span<hou::pixel<OutPF>> out_pixels(out);
+
+  // Pixels are converted into an existing buffer, so that the allocation is
+  // not measured.
+  double per_pixel_ms = time_ms([&]() {
+    for(size_t i = 0; i < in_pixels.size(); ++i)
+    {
+      out_pixels[i] = hou::pixel<OutPF>(in_pixels[i]);
+    }
+  });
+  std::cout << name << " " << size.x() << "x" << size.y() << ": "
+            << per_pixel_ms << " ms per pixel";
+
+  hou::pixel_conversion_backend default_backend
+    = hou::get_pixel_conversion_backend();
+  for(auto pcb : {hou::pixel_conversion_backend::scalar,
+        hou::pixel_conversion_backend::sse2,
+        hou::pixel_conversion_backend::avx2,
+        hou::pixel_conversion_backend::neon})
+  {
+    if(hou::is_pixel_conversion_backend_supported(pcb))
+    {
+      hou::set_pixel_conversion_backend(pcb);
+      double ms
+        = time_ms([&]() { hou::convert_pixels(in_pixels, out_pixels); });
+      std::cout << ", " << ms << " ms " << pcb << " (" << per_pixel_ms / ms
+                << "x)";
+    }
+  }
+  hou::set_pixel_conversion_backend(default_backend);
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+
+
+int main(int, char**)
+{
+  hou::cor_module::initialize();
+  hou::mth_module::initialize();
+
+  std::cout << "Repetitions per measurement: " << repetition_count
+            << std::endl;
+  std::cout << "Default backend: " << hou::get_pixel_conversion_backend()
+            << std::endl;
+  hou::vec2u size(2048u, 2048u);
+  run_conversion_benchmark<hou::pixel_format::rgba, hou::pixel_format::r>(
+    "rgba -> r", size);
+  run_conversion_benchmark<hou::pixel_format::rgba, hou::pixel_format::rgb>(
+    "rgba -> rgb", size);
+  run_conversion_benchmark<hou::pixel_format::rgb, hou::pixel_format::rgba>(
+    "rgb -> rgba", size);
+  run_conversion_benchmark<hou::pixel_format::rg, hou::pixel_format::rgba>(
+    "rg -> rgba", size);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/cor/cor_module.hpp"
+#include "hou/gfx/gfx_module.hpp"
+#include "hou/gl/gl_module.hpp"
+#include "hou/mth/mth_module.hpp"
+#include "hou/sys/sys_module.hpp"
+
+#include "hou/gfx/font.hpp"
+#include "hou/gfx/formatted_text.hpp"
+#include "hou/gfx/glyph_atlas.hpp"
+#include "hou/gfx/graphic_context.hpp"
+#include "hou/gfx/render_surface.hpp"
+#include "hou/gfx/text_batch.hpp"
+#include "hou/gfx/text_mesh_renderer.hpp"
+
+#include "hou/gl/gl_vsync_mode.hpp"
+
+#include "hou/cor/stopwatch.hpp"
+
+#include "hou/mth/transform2.hpp"
+
+#include "hou/sys/binary_file_in.hpp"
+#include "hou/sys/window.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+
+namespace
+{
+
+constexpr size_t label_count = 10000u;
+constexpr size_t frame_count = 20u;
+
+template <typename DrawFunction>
+double time_frames(hou::render_surface& rs, DrawFunction draw);
+
+
+
+template <typename DrawFunction>
+double time_frames(hou::render_surface& rs, DrawFunction draw)
+{
+  hou::stopwatch sw;
+  sw.start();
+  for(size_t i = 0; i < frame_count; ++i)
+  {
+    rs.clear(hou::color::black());
+    draw();
+    rs.display();
+  }
+  std::chrono::duration<double, std::milli> elapsed = sw.stop();
+  return elapsed.count() / frame_count;
+}
+
+}  // namespace
+
+
+
+int main(int, char**)
+{
+  // Setup.
+  hou::cor_module::initialize();
+  hou::mth_module::initialize();
+  hou::sys_module::initialize();
+  hou::gl_module::initialize();
+  hou::gfx_module::initialize();
+
+  // Context and window.
+  hou::graphic_context gctx;
+  hou::window wnd("TextBatchBenchmark", hou::vec2u(800u, 600u));
+  hou::graphic_context::set_current(gctx, wnd);
+  hou::gl::set_vsync_mode(hou::gl::vsync_mode::disabled);
+  wnd.set_visible(true);
+
+  hou::render_surface rs(wnd.get_size());
+  hou::trans2f proj = hou::trans2f::orthographic_projection(
+    hou::rectf(0.f, 0.f, rs.get_size().x(), rs.get_size().y()));
+  hou::font f
+    = hou::font(hou::binary_file_in(u8"./source/demo/data/NotoSans-Regular.ttf"));
+  f.set_pixel_height(12u);
+
+  // Labels with one atlas each, as rendered by text_mesh_renderer.
+  std::vector<hou::formatted_text> own_atlas_labels;
+  own_atlas_labels.reserve(label_count);
+  for(size_t i = 0; i < label_count; ++i)
+  {
+    own_atlas_labels.emplace_back(u8"Label " + std::to_string(i), f);
+  }
+
+  // Labels sharing a single atlas, as rendered by text_batch.
+  hou::glyph_atlas atlas;
+  std::vector<hou::formatted_text> shared_atlas_labels;
+  shared_atlas_labels.reserve(label_count);
+  for(size_t i = 0; i < label_count; ++i)
+  {
+    shared_atlas_labels.emplace_back(
+      u8"Label " + std::to_string(i), f, atlas);
+  }
+
+  std::vector<hou::trans2f> transforms;
+  transforms.reserve(label_count);
+  for(size_t i = 0; i < label_count; ++i)
+  {
+    transforms.push_back(proj
+      * hou::trans2f::translation(
+          hou::vec2f(static_cast<float>((i * 80u) % rs.get_size().x()),
+            static_cast<float>((i * 12u) % rs.get_size().y()))));
+  }
+
+  // Benchmarks.
+  hou::text_mesh_renderer tmr;
+  double tmr_time = time_frames(rs, [&]() {
+    for(size_t i = 0; i < label_count; ++i)
+    {
+      tmr.draw(rs, own_atlas_labels[i], hou::color::white(), transforms[i]);
+    }
+  });
+
+  hou::text_batch tb;
+  size_t draw_calls = 0u;
+  double tb_time = time_frames(rs, [&]() {
+    for(size_t i = 0; i < label_count; ++i)
+    {
+      tb.add(shared_atlas_labels[i], hou::color::white(), transforms[i]);
+    }
+    draw_calls = tb.get_draw_call_count();
+    tb.draw(rs);
+  });
+
+  std::cout << "Labels per frame: " << label_count << std::endl;
+  std::cout << "text_mesh_renderer: " << tmr_time << " ms/frame, "
+            << label_count << " draw calls" << std::endl;
+  std::cout << "text_batch: " << tb_time << " ms/frame, " << draw_calls
+            << " draw calls" << std::endl;
+
+  return EXIT_SUCCESS;
+}
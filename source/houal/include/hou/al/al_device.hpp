@@ -47,6 +47,28 @@ public:
    */
   static std::vector<std::string> get_device_names();
 
+  /**
+   * Opens a loopback device.
+   *
+   * A loopback device does not output to any hardware device.
+   * Instead, the mixed output is rendered on demand by calling render_samples,
+   * in signed 16-bit interleaved format.
+   * This requires the ALC_SOFT_loopback extension.
+   *
+   * \param sample_rate the output sample rate.
+   *
+   * \param channel_count the number of output channels, either 1 or 2.
+   *
+   * \throws hou::precondition_violation if sample_rate is 0 or if
+   * channel_count is not 1 or 2.
+   *
+   * \throws hou::al::device_open_error if the loopback device could not be
+   * opened or if the output format is not supported.
+   *
+   * \return the loopback device.
+   */
+  static device open_loopback(uint sample_rate, uint channel_count);
+
 public:
   /**
    * Creates a reference to the default device.
@@ -97,9 +119,50 @@ public:
    */
   uid_type get_uid() const noexcept;
 
+  /**
+   * Checks if this is a loopback device.
+   *
+   * \return true if this is a loopback device.
+   */
+  bool is_loopback() const noexcept;
+
+  /**
+   * Gets the output sample rate of a loopback device.
+   *
+   * \return the output sample rate, or 0 if this is not a loopback device.
+   */
+  uint get_loopback_sample_rate() const noexcept;
+
+  /**
+   * Gets the number of output channels of a loopback device.
+   *
+   * \return the number of output channels, or 0 if this is not a loopback
+   * device.
+   */
+  uint get_loopback_channel_count() const noexcept;
+
+  /**
+   * Renders the mixed output of a loopback device.
+   *
+   * The context of this device must be current.
+   *
+   * \param buf the destination buffer. It must be large enough to contain
+   * frame_count * get_loopback_channel_count() signed 16-bit samples.
+   *
+   * \param frame_count the number of sample frames to be rendered.
+   *
+   * \throws hou::precondition_violation if this is not a loopback device.
+   */
+  void render_samples(void* buf, size_t frame_count);
+
+private:
+  device(ALCdevice* dev, uint sample_rate, uint channel_count);
+
 private:
   ALCdevice* m_device;
   uint32_t m_uid;
+  uint m_loopback_sample_rate;
+  uint m_loopback_channel_count;
 };
 
 }  // namespace al
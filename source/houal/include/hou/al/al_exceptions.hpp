@@ -75,7 +75,7 @@ public:
  *
  * \throws hou::al::call_error if a previous OpenAL call has failed.
  */
-void HOU_AL_API check_error(const std::string& path, int line);
+void HOU_AL_API check_error(const char* path, int line);
 
 /** Checks if an OpenAL context call has failed and throws an exception in case.
  *
@@ -88,7 +88,7 @@ void HOU_AL_API check_error(const std::string& path, int line);
  * \throws hou::al::context_call_error if a previous OpenAL call has failed.
  */
 void HOU_AL_API check_context_error(
-  device& device, const std::string& path, int line);
+  device& device, const char* path, int line);
 
 }  // namespace al
 
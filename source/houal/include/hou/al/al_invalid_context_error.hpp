@@ -57,7 +57,7 @@ public:
  * not own the object.
  */
 void HOU_AL_API check_context_ownership(
-  const device_owned_object_handle& o, const std::string& path, int line);
+  const device_owned_object_handle& o, const char* path, int line);
 
 /** Checks if the object is owned by the current context, and throws an
  * exception if it is not.
@@ -74,7 +74,7 @@ void HOU_AL_API check_context_ownership(
  * not own the object.
  */
 void HOU_AL_API check_context_ownership(
-  const context_owned_object_handle& o, const std::string& path, int line);
+  const context_owned_object_handle& o, const char* path, int line);
 
 }  // namespace al
 
@@ -48,7 +48,7 @@ public:
  *
  * \throws hou::al::missing_context_error if there is no current OpenAL context.
  */
-void HOU_AL_API check_context_existence(const std::string& path, int line);
+void HOU_AL_API check_context_existence(const char* path, int line);
 
 }  // namespace al
 
@@ -26,6 +26,9 @@ ALfloat HOU_AL_API get_doppler_factor();
 void HOU_AL_API set_speed_of_sound(ALfloat value);
 ALfloat HOU_AL_API get_speed_of_sound();
 
+void HOU_AL_API defer_updates();
+void HOU_AL_API process_updates();
+
 }  // namespace al
 
 }  // namespace hou
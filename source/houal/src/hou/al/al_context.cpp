@@ -7,8 +7,11 @@
 #include "hou/al/al_context_exceptions.hpp"
 #include "hou/al/al_device.hpp"
 
+#include "hou/cor/narrow_cast.hpp"
 #include "hou/cor/uid_generator.hpp"
 
+#include <AL/alext.h>
+
 #include <mutex>
 
 
@@ -28,6 +31,8 @@ context* g_current_context = nullptr;
 
 uint32_t generate_uid();
 
+ALCcontext* create_context(device& dev);
+
 
 
 uint32_t generate_uid()
@@ -36,6 +41,28 @@ uint32_t generate_uid()
   return uid_gen.generate();
 }
 
+
+
+ALCcontext* create_context(device& dev)
+{
+  if(!dev.is_loopback())
+  {
+    return alcCreateContext(dev.get_impl(), nullptr);
+  }
+
+  // The context of a loopback device must specify the output format.
+  const ALCint attributes[] = {
+    ALC_FORMAT_CHANNELS_SOFT,
+    dev.get_loopback_channel_count() == 1u ? ALC_MONO_SOFT : ALC_STEREO_SOFT,
+    ALC_FORMAT_TYPE_SOFT,
+    ALC_SHORT_SOFT,
+    ALC_FREQUENCY,
+    narrow_cast<ALCint>(dev.get_loopback_sample_rate()),
+    0,
+  };
+  return alcCreateContext(dev.get_impl(), attributes);
+}
+
 }  // namespace
 
 
@@ -69,7 +96,7 @@ context* context::get_current()
 
 context::context(device& dev)
   : non_copyable()
-  , m_context(alcCreateContext(dev.get_impl(), nullptr))
+  , m_context(create_context(dev))
   , m_uid(generate_uid())
   , m_device_uid(dev.get_uid())
 {
@@ -5,11 +5,14 @@
 #include "hou/al/al_device.hpp"
 
 #include "hou/al/al_context_exceptions.hpp"
+#include "hou/al/al_exceptions.hpp"
 
 #include "hou/cor/assertions.hpp"
+#include "hou/cor/narrow_cast.hpp"
 #include "hou/cor/std_string.hpp"
 
 #include <AL/al.h>
+#include <AL/alext.h>
 
 
 
@@ -24,6 +27,11 @@ namespace
 
 uint32_t generate_uid();
 
+template <typename FunctionPtr>
+FunctionPtr get_extension_function(const ALCchar* name);
+
+ALCenum get_loopback_channels_format(uint channel_count);
+
 
 
 uint32_t generate_uid()
@@ -32,6 +40,24 @@ uint32_t generate_uid()
   return uid_gen.generate();
 }
 
+
+
+template <typename FunctionPtr>
+FunctionPtr get_extension_function(const ALCchar* name)
+{
+  FunctionPtr f
+    = reinterpret_cast<FunctionPtr>(alcGetProcAddress(nullptr, name));
+  HOU_DEV_ASSERT(f != nullptr);
+  return f;
+}
+
+
+
+ALCenum get_loopback_channels_format(uint channel_count)
+{
+  return channel_count == 1u ? ALC_MONO_SOFT : ALC_STEREO_SOFT;
+}
+
 }  // namespace
 
 
@@ -49,10 +75,41 @@ std::vector<std::string> device::get_device_names()
 
 
 
+device device::open_loopback(uint sample_rate, uint channel_count)
+{
+  HOU_PRECOND(sample_rate > 0u);
+  HOU_PRECOND(channel_count == 1u || channel_count == 2u);
+
+  HOU_CHECK_N(alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback") == ALC_TRUE,
+    device_open_error, u8"loopback device");
+
+  static LPALCLOOPBACKOPENDEVICESOFT loopback_open_device
+    = get_extension_function<LPALCLOOPBACKOPENDEVICESOFT>(
+      "alcLoopbackOpenDeviceSOFT");
+  static LPALCISRENDERFORMATSUPPORTEDSOFT is_render_format_supported
+    = get_extension_function<LPALCISRENDERFORMATSUPPORTEDSOFT>(
+      "alcIsRenderFormatSupportedSOFT");
+
+  // If the format is not supported, the device is closed when dev is
+  // destroyed.
+  device dev(loopback_open_device(nullptr), sample_rate, channel_count);
+  HOU_CHECK_N(dev.m_device != nullptr, device_open_error, u8"loopback device");
+  HOU_CHECK_N(is_render_format_supported(dev.m_device,
+                narrow_cast<ALCsizei>(sample_rate),
+                get_loopback_channels_format(channel_count), ALC_SHORT_SOFT)
+      == ALC_TRUE,
+    device_open_error, u8"loopback device");
+  return dev;
+}
+
+
+
 device::device()
   : non_copyable()
   , m_device(alcOpenDevice(nullptr))
   , m_uid(generate_uid())
+  , m_loopback_sample_rate(0u)
+  , m_loopback_channel_count(0u)
 {
   HOU_CHECK_N(m_device != nullptr, device_open_error, u8"default device");
 }
@@ -63,18 +120,34 @@ device::device(const std::string& dev_name)
   : non_copyable()
   , m_device(alcOpenDevice(dev_name.c_str()))
   , m_uid(generate_uid())
+  , m_loopback_sample_rate(0u)
+  , m_loopback_channel_count(0u)
 {
   HOU_CHECK_N(m_device != nullptr, device_open_error, dev_name);
 }
 
 
 
+device::device(ALCdevice* dev, uint sample_rate, uint channel_count)
+  : non_copyable()
+  , m_device(dev)
+  , m_uid(generate_uid())
+  , m_loopback_sample_rate(sample_rate)
+  , m_loopback_channel_count(channel_count)
+{}
+
+
+
 device::device(device&& other) noexcept
   : m_device(std::move(other.m_device))
   , m_uid(std::move(other.m_uid))
+  , m_loopback_sample_rate(std::move(other.m_loopback_sample_rate))
+  , m_loopback_channel_count(std::move(other.m_loopback_channel_count))
 {
   other.m_device = nullptr;
   other.m_uid = 0u;
+  other.m_loopback_sample_rate = 0u;
+  other.m_loopback_channel_count = 0u;
 }
 
 
@@ -108,6 +181,38 @@ device::uid_type device::get_uid() const noexcept
   return m_uid;
 }
 
+
+
+bool device::is_loopback() const noexcept
+{
+  return m_loopback_channel_count > 0u;
+}
+
+
+
+uint device::get_loopback_sample_rate() const noexcept
+{
+  return m_loopback_sample_rate;
+}
+
+
+
+uint device::get_loopback_channel_count() const noexcept
+{
+  return m_loopback_channel_count;
+}
+
+
+
+void device::render_samples(void* buf, size_t frame_count)
+{
+  HOU_PRECOND(is_loopback());
+  static LPALCRENDERSAMPLESSOFT render_samples_soft
+    = get_extension_function<LPALCRENDERSAMPLESSOFT>("alcRenderSamplesSOFT");
+  render_samples_soft(m_device, buf, narrow_cast<ALCsizei>(frame_count));
+  HOU_AL_CHECK_CONTEXT_ERROR(*this);
+}
+
 }  // namespace al
 
 }  // namespace hou
@@ -81,7 +81,7 @@ context_call_error::context_call_error(
 
 
 
-void check_error(const std::string& path, int line)
+void check_error(const char* path, int line)
 {
   ALenum err_state = alGetError();
   if(err_state != AL_NO_ERROR)
@@ -92,7 +92,7 @@ void check_error(const std::string& path, int line)
 
 
 
-void check_context_error(device& dev, const std::string& path, int line)
+void check_context_error(device& dev, const char* path, int line)
 {
   ALCenum err_state = alcGetError(dev.get_impl());
   if(err_state != ALC_NO_ERROR)
@@ -27,7 +27,7 @@ invalid_context_error::invalid_context_error(const std::string& path, uint line)
 
 
 void check_context_ownership(
-  const device_owned_object_handle& o, const std::string& path, int line)
+  const device_owned_object_handle& o, const char* path, int line)
 {
   if(context::get_current()->get_device_uid() != o.get_owning_device_uid())
   {
@@ -38,7 +38,7 @@ void check_context_ownership(
 
 
 void check_context_ownership(
-  const context_owned_object_handle& o, const std::string& path, int line)
+  const context_owned_object_handle& o, const char* path, int line)
 {
   if(context::get_current()->get_uid() != o.get_owning_context_uid())
   {
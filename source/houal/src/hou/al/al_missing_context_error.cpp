@@ -20,7 +20,7 @@ missing_context_error::missing_context_error(const std::string& path, uint line)
 
 
 
-void check_context_existence(const std::string& path, int line)
+void check_context_existence(const char* path, int line)
 {
   if(context::get_current() == nullptr)
   {
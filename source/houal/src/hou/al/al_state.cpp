@@ -8,6 +8,10 @@
 #include "hou/al/al_invalid_context_error.hpp"
 #include "hou/al/al_missing_context_error.hpp"
 
+#include "hou/cor/assertions.hpp"
+
+#include <AL/alext.h>
+
 
 
 namespace hou
@@ -16,6 +20,33 @@ namespace hou
 namespace al
 {
 
+namespace
+{
+
+constexpr const ALchar* deferred_updates_ext_name = "AL_SOFT_deferred_updates";
+
+template <typename FunctionPtr>
+FunctionPtr get_deferred_updates_function(const ALchar* name);
+
+
+
+template <typename FunctionPtr>
+FunctionPtr get_deferred_updates_function(const ALchar* name)
+{
+  if(alIsExtensionPresent(deferred_updates_ext_name) != AL_TRUE)
+  {
+    return nullptr;
+  }
+  FunctionPtr f = reinterpret_cast<FunctionPtr>(alGetProcAddress(name));
+  HOU_DEV_ASSERT(f != nullptr);
+  return f;
+}
+
+}  // namespace
+
+
+
+
 void set_distance_model(ALenum value)
 {
   HOU_AL_CHECK_CONTEXT_EXISTENCE();
@@ -71,6 +102,47 @@ ALfloat get_speed_of_sound()
   return value;
 }
 
+
+
+void defer_updates()
+{
+  HOU_AL_CHECK_CONTEXT_EXISTENCE();
+  // AL_SOFT_deferred_updates is preferred, as alcSuspendContext is a no-op in
+  // many implementations.
+  // The function is looked up only once, the extension being provided by the
+  // OpenAL implementation rather than by a specific context.
+  static LPALDEFERUPDATESSOFT defer_updates_soft
+    = get_deferred_updates_function<LPALDEFERUPDATESSOFT>("alDeferUpdatesSOFT");
+  if(defer_updates_soft != nullptr)
+  {
+    defer_updates_soft();
+  }
+  else
+  {
+    alcSuspendContext(alcGetCurrentContext());
+  }
+  HOU_AL_CHECK_ERROR();
+}
+
+
+
+void process_updates()
+{
+  HOU_AL_CHECK_CONTEXT_EXISTENCE();
+  static LPALPROCESSUPDATESSOFT process_updates_soft
+    = get_deferred_updates_function<LPALPROCESSUPDATESSOFT>(
+      "alProcessUpdatesSOFT");
+  if(process_updates_soft != nullptr)
+  {
+    process_updates_soft();
+  }
+  else
+  {
+    alcProcessContext(alcGetCurrentContext());
+  }
+  HOU_AL_CHECK_ERROR();
+}
+
 }  // namespace al
 
 }  // namespace hou
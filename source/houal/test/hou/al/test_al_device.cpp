@@ -29,6 +29,9 @@ TEST_F(test_al_device, default_device_creation)
   al::device d;
   EXPECT_NE(nullptr, d.get_impl());
   EXPECT_NE(0u, d.get_uid());
+  EXPECT_FALSE(d.is_loopback());
+  EXPECT_EQ(0u, d.get_loopback_sample_rate());
+  EXPECT_EQ(0u, d.get_loopback_channel_count());
 }
 
 
@@ -68,3 +71,45 @@ TEST_F(test_al_device, move_constructor)
   EXPECT_EQ(handle_ref, d.get_impl());
   EXPECT_EQ(uid_ref, d.get_uid());
 }
+
+
+
+TEST_F(test_al_device, loopback_creation)
+{
+  al::device d = al::device::open_loopback(44100u, 2u);
+  EXPECT_NE(nullptr, d.get_impl());
+  EXPECT_NE(0u, d.get_uid());
+  EXPECT_TRUE(d.is_loopback());
+  EXPECT_EQ(44100u, d.get_loopback_sample_rate());
+  EXPECT_EQ(2u, d.get_loopback_channel_count());
+}
+
+
+
+TEST_F(test_al_device_death_test, loopback_creation_error_invalid_format)
+{
+  EXPECT_PRECOND_ERROR(al::device::open_loopback(0u, 2u));
+  EXPECT_PRECOND_ERROR(al::device::open_loopback(44100u, 0u));
+  EXPECT_PRECOND_ERROR(al::device::open_loopback(44100u, 3u));
+}
+
+
+
+TEST_F(test_al_device, loopback_move_constructor)
+{
+  al::device d_dummy = al::device::open_loopback(22050u, 1u);
+  al::device d(std::move(d_dummy));
+  EXPECT_FALSE(d_dummy.is_loopback());
+  EXPECT_TRUE(d.is_loopback());
+  EXPECT_EQ(22050u, d.get_loopback_sample_rate());
+  EXPECT_EQ(1u, d.get_loopback_channel_count());
+}
+
+
+
+TEST_F(test_al_device_death_test, render_samples_error_not_loopback)
+{
+  al::device d;
+  std::vector<int16_t> buffer(64u);
+  EXPECT_PRECOND_ERROR(d.render_samples(buffer.data(), 32u));
+}
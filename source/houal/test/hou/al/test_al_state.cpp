@@ -44,3 +44,13 @@ TEST_F(test_al_state, set_speed_of_sound)
   al::set_speed_of_sound(0.5f);
   EXPECT_FLOAT_EQ(0.5f, al::get_speed_of_sound());
 }
+
+
+
+TEST_F(test_al_state, deferred_updates)
+{
+  al::defer_updates();
+  al::set_doppler_factor(0.5f);
+  al::process_updates();
+  EXPECT_FLOAT_EQ(0.5f, al::get_doppler_factor());
+}
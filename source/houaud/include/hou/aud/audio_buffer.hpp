@@ -36,6 +36,9 @@ namespace hou
  * For large audio data this might be expensive.
  * In that case, it is suggested to use audio streams and a
  * automatic_stream_audio_source.
+ *
+ * The buffer properties are cached when the data is set, so that reading them
+ * does not require querying OpenAL.
  */
 class HOU_AUD_API audio_buffer : public non_copyable
 {
@@ -56,6 +59,10 @@ public:
    * \param format the audio format.
    *
    * \param smp_rate the sample rate.
+   *
+   * \throws hou::precondition_violation if the sample rate is not positive or
+   * if the size of data is not a multiple of the size of a sample for all
+   * channels.
    */
   audio_buffer(
     const span<const uint8_t>& data, audio_buffer_format format, int smp_rate);
@@ -68,6 +75,10 @@ public:
    * \param format the audio format.
    *
    * \param smp_rate the sample rate.
+   *
+   * \throws hou::precondition_violation if the sample rate is not positive or
+   * if the size of data is not a multiple of the size of a sample for all
+   * channels.
    */
   audio_buffer(
     std::vector<uint8_t>&& data, audio_buffer_format format, int smp_rate);
@@ -150,6 +161,10 @@ public:
    * \param format the audio format.
    *
    * \param smlRate the sample rate.
+   *
+   * \throws hou::precondition_violation if the sample rate is not positive or
+   * if the size of data is not a multiple of the size of a sample for all
+   * channels.
    */
   void set_data(
     const span<const uint8_t>& data, audio_buffer_format format, int smlRate);
@@ -162,6 +177,10 @@ public:
    * \param format the audio format.
    *
    * \param smlRate the sample rate.
+   *
+   * \throws hou::precondition_violation if the sample rate is not positive or
+   * if the size of data is not a multiple of the size of a sample for all
+   * channels.
    */
   void set_data(
     std::vector<uint8_t>&& data, audio_buffer_format format, int smlRate);
@@ -185,6 +204,9 @@ public:
 
 private:
   al::buffer_handle m_handle;
+  audio_buffer_format m_format;
+  int m_sample_rate;
+  uint m_byte_count;
 };
 
 }  // namespace hou
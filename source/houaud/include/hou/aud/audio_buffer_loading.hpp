@@ -0,0 +1,115 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_AUD_AUDIO_BUFFER_LOADING_HPP
+#define HOU_AUD_AUDIO_BUFFER_LOADING_HPP
+
+#include "hou/aud/audio_buffer.hpp"
+
+#include "hou/aud/aud_config.hpp"
+
+#include <string>
+#include <vector>
+
+
+
+namespace hou
+{
+
+/**
+ * Default number of samples decoded by a single task when loading ogg files.
+ */
+constexpr size_t default_ogg_chunk_sample_count = 1u << 16;
+
+/**
+ * Decodes an ogg file with multiple threads.
+ *
+ * The file is split into chunks of chunk_sample_count samples.
+ * Each chunk is decoded by a worker thread with its own ogg stream, starting
+ * from its first sample, directly into its part of the final PCM data.
+ * The result is identical to reading the whole file with an ogg_file_in.
+ *
+ * \param path the path to the ogg file.
+ *
+ * \param thread_count the number of worker threads.
+ *
+ * \param chunk_sample_count the number of samples in a chunk.
+ *
+ * \throws hou::precondition_violation if thread_count or chunk_sample_count is
+ * 0.
+ *
+ * \throws hou::file_open_error if the file could not be opened.
+ *
+ * \throws hou::invalid_audio_data if the file is not a valid ogg file.
+ *
+ * \throws hou::read_error if the file could not be decoded.
+ *
+ * \return the PCM data.
+ */
+HOU_AUD_API std::vector<uint8_t> decode_ogg_file(const std::string& path,
+  size_t thread_count,
+  size_t chunk_sample_count = default_ogg_chunk_sample_count);
+
+/**
+ * Loads an ogg file into an audio_buffer, decoding it with multiple threads.
+ *
+ * The file is decoded as by decode_ogg_file.
+ * The audio_buffer is then created in the calling thread, which must have a
+ * current audio_context.
+ *
+ * \param path the path to the ogg file.
+ *
+ * \param thread_count the number of worker threads.
+ *
+ * \param chunk_sample_count the number of samples in a chunk.
+ *
+ * \throws hou::precondition_violation if thread_count or chunk_sample_count is
+ * 0.
+ *
+ * \throws hou::file_open_error if the file could not be opened.
+ *
+ * \throws hou::invalid_audio_data if the file is not a valid ogg file.
+ *
+ * \throws hou::read_error if the file could not be decoded.
+ *
+ * \return the audio_buffer.
+ */
+HOU_AUD_API audio_buffer load_ogg_audio_buffer(const std::string& path,
+  size_t thread_count,
+  size_t chunk_sample_count = default_ogg_chunk_sample_count);
+
+/**
+ * Loads many ogg files into audio buffers, decoding them with multiple
+ * threads.
+ *
+ * The chunks of all the files are decoded concurrently by the same set of
+ * worker threads, so that a batch of short files and a single long file are
+ * loaded equally efficiently.
+ * The audio buffers are then created in the calling thread, which must have a
+ * current audio_context.
+ *
+ * \param paths the paths to the ogg files.
+ *
+ * \param thread_count the number of worker threads.
+ *
+ * \param chunk_sample_count the number of samples in a chunk.
+ *
+ * \throws hou::precondition_violation if thread_count or chunk_sample_count is
+ * 0.
+ *
+ * \throws hou::file_open_error if a file could not be opened.
+ *
+ * \throws hou::invalid_audio_data if a file is not a valid ogg file.
+ *
+ * \throws hou::read_error if a file could not be decoded.
+ *
+ * \return the audio buffers, in the same order as paths.
+ */
+HOU_AUD_API std::vector<audio_buffer> load_ogg_audio_buffers(
+  const std::vector<std::string>& paths, size_t thread_count,
+  size_t chunk_sample_count = default_ogg_chunk_sample_count);
+
+}  // namespace hou
+
+#endif
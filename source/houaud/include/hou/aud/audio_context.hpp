@@ -6,6 +6,7 @@
 #define HOU_AUD_AUDIO_CONTEXT_HPP
 
 #include "hou/cor/non_copyable.hpp"
+#include "hou/cor/span.hpp"
 
 #include "hou/aud/aud_config.hpp"
 
@@ -65,6 +66,28 @@ public:
    */
   static std::vector<std::string> get_device_names();
 
+  /**
+   * Creates an audio_context on a loopback device.
+   *
+   * A loopback audio_context does not output to any hardware device.
+   * The mixed output is rendered on demand by calling render, which makes it
+   * possible to use audio on machines without a sound card, and to measure
+   * the mixing cost deterministically.
+   *
+   * \param sample_rate the output sample rate.
+   *
+   * \param channel_count the number of output channels, either 1 or 2.
+   *
+   * \throws hou::precondition_violation if sample_rate is 0 or if
+   * channel_count is not 1 or 2.
+   *
+   * \throws hou::al::device_open_error if the loopback device could not be
+   * opened.
+   *
+   * \return the loopback audio_context.
+   */
+  static audio_context create_loopback(uint sample_rate, uint channel_count);
+
 public:
   /**
    * Creates an audio_context and sets it as the current audio_context.
@@ -115,6 +138,32 @@ public:
    */
   device_type& get_device() noexcept;
 
+  /**
+   * Checks if this audio_context uses a loopback device.
+   *
+   * \return true if this audio_context uses a loopback device.
+   */
+  bool is_loopback() const noexcept;
+
+  /**
+   * Renders the mixed output of a loopback audio_context.
+   *
+   * The output is in signed 16-bit interleaved format.
+   * The number of rendered sample frames is the size of the buffer divided by
+   * the number of output channels.
+   * This audio_context must be current.
+   *
+   * \param buffer the destination buffer.
+   *
+   * \throws hou::precondition_violation if this audio_context does not use a
+   * loopback device, if it is not current, or if the size of the buffer is not
+   * a multiple of the number of output channels.
+   */
+  void render(const span<int16_t>& buffer);
+
+private:
+  explicit audio_context(device_type&& dev);
+
 private:
   al::device m_al_device;
   al::context m_al_context;
@@ -24,6 +24,11 @@ namespace hou
 
 /**
  * Parent class for audio sources.
+ *
+ * The properties set by the user are cached, so that reading them does not
+ * require querying OpenAL.
+ * The playback state and position are always queried, since they are changed
+ * by OpenAL itself.
  */
 class HOU_AUD_API audio_source : public non_copyable
 {
@@ -329,7 +334,7 @@ public:
   /**
    * Sets the audio source cone outer gain.
    *
-   * Throws if the provided value is null or negative.
+   * Throws if the provided value is negative or greater than 1.
    *
    * \param value the cone outer gain.
    */
@@ -438,19 +443,29 @@ protected:
   virtual sample_position on_get_sample_pos() const = 0;
 
   /**
-   * Called when play() or replay() are called.
+   * Called when play() or replay() are called, or when the sample position
+   * is changed during playback.
    *
    * This function does nothing by default, but may contain special behaviour.
    */
   virtual void on_play() = 0;
 
   /**
-   * Called when pause(), stop() or replay() are called.
+   * Called when pause(), stop() or replay() are called, or when the sample
+   * position is changed during playback.
    *
    * This function does nothing by default, but may contain special behaviour.
    */
   virtual void on_pause() = 0;
 
+  /**
+   * Called after the audio source has been started by play() or replay(),
+   * or restarted after changing the sample position during playback.
+   *
+   * This function does nothing by default, but may contain special behaviour.
+   */
+  virtual void on_played();
+
 private:
   virtual audio_buffer_format get_format_internal() const = 0;
   virtual uint get_channel_count_internal() const = 0;
@@ -461,6 +476,21 @@ private:
 private:
   al::source_handle m_handle;
   sample_position m_requested_sample_pos;
+  vec3f m_position;
+  vec3f m_velocity;
+  vec3f m_direction;
+  float m_pitch;
+  float m_gain;
+  float m_max_gain;
+  float m_min_gain;
+  float m_max_distance;
+  float m_rolloff_factor;
+  float m_reference_distance;
+  float m_cone_outer_gain;
+  float m_cone_inner_angle_deg;
+  float m_cone_outer_angle_deg;
+  bool m_looping;
+  bool m_relative;
 };
 
 }  // namespace hou
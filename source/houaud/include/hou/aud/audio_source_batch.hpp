@@ -0,0 +1,114 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_AUD_AUDIO_SOURCE_BATCH_HPP
+#define HOU_AUD_AUDIO_SOURCE_BATCH_HPP
+
+#include "hou/aud/aud_config.hpp"
+
+#include "hou/cor/non_copyable.hpp"
+#include "hou/cor/span.hpp"
+
+#include "hou/mth/matrix.hpp"
+
+
+
+namespace hou
+{
+
+class audio_source;
+
+/**
+ * Applies changes to many audio sources as a single atomic update.
+ *
+ * While an audio_source_batch is alive, the changes made to audio sources and
+ * to the listener are deferred, and they are applied all at once when the
+ * batch is committed or destroyed.
+ * Inside a batch, each change is still a separate OpenAL call taking the
+ * context lock, for example one per set_position call. Only the propagation of
+ * the changes to the mixer is deferred, so that it happens once per batch
+ * instead of once per change.
+ *
+ * The AL_SOFT_deferred_updates extension is used if available, otherwise the
+ * context is suspended.
+ * Batches must not be nested.
+ */
+class HOU_AUD_API audio_source_batch : public non_copyable
+{
+public:
+  /**
+   * Creates a batch and starts deferring updates.
+   */
+  audio_source_batch();
+
+  /**
+   * Destructor.
+   *
+   * Commits the batch if it was not already committed.
+   */
+  ~audio_source_batch();
+
+  /**
+   * Sets the position of many audio sources.
+   *
+   * \param sources the audio sources.
+   *
+   * \param positions the positions. The i-th position is assigned to the i-th
+   * audio source.
+   *
+   * \throws hou::precondition_violation if the batch was already committed, if
+   * the spans have different sizes, or if any audio source is nullptr.
+   */
+  void set_positions(const span<audio_source* const>& sources,
+    const span<const vec3f>& positions);
+
+  /**
+   * Sets the velocity of many audio sources.
+   *
+   * \param sources the audio sources.
+   *
+   * \param velocities the velocities. The i-th velocity is assigned to the i-th
+   * audio source.
+   *
+   * \throws hou::precondition_violation if the batch was already committed, if
+   * the spans have different sizes, or if any audio source is nullptr.
+   */
+  void set_velocities(const span<audio_source* const>& sources,
+    const span<const vec3f>& velocities);
+
+  /**
+   * Sets the direction of many audio sources.
+   *
+   * \param sources the audio sources.
+   *
+   * \param directions the directions. The i-th direction is assigned to the
+   * i-th audio source.
+   *
+   * \throws hou::precondition_violation if the batch was already committed, if
+   * the spans have different sizes, or if any audio source is nullptr.
+   */
+  void set_directions(const span<audio_source* const>& sources,
+    const span<const vec3f>& directions);
+
+  /**
+   * Applies all the deferred changes.
+   *
+   * \throws hou::precondition_violation if the batch was already committed.
+   */
+  void commit();
+
+  /**
+   * Checks if the batch was committed.
+   *
+   * \return true if the batch was committed.
+   */
+  bool is_committed() const noexcept;
+
+private:
+  bool m_committed;
+};
+
+}  // namespace hou
+
+#endif
@@ -0,0 +1,197 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_AUD_AUDIO_STREAMING_SERVICE_HPP
+#define HOU_AUD_AUDIO_STREAMING_SERVICE_HPP
+
+#include "hou/cor/non_copyable.hpp"
+
+#include "hou/aud/aud_config.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+namespace hou
+{
+
+class automatic_stream_audio_source;
+
+/**
+ * Updates the buffer queues of all automatic_stream_audio_source objects in a
+ * single background thread.
+ *
+ * Each playing source is scheduled for its next update at the time its first
+ * queued buffer is expected to have been played, computed from the number of
+ * queued samples and the sample rate.
+ * The update is anticipated if at that time the audio left in the buffer
+ * queue would be shorter than the refill margin.
+ * The refill margin grows with the delay observed between the deadlines and
+ * the actual updates, so that sources are refilled earlier when the streaming
+ * thread is under load, and decays back when the delay disappears.
+ * Between updates the thread sleeps until the earliest deadline.
+ *
+ * Underruns, where a source played all of its queued buffers before being
+ * refilled, are counted by the service in addition to each source.
+ *
+ * Sources are scheduled when they start playing and are dropped from the
+ * schedule as soon as an update finds them stopped.
+ * Scheduling requests are posted to a queue which the streaming thread only
+ * locks when it is not empty.
+ *
+ * automatic_stream_audio_source objects must be destroyed before the service,
+ * which is the case for all sources constructed after the service was first
+ * used.
+ */
+class HOU_AUD_API audio_streaming_service : public non_copyable
+{
+public:
+  /**
+   * The clock used to schedule updates.
+   */
+  using clock = std::chrono::steady_clock;
+
+public:
+  /**
+   * Gets the streaming service.
+   *
+   * The service and its thread are created on the first call.
+   *
+   * \return the streaming service.
+   */
+  static audio_streaming_service& get_instance();
+
+  /**
+   * Destructor.
+   *
+   * Stops the streaming thread.
+   */
+  ~audio_streaming_service();
+
+  /**
+   * Requests an update of a source as soon as possible.
+   *
+   * If the source is not scheduled yet, it is added to the schedule.
+   * This function does not wait for the update to happen.
+   *
+   * \param src the source.
+   */
+  void schedule(automatic_stream_audio_source& src);
+
+  /**
+   * Removes a source from the schedule.
+   *
+   * This function waits until the streaming thread has acknowledged the
+   * removal. After it returns the source will not be accessed anymore by the
+   * streaming thread, until it is scheduled again.
+   *
+   * \param src the source.
+   */
+  void remove(automatic_stream_audio_source& src);
+
+  /**
+   * Gets the number of sources currently in the schedule.
+   *
+   * \return the number of scheduled sources.
+   */
+  size_t get_scheduled_source_count() const noexcept;
+
+  /**
+   * Gets the total number of source updates performed by the streaming
+   * thread.
+   *
+   * \return the number of source updates.
+   */
+  uint64_t get_update_count() const noexcept;
+
+  /**
+   * Gets the total number of underruns detected by the streaming thread.
+   *
+   * \return the number of underruns.
+   */
+  uint64_t get_underrun_count() const noexcept;
+
+  /**
+   * Gets the time at which the last underrun was detected by the streaming
+   * thread.
+   *
+   * \return the time at which the last underrun was detected, or a default
+   * constructed time point if no underrun happened.
+   */
+  clock::time_point get_last_underrun_time() const noexcept;
+
+  /**
+   * Gets the current refill margin.
+   *
+   * \return the refill margin.
+   */
+  clock::duration get_refill_margin() const noexcept;
+
+private:
+  enum class command_type
+  {
+    schedule,
+    remove,
+  };
+
+  struct command
+  {
+    command_type type;
+    automatic_stream_audio_source* src;
+  };
+
+  struct entry
+  {
+    clock::time_point deadline;
+    automatic_stream_audio_source* src;
+  };
+
+private:
+  static bool is_later(const entry& lhs, const entry& rhs);
+
+private:
+  audio_streaming_service();
+
+  void post_command(command_type type, automatic_stream_audio_source& src);
+  void thread_function();
+  void process_commands();
+  void update_due_sources();
+  void update_refill_margin(clock::duration latency);
+  void wait_for_next_deadline();
+  void set_deadline(automatic_stream_audio_source* src, clock::time_point t);
+  void remove_entry(automatic_stream_audio_source* src);
+
+private:
+  // Only accessed by the streaming thread.
+  std::vector<entry> m_schedule;
+  std::vector<command> m_processing_commands;
+  clock::duration m_update_latency;
+
+  // Guarded by m_command_mutex.
+  std::vector<command> m_commands;
+  uint64_t m_posted_command_count;
+  uint64_t m_processed_command_count;
+
+  std::atomic<bool> m_commands_pending;
+  std::atomic<bool> m_end_requested;
+  std::atomic<size_t> m_scheduled_source_count;
+  std::atomic<uint64_t> m_update_count;
+  std::atomic<uint64_t> m_underrun_count;
+  std::atomic<clock::rep> m_last_underrun_time;
+  std::atomic<clock::rep> m_refill_margin;
+  std::mutex m_command_mutex;
+  std::condition_variable m_wake_condition;
+  std::condition_variable m_processed_condition;
+  std::thread m_thread;
+};
+
+}  // namespace hou
+
+#endif
@@ -9,9 +9,8 @@
 
 #include "hou/aud/aud_config.hpp"
 
-#include <atomic>
+#include <chrono>
 #include <mutex>
-#include <thread>
 
 
 
@@ -23,8 +22,9 @@ namespace hou
  * thread.
  *
  * This type of audio_source streams audio data from an audio stream and stores
- * it internally in a buffer queue. Each instance of this class spawns a thread
- * that automatically takes care of loading the audio data in the background.
+ * it internally in a buffer queue. The audio data is loaded in the background
+ * by the audio_streaming_service, which updates all instances of this class in
+ * a single thread.
  */
 class HOU_AUD_API automatic_stream_audio_source final
   : public stream_audio_source
@@ -41,9 +41,8 @@ public:
   explicit automatic_stream_audio_source(
     std::unique_ptr<audio_stream_in> as = nullptr);
 
-  // It is not trivial to move the object because it internally spawns a thread
-  // which uses a pointer to this object. Moving the object would invalidate
-  // this pointer.
+  // It is not trivial to move the object because the streaming service stores
+  // a pointer to this object. Moving the object would invalidate this pointer.
   automatic_stream_audio_source(automatic_stream_audio_source&&) = delete;
 
   /**
@@ -58,6 +57,8 @@ public:
   void set_stream(std::unique_ptr<audio_stream_in> as = nullptr) final;
   void set_buffer_count(size_t buffer_count) final;
   void set_buffer_sample_count(size_t buffer_sample_count) final;
+  uint64_t get_underrun_count() const final;
+  std::chrono::steady_clock::time_point get_last_underrun_time() const final;
 
 protected:
   // audio_source overrides.
@@ -66,13 +67,20 @@ protected:
   sample_position on_get_sample_pos() const final;
   void on_play() final;
   void on_pause() final;
+  void on_played() final;
 
 private:
-  void thread_function();
+  // Called by the streaming service. Returns false if the source does not
+  // need further updates, otherwise sets the time until the first queued
+  // buffer can be refilled and the time until the buffer queue runs empty.
+  // underrun is set to true if the update detected an underrun.
+  bool update_from_service(std::chrono::nanoseconds& time_to_free_buffer,
+    std::chrono::nanoseconds& queued_time, bool& underrun);
+
+private:
+  friend class audio_streaming_service;
 
 private:
-  std::thread m_thread;
-  std::atomic<bool> m_streaming_thread_end_requested;
   // This mutex controls access to the stream variables (the audio stream,
   // sample position, buffer queue).
   mutable std::mutex m_stream_mutex;
@@ -0,0 +1,145 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_AUD_COMPRESSED_AUDIO_BUFFER_HPP
+#define HOU_AUD_COMPRESSED_AUDIO_BUFFER_HPP
+
+#include "hou/cor/non_copyable.hpp"
+
+#include "hou/aud/audio_buffer_format.hpp"
+#include "hou/aud/audio_stream_in.hpp"
+
+#include "hou/aud/aud_config.hpp"
+
+#include "hou/cor/std_vector.hpp"
+
+#include "hou/sys/binary_stream_in.hpp"
+
+#include <memory>
+
+
+
+namespace hou
+{
+
+/**
+ * Represents compressed ogg audio data resident in memory.
+ *
+ * Unlike an audio_buffer, a compressed_audio_buffer does not decode the audio
+ * data upfront.
+ * The compressed data is stored once and is decoded while playing by the
+ * audio streams created with create_stream, each of which has its own cursor.
+ * Any number of stream_audio_source objects can therefore play the same
+ * compressed_audio_buffer concurrently, while only the compressed data is kept
+ * in memory.
+ *
+ * The created streams share the ownership of the compressed data, so they can
+ * outlive the compressed_audio_buffer.
+ */
+class HOU_AUD_API compressed_audio_buffer : public non_copyable
+{
+public:
+  /**
+   * Creates a compressed_audio_buffer object with the given ogg data.
+   *
+   * \param data the compressed ogg data.
+   *
+   * \throws hou::invalid_audio_data if the data is not valid ogg data.
+   */
+  explicit compressed_audio_buffer(std::vector<uint8_t> data);
+
+  /**
+   * Creates a compressed_audio_buffer object reading the whole content of a
+   * binary stream containing ogg data.
+   *
+   * \param bs the binary stream.
+   *
+   * \throws hou::read_error if the stream could not be read.
+   *
+   * \throws hou::invalid_audio_data if the data is not valid ogg data.
+   */
+  explicit compressed_audio_buffer(binary_stream_in& bs);
+
+  /**
+   * Creates a compressed_audio_buffer object reading the whole content of a
+   * binary stream containing ogg data.
+   *
+   * \param bs the binary stream.
+   *
+   * \throws hou::read_error if the stream could not be read.
+   *
+   * \throws hou::invalid_audio_data if the data is not valid ogg data.
+   */
+  explicit compressed_audio_buffer(binary_stream_in&& bs);
+
+  /**
+   * Move constructor.
+   *
+   * \param other the other compressed_audio_buffer.
+   */
+  compressed_audio_buffer(compressed_audio_buffer&& other) noexcept = default;
+
+  /**
+   * Gets the audio format of the decoded data.
+   *
+   * \return the audio format of the decoded data.
+   */
+  audio_buffer_format get_format() const noexcept;
+
+  /**
+   * Gets the number of channels of the decoded data.
+   *
+   * \return the number of channels.
+   */
+  uint get_channel_count() const noexcept;
+
+  /**
+   * Gets the number of bytes per sample of the decoded data.
+   *
+   * \return the number of bytes per sample.
+   */
+  uint get_bytes_per_sample() const noexcept;
+
+  /**
+   * Gets the sample rate.
+   *
+   * \return the sample rate in samples per second.
+   */
+  uint get_sample_rate() const noexcept;
+
+  /**
+   * Gets the number of samples of the decoded data for a single channel.
+   *
+   * \return the number of samples for a single channel.
+   */
+  size_t get_sample_count() const noexcept;
+
+  /**
+   * Gets the size in bytes of the compressed data.
+   *
+   * \return the size in bytes of the compressed data.
+   */
+  size_t get_compressed_byte_count() const noexcept;
+
+  /**
+   * Creates a new stream decoding the compressed data.
+   *
+   * Each stream has an independent cursor, and can be assigned to a
+   * stream_audio_source.
+   * Creating a stream does not copy the compressed data.
+   *
+   * \return the created stream.
+   */
+  std::unique_ptr<audio_stream_in> create_stream() const;
+
+private:
+  std::shared_ptr<const std::vector<uint8_t>> m_data;
+  audio_buffer_format m_format;
+  uint m_sample_rate;
+  size_t m_sample_count;
+};
+
+}  // namespace hou
+
+#endif
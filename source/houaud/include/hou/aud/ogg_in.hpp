@@ -0,0 +1,133 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_AUD_OGG_IN_HPP
+#define HOU_AUD_OGG_IN_HPP
+
+#include "hou/aud/audio_stream_in.hpp"
+#include "hou/cor/non_copyable.hpp"
+
+#include "hou/aud/aud_config.hpp"
+
+#include <memory>
+
+
+
+struct OggVorbis_File;
+
+
+
+namespace hou
+{
+
+/**
+ * Base class for input ogg streams.
+ *
+ * The compressed data is not accessed directly, but through a set of virtual
+ * functions implemented by the derived classes, so that it can be decoded from
+ * any source without being copied first.
+ * Derived classes must call open in their constructor, once they are ready to
+ * provide the compressed data.
+ */
+class HOU_AUD_API ogg_in
+  : public non_copyable
+  , public audio_stream_in
+{
+public:
+  /**
+   * Move constructor.
+   *
+   * \param other the other object.
+   */
+  ogg_in(ogg_in&& other) noexcept;
+
+  /**
+   * Destructor.
+   */
+  virtual ~ogg_in();
+
+  // stream overrides.
+  bool eof() const noexcept final;
+  bool error() const noexcept final;
+  size_t get_byte_count() const noexcept final;
+
+  // stream_in overrides.
+  size_t get_read_byte_count() const noexcept final;
+  size_t get_read_element_count() const noexcept final;
+
+  // binary_stream overrides.
+  byte_position get_byte_pos() const final;
+  binary_stream& set_byte_pos(byte_position pos) final;
+  binary_stream& move_byte_pos(byte_offset offset) final;
+
+  // audio_stream overrides.
+  size_t get_sample_count() const noexcept final;
+  sample_position get_sample_pos() const final;
+  audio_stream_in& set_sample_pos(sample_position pos) final;
+  audio_stream_in& move_sample_pos(sample_offset offset) final;
+
+protected:
+  /**
+   * Default constructor.
+   */
+  ogg_in();
+
+  /**
+   * Opens the ogg stream, reading its header and metadata.
+   *
+   * \throws hou::invalid_audio_data if the compressed data is not valid ogg
+   * data.
+   */
+  void open();
+
+private:
+  /**
+   * Reads compressed data.
+   *
+   * \param buf the destination buffer.
+   *
+   * \param byte_count the maximum number of bytes to be read.
+   *
+   * \return the number of bytes actually read.
+   */
+  virtual size_t on_read_ogg_data(void* buf, size_t byte_count) = 0;
+
+  /**
+   * Sets the position in the compressed data.
+   *
+   * \param pos the position in bytes. It is never greater than the compressed
+   * data size.
+   */
+  virtual void on_set_ogg_data_pos(size_t pos) = 0;
+
+  /**
+   * Gets the position in the compressed data.
+   *
+   * \return the position in bytes.
+   */
+  virtual size_t on_get_ogg_data_pos() const = 0;
+
+  /**
+   * Gets the size of the compressed data.
+   *
+   * \return the size in bytes.
+   */
+  virtual size_t on_get_ogg_data_byte_count() const = 0;
+
+  void read_metadata();
+  void on_read(void* buf, size_t element_size, size_t buf_size) final;
+
+private:
+  std::unique_ptr<OggVorbis_File> m_vorbis_file;
+  int m_logical_bit_stream;
+  size_t m_pcm_size;
+  size_t m_byte_count;
+  size_t m_element_count;
+  bool m_eof;
+  bool m_error;
+};
+
+}  // namespace hou
+
+#endif
@@ -0,0 +1,85 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_AUD_OGG_MEMORY_IN_HPP
+#define HOU_AUD_OGG_MEMORY_IN_HPP
+
+#include "hou/aud/ogg_in.hpp"
+
+#include "hou/aud/aud_config.hpp"
+
+#include "hou/cor/span.hpp"
+#include "hou/cor/std_vector.hpp"
+
+#include <memory>
+
+
+
+namespace hou
+{
+
+/**
+ * Input ogg stream decoding data stored in memory.
+ *
+ * The compressed data is not copied.
+ * It is either referenced, in which case it must remain valid for the whole
+ * lifetime of the ogg_memory_in object, or shared, in which case the
+ * ogg_memory_in object keeps it alive.
+ * This makes it possible to decode data loaded from a packed archive or a
+ * memory mapped file, or to decode the same data with several independent
+ * streams.
+ */
+class HOU_AUD_API ogg_memory_in : public ogg_in
+{
+public:
+  /**
+   * Data constructor.
+   *
+   * \param data the compressed ogg data.
+   *
+   * \throws hou::invalid_audio_data if the data is not valid ogg data.
+   */
+  explicit ogg_memory_in(const span<const uint8_t>& data);
+
+  /**
+   * Shared data constructor.
+   *
+   * The ogg_memory_in object shares the ownership of the data.
+   *
+   * \param data the compressed ogg data.
+   *
+   * \throws hou::precondition_violation if data is nullptr.
+   *
+   * \throws hou::invalid_audio_data if the data is not valid ogg data.
+   */
+  explicit ogg_memory_in(std::shared_ptr<const std::vector<uint8_t>> data);
+
+  /**
+   * Move constructor.
+   *
+   * \param other the other object.
+   */
+  ogg_memory_in(ogg_memory_in&& other) noexcept;
+
+  /**
+   * Destructor.
+   */
+  virtual ~ogg_memory_in();
+
+private:
+  // ogg_in overrides.
+  size_t on_read_ogg_data(void* buf, size_t byte_count) final;
+  void on_set_ogg_data_pos(size_t pos) final;
+  size_t on_get_ogg_data_pos() const final;
+  size_t on_get_ogg_data_byte_count() const final;
+
+private:
+  std::shared_ptr<const std::vector<uint8_t>> m_shared_data;
+  span<const uint8_t> m_data;
+  size_t m_data_pos;
+};
+
+}  // namespace hou
+
+#endif
@@ -0,0 +1,69 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_AUD_OGG_STREAM_IN_HPP
+#define HOU_AUD_OGG_STREAM_IN_HPP
+
+#include "hou/aud/ogg_in.hpp"
+
+#include "hou/aud/aud_config.hpp"
+
+#include "hou/sys/binary_stream_in.hpp"
+
+#include <memory>
+
+
+
+namespace hou
+{
+
+/**
+ * Input ogg stream decoding data read from a binary_stream_in.
+ *
+ * The compressed data is read from the binary stream as needed while
+ * decoding.
+ */
+class HOU_AUD_API ogg_stream_in : public ogg_in
+{
+public:
+  /**
+   * Stream constructor.
+   *
+   * The ogg data is assumed to span the whole binary stream.
+   *
+   * \param bs the binary stream containing the compressed ogg data.
+   *
+   * \throws hou::precondition_violation if bs is nullptr.
+   *
+   * \throws hou::invalid_audio_data if the stream does not contain valid ogg
+   * data.
+   */
+  explicit ogg_stream_in(std::unique_ptr<binary_stream_in> bs);
+
+  /**
+   * Move constructor.
+   *
+   * \param other the other object.
+   */
+  ogg_stream_in(ogg_stream_in&& other) noexcept;
+
+  /**
+   * Destructor.
+   */
+  virtual ~ogg_stream_in();
+
+private:
+  // ogg_in overrides.
+  size_t on_read_ogg_data(void* buf, size_t byte_count) final;
+  void on_set_ogg_data_pos(size_t pos) final;
+  size_t on_get_ogg_data_pos() const final;
+  size_t on_get_ogg_data_byte_count() const final;
+
+private:
+  std::unique_ptr<binary_stream_in> m_stream;
+};
+
+}  // namespace hou
+
+#endif
@@ -11,11 +11,13 @@
 
 #include "hou/aud/aud_config.hpp"
 
+#include "hou/cor/span.hpp"
 #include "hou/cor/std_string.hpp"
 #include "hou/cor/std_vector.hpp"
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
-#include <queue>
 
 
 
@@ -43,6 +45,8 @@ namespace hou
  * methods.
  * Higher number of buffers and higher buffer size will result in higher
  * memory consumption, but potentially better sound quality.
+ * The memory used to refill the buffers is allocated when the buffer queue is
+ * configured, so that streaming does not perform heap allocations.
  */
 class HOU_AUD_API stream_audio_source : public audio_source
 {
@@ -112,6 +116,27 @@ public:
    */
   size_t get_buffer_sample_count() const;
 
+  /**
+   * Gets the number of buffer underruns since the construction of the source.
+   *
+   * An underrun happens when all queued buffers have been played before the
+   * buffer queue was refilled, while the audio stream still had data to be
+   * played.
+   * The audio source stops playing until the buffer queue is refilled, which
+   * results in an audible gap.
+   *
+   * \return the number of buffer underruns.
+   */
+  virtual uint64_t get_underrun_count() const;
+
+  /**
+   * Gets the time at which the last buffer underrun was detected.
+   *
+   * \return the time at which the last buffer underrun was detected, or a
+   * default constructed time point if no underrun happened.
+   */
+  virtual std::chrono::steady_clock::time_point get_last_underrun_time() const;
+
   // audio_source overrides.
   bool is_playing() const override = 0;
   bool has_audio() const final;
@@ -122,16 +147,19 @@ private:
   {
   public:
     buffer_queue(size_t buffer_count);
-    size_t free_buffers(size_t count);
-    const audio_buffer& fill_buffer(const std::vector<uint8_t>& data,
+    size_t free_buffers(const al::source_handle& source, size_t count);
+    const audio_buffer& fill_buffer(const span<const uint8_t>& data,
       audio_buffer_format format, int sample_rate);
     size_t get_free_buffer_count() const;
     size_t get_used_buffer_count() const;
     size_t get_buffer_count() const;
+    size_t get_front_buffer_byte_count() const;
+    size_t get_used_byte_count() const;
 
   private:
     std::vector<audio_buffer> m_buffers;
-    std::queue<size_t> m_buffer_sample_counts;
+    std::vector<size_t> m_buffer_byte_counts;
+    std::vector<ALuint> m_unqueued_buffer_names;
     size_t m_free_buffer_count;
     size_t m_current_index;
   };
@@ -142,6 +170,33 @@ protected:
    */
   void update_buffer_queue();
 
+  /**
+   * Checks if the buffer queue is being processed, meaning that
+   * update_buffer_queue has to be called regularly.
+   *
+   * \return true if the buffer queue is being processed.
+   */
+  bool is_processing_buffer_queue() const noexcept;
+
+  /**
+   * Gets the time until the first buffer in the queue has been played and
+   * can be refilled.
+   *
+   * \return the time until the first buffer in the queue has been played, or
+   * 0 if no buffer is queued.
+   */
+  std::chrono::nanoseconds get_time_to_free_buffer() const;
+
+  /**
+   * Gets the time until all buffers in the queue have been played.
+   *
+   * If the buffer queue is not refilled within this time, an underrun occurs.
+   *
+   * \return the time until all buffers in the queue have been played, or 0 if
+   * no buffer is queued.
+   */
+  std::chrono::nanoseconds get_queued_time() const;
+
   // audio_source overrides.
   void on_set_looping(bool looping) override = 0;
   void on_set_sample_pos(sample_position pos) override = 0;
@@ -150,7 +205,7 @@ protected:
   void on_pause() override;
 
 private:
-  std::vector<uint8_t> read_data_chunk(size_t chunk_size);
+  span<const uint8_t> read_data_chunk();
   void free_buffers();
   void fill_buffers();
   sample_position normalize_sample_pos(sample_position pos);
@@ -158,6 +213,7 @@ private:
   void set_stream_cursor(sample_position pos);
   void set_sample_pos_and_stream_cursor(sample_position pos);
   void set_buffers_to_queue_count(uint pos);
+  std::chrono::nanoseconds get_time_to_play(size_t byte_count) const;
 
   // audio_source overrides.
   audio_buffer_format get_format_internal() const final;
@@ -174,6 +230,9 @@ private:
   int m_sample_pos;
   uint m_buffers_to_queue_count;
   size_t m_buffer_byte_count;
+  std::vector<uint8_t> m_staging_data;
+  uint64_t m_underrun_count;
+  std::chrono::steady_clock::time_point m_last_underrun_time;
 };
 
 }  // namespace hou
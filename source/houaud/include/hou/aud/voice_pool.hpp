@@ -0,0 +1,308 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_AUD_VOICE_POOL_HPP
+#define HOU_AUD_VOICE_POOL_HPP
+
+#include "hou/aud/buffer_audio_source.hpp"
+
+#include "hou/aud/aud_config.hpp"
+
+#include "hou/cor/checked_variable.hpp"
+#include "hou/cor/non_copyable.hpp"
+#include "hou/cor/std_chrono.hpp"
+
+#include "hou/mth/matrix.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+
+
+namespace hou
+{
+
+class audio_buffer;
+
+/**
+ * Plays an unlimited number of sounds with a limited number of audio sources.
+ *
+ * The OpenAL implementation supports a limited number of audio sources.
+ * A voice_pool owns a fixed number of buffer_audio_source objects, called
+ * voices, and accepts any number of sounds.
+ * When updated, the sounds are ranked by audibility, defined as the product of
+ * their priority, their gain and their distance attenuation, and only the most
+ * audible sounds are bound to a voice.
+ * The other sounds are virtual: they are not rendered, but their playback
+ * position keeps advancing, so that a sound is resumed from the right position
+ * when it becomes audible enough to be bound to a voice again.
+ *
+ * The distance attenuation is computed according to the current
+ * sound_distance_model, using the default reference distance, rolloff factor
+ * and maximum distance of an audio_source.
+ * Sounds positions are absolute.
+ */
+class HOU_AUD_API voice_pool : public non_copyable
+{
+public:
+  /**
+   * Sound identifier type.
+   */
+  using sound_id = uint;
+
+  /**
+   * Invalid sound identifier.
+   *
+   * It is never returned by play.
+   */
+  static constexpr sound_id invalid_sound_id = 0u;
+
+public:
+  /**
+   * Creates a voice_pool with the given number of voices.
+   *
+   * \param voice_count the number of voices.
+   *
+   * \throws hou::precondition_violation if voice_count is 0.
+   */
+  explicit voice_pool(size_t voice_count);
+
+  /**
+   * Starts playing a sound.
+   *
+   * If a voice is free, it is immediately bound to the sound.
+   * Otherwise the sound starts as a virtual sound, and competes for a voice at
+   * the next update.
+   *
+   * \param buffer the audio buffer.
+   *
+   * \param priority the sound priority.
+   *
+   * \param looping whether the sound is looping.
+   *
+   * \throws hou::precondition_violation if buffer is nullptr.
+   *
+   * \return the identifier of the sound.
+   */
+  sound_id play(std::shared_ptr<audio_buffer> buffer,
+    non_negative<float> priority = 1.f, bool looping = false);
+
+  /**
+   * Stops a sound and removes it from the pool.
+   *
+   * If the sound is not in the pool, nothing happens.
+   *
+   * \param id the sound identifier.
+   */
+  void stop(sound_id id);
+
+  /**
+   * Stops all sounds and removes them from the pool.
+   */
+  void clear();
+
+  /**
+   * Updates the virtual sounds, ranks the sounds by audibility, and binds the
+   * voices to the most audible sounds.
+   *
+   * Sounds which ended are removed from the pool.
+   *
+   * \param elapsed the time elapsed since the last update.
+   */
+  void update(std::chrono::nanoseconds elapsed);
+
+  /**
+   * Checks if a sound is playing.
+   *
+   * A sound is playing from the call to play until it is stopped or it ends.
+   *
+   * \param id the sound identifier.
+   *
+   * \return true if the sound is playing.
+   */
+  bool is_playing(sound_id id) const;
+
+  /**
+   * Checks if a sound is virtual, meaning that it is not bound to a voice.
+   *
+   * \param id the sound identifier.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   *
+   * \return true if the sound is virtual.
+   */
+  bool is_virtual(sound_id id) const;
+
+  /**
+   * Gets the playback position of a sound.
+   *
+   * \param id the sound identifier.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   *
+   * \return the playback position.
+   */
+  std::chrono::nanoseconds get_time_pos(sound_id id) const;
+
+  /**
+   * Sets the position of a sound.
+   *
+   * \param id the sound identifier.
+   *
+   * \param pos the position.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   */
+  void set_position(sound_id id, const vec3f& pos);
+
+  /**
+   * Gets the position of a sound.
+   *
+   * \param id the sound identifier.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   *
+   * \return the position.
+   */
+  vec3f get_position(sound_id id) const;
+
+  /**
+   * Sets the gain of a sound.
+   *
+   * \param id the sound identifier.
+   *
+   * \param value the gain.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   */
+  void set_gain(sound_id id, non_negative<float> value);
+
+  /**
+   * Gets the gain of a sound.
+   *
+   * \param id the sound identifier.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   *
+   * \return the gain.
+   */
+  non_negative<float> get_gain(sound_id id) const;
+
+  /**
+   * Sets the priority of a sound.
+   *
+   * \param id the sound identifier.
+   *
+   * \param value the priority.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   */
+  void set_priority(sound_id id, non_negative<float> value);
+
+  /**
+   * Gets the priority of a sound.
+   *
+   * \param id the sound identifier.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   *
+   * \return the priority.
+   */
+  non_negative<float> get_priority(sound_id id) const;
+
+  /**
+   * Gets the audibility of a sound computed by the last update.
+   *
+   * \param id the sound identifier.
+   *
+   * \throws hou::precondition_violation if the sound is not playing.
+   *
+   * \return the audibility.
+   */
+  float get_audibility(sound_id id) const;
+
+  /**
+   * Gets the number of voices.
+   *
+   * \return the number of voices.
+   */
+  size_t get_voice_count() const noexcept;
+
+  /**
+   * Gets the number of playing sounds.
+   *
+   * \return the number of playing sounds.
+   */
+  size_t get_sound_count() const noexcept;
+
+  /**
+   * Gets the number of playing sounds bound to a voice.
+   *
+   * \return the number of playing sounds bound to a voice.
+   */
+  size_t get_real_sound_count() const noexcept;
+
+  /**
+   * Gets the number of playing sounds not bound to a voice.
+   *
+   * \return the number of virtual sounds.
+   */
+  size_t get_virtual_sound_count() const noexcept;
+
+  /**
+   * Gets the number of times a voice was bound to a sound since the
+   * construction of the pool.
+   *
+   * Sampling this value and get_voice_unbind_count at regular intervals gives
+   * the voice allocation and free rates.
+   *
+   * \return the number of voice binds.
+   */
+  uint64_t get_voice_bind_count() const noexcept;
+
+  /**
+   * Gets the number of times a voice was unbound from a sound since the
+   * construction of the pool.
+   *
+   * \return the number of voice unbinds.
+   */
+  uint64_t get_voice_unbind_count() const noexcept;
+
+private:
+  static constexpr size_t no_voice = static_cast<size_t>(-1);
+
+  struct sound
+  {
+    std::shared_ptr<audio_buffer> buffer;
+    std::chrono::nanoseconds time_pos;
+    std::chrono::nanoseconds duration;
+    vec3f position;
+    float gain;
+    float priority;
+    float audibility;
+    size_t voice;
+    bool looping;
+  };
+
+private:
+  sound& get_sound(sound_id id);
+  const sound& get_sound(sound_id id) const;
+  void bind_voice(sound& s, size_t voice);
+  void unbind_voice(sound& s);
+
+private:
+  std::vector<buffer_audio_source> m_voices;
+  std::vector<size_t> m_free_voices;
+  std::unordered_map<sound_id, sound> m_sounds;
+  std::vector<std::pair<float, sound_id>> m_ranking;
+  sound_id m_next_id;
+  uint64_t m_voice_bind_count;
+  uint64_t m_voice_unbind_count;
+};
+
+}  // namespace hou
+
+#endif
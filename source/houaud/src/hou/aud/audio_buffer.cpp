@@ -6,10 +6,22 @@
 
 #include "hou/aud/audio_stream_in.hpp"
 
+#include "hou/cor/assertions.hpp"
 #include "hou/cor/narrow_cast.hpp"
 
 
 
+// When AL state validation is enabled, the cached buffer properties are
+// compared to the values stored by OpenAL every time they are read.
+#ifdef HOU_ENABLE_AL_STATE_VALIDATION
+#define VALIDATE_CACHED_BUFFER_VALUE(cached, queried)                          \
+  HOU_INVARIANT((cached) == (queried))
+#else
+#define VALIDATE_CACHED_BUFFER_VALUE(cached, queried)
+#endif
+
+
+
 namespace hou
 {
 
@@ -30,6 +42,9 @@ audio_buffer::audio_buffer(
   const span<const uint8_t>& data, audio_buffer_format format, int smlRate)
   : non_copyable()
   , m_handle(al::buffer_handle::generate())
+  , m_format(audio_buffer_format::mono8)
+  , m_sample_rate(0)
+  , m_byte_count(0u)
 {
   set_data(data, format, smlRate);
 }
@@ -46,6 +61,9 @@ audio_buffer::audio_buffer(
 audio_buffer::audio_buffer(audio_stream_in& audio_stream)
   : non_copyable()
   , m_handle(al::buffer_handle::generate())
+  , m_format(audio_buffer_format::mono8)
+  , m_sample_rate(0)
+  , m_byte_count(0u)
 {
   set_data(audio_stream);
 }
@@ -55,6 +73,9 @@ audio_buffer::audio_buffer(audio_stream_in& audio_stream)
 audio_buffer::audio_buffer(audio_stream_in&& audio_stream)
   : non_copyable()
   , m_handle(al::buffer_handle::generate())
+  , m_format(audio_buffer_format::mono8)
+  , m_sample_rate(0)
+  , m_byte_count(0u)
 {
   set_data(audio_stream);
 }
@@ -70,36 +91,49 @@ const al::buffer_handle& audio_buffer::get_handle() const noexcept
 
 audio_buffer_format audio_buffer::get_format() const
 {
-  return get_audio_buffer_format_enum(
-    get_channel_count(), get_bytes_per_sample());
+  VALIDATE_CACHED_BUFFER_VALUE(m_format,
+    get_audio_buffer_format_enum(
+      narrow_cast<uint>(al::get_buffer_channels(m_handle)),
+      narrow_cast<uint>(al::get_buffer_bits(m_handle) / bits_per_byte)));
+  return m_format;
 }
 
 
 
 uint audio_buffer::get_bytes_per_sample() const
 {
-  return narrow_cast<uint>(al::get_buffer_bits(m_handle) / bits_per_byte);
+  VALIDATE_CACHED_BUFFER_VALUE(
+    get_audio_buffer_format_bytes_per_sample(m_format),
+    narrow_cast<uint>(al::get_buffer_bits(m_handle) / bits_per_byte));
+  return get_audio_buffer_format_bytes_per_sample(m_format);
 }
 
 
 
 uint audio_buffer::get_channel_count() const
 {
-  return narrow_cast<uint>(al::get_buffer_channels(m_handle));
+  VALIDATE_CACHED_BUFFER_VALUE(
+    get_audio_buffer_format_channel_count(m_format),
+    narrow_cast<uint>(al::get_buffer_channels(m_handle)));
+  return get_audio_buffer_format_channel_count(m_format);
 }
 
 
 
 int audio_buffer::get_sample_rate() const
 {
-  return narrow_cast<int>(al::get_buffer_frequency(m_handle));
+  VALIDATE_CACHED_BUFFER_VALUE(
+    m_sample_rate, narrow_cast<int>(al::get_buffer_frequency(m_handle)));
+  return m_sample_rate;
 }
 
 
 
 uint audio_buffer::get_byte_count() const
 {
-  return narrow_cast<uint>(al::get_buffer_size(m_handle));
+  VALIDATE_CACHED_BUFFER_VALUE(
+    m_byte_count, narrow_cast<uint>(al::get_buffer_size(m_handle)));
+  return m_byte_count;
 }
 
 
@@ -118,9 +152,22 @@ void audio_buffer::set_data(
   const span<const uint8_t>& data, audio_buffer_format format, int smlRate)
 {
   HOU_DEV_ASSERT(sizeof(uint8_t) == 1u);
+  // OpenAL rejects these values, but the rejection is only reported when the
+  // error checks are enabled.
+  HOU_PRECOND(smlRate > 0);
+  HOU_PRECOND(data.size()
+      % (get_audio_buffer_format_channel_count(format)
+          * get_audio_buffer_format_bytes_per_sample(format))
+    == 0u);
   al::set_buffer_data(m_handle, static_cast<ALenum>(format),
     reinterpret_cast<ALvoid*>(const_cast<uint8_t*>(data.data())),
     narrow_cast<ALsizei>(data.size()), narrow_cast<ALsizei>(smlRate));
+
+  // The properties are cached after setting the data, so that they are left
+  // unchanged if an error is reported.
+  m_format = format;
+  m_sample_rate = smlRate;
+  m_byte_count = narrow_cast<uint>(data.size());
 }
 
 
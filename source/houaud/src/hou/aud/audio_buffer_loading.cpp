@@ -0,0 +1,164 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/audio_buffer_loading.hpp"
+
+#include "hou/aud/ogg_file_in.hpp"
+
+#include "hou/cor/assertions.hpp"
+#include "hou/cor/narrow_cast.hpp"
+
+#include "hou/sys/sys_exceptions.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+
+
+
+namespace hou
+{
+
+namespace
+{
+
+struct decoded_file
+{
+  std::vector<uint8_t> pcm;
+  audio_buffer_format format;
+  int sample_rate;
+};
+
+struct decode_task
+{
+  size_t file_index;
+  size_t first_sample;
+  size_t sample_count;
+};
+
+void decode_chunk(const std::string& path, const decode_task& task,
+  decoded_file& destination);
+
+std::vector<decoded_file> decode_ogg_files(
+  const std::vector<std::string>& paths, size_t thread_count,
+  size_t chunk_sample_count);
+
+
+
+void decode_chunk(
+  const std::string& path, const decode_task& task, decoded_file& destination)
+{
+  // Every chunk has its own decoder, so that chunks are fully independent.
+  ogg_file_in in(path);
+  size_t frame_byte_count = in.get_channel_count() * in.get_bytes_per_sample();
+  size_t byte_count = task.sample_count * frame_byte_count;
+  in.set_sample_pos(
+    narrow_cast<ogg_file_in::sample_position>(task.first_sample));
+  in.read(destination.pcm.data() + task.first_sample * frame_byte_count,
+    byte_count);
+  HOU_CHECK_0(in.get_read_byte_count() == byte_count, read_error);
+}
+
+
+
+std::vector<decoded_file> decode_ogg_files(
+  const std::vector<std::string>& paths, size_t thread_count,
+  size_t chunk_sample_count)
+{
+  HOU_PRECOND(thread_count > 0u);
+  HOU_PRECOND(chunk_sample_count > 0u);
+
+  // Read the metadata, allocate the PCM data and split it into chunks.
+  std::vector<decoded_file> files;
+  std::vector<decode_task> tasks;
+  files.reserve(paths.size());
+  for(size_t i = 0; i < paths.size(); ++i)
+  {
+    ogg_file_in in(paths[i]);
+    files.push_back(decoded_file{std::vector<uint8_t>(in.get_byte_count()),
+      in.get_format(), narrow_cast<int>(in.get_sample_rate())});
+    size_t sample_count = in.get_sample_count();
+    for(size_t first = 0u; first < sample_count; first += chunk_sample_count)
+    {
+      tasks.push_back(decode_task{
+        i, first, std::min(chunk_sample_count, sample_count - first)});
+    }
+  }
+
+  // Each worker writes directly into the final PCM data, so no copy is needed
+  // to stitch the chunks together.
+  std::atomic<size_t> next_task(0u);
+  auto worker = [&]() {
+    for(size_t t = next_task++; t < tasks.size(); t = next_task++)
+    {
+      decode_chunk(
+        paths[tasks[t].file_index], tasks[t], files[tasks[t].file_index]);
+    }
+  };
+  std::vector<std::future<void>> workers;
+  thread_count = std::min(thread_count, tasks.size());
+  workers.reserve(thread_count);
+  for(size_t i = 0; i < thread_count; ++i)
+  {
+    workers.push_back(std::async(std::launch::async, worker));
+  }
+
+  // All workers must be joined before rethrowing, since they reference
+  // objects local to this function.
+  for(auto& w : workers)
+  {
+    w.wait();
+  }
+  for(auto& w : workers)
+  {
+    w.get();
+  }
+
+  return files;
+}
+
+}  // namespace
+
+
+
+std::vector<uint8_t> decode_ogg_file(
+  const std::string& path, size_t thread_count, size_t chunk_sample_count)
+{
+  std::vector<decoded_file> files = decode_ogg_files(
+    std::vector<std::string>{path}, thread_count, chunk_sample_count);
+  HOU_DEV_ASSERT(files.size() == 1u);
+  return std::move(files.front().pcm);
+}
+
+
+
+audio_buffer load_ogg_audio_buffer(
+  const std::string& path, size_t thread_count, size_t chunk_sample_count)
+{
+  std::vector<audio_buffer> buffers = load_ogg_audio_buffers(
+    std::vector<std::string>{path}, thread_count, chunk_sample_count);
+  HOU_DEV_ASSERT(buffers.size() == 1u);
+  return std::move(buffers.front());
+}
+
+
+
+std::vector<audio_buffer> load_ogg_audio_buffers(
+  const std::vector<std::string>& paths, size_t thread_count,
+  size_t chunk_sample_count)
+{
+  std::vector<decoded_file> files
+    = decode_ogg_files(paths, thread_count, chunk_sample_count);
+  std::vector<audio_buffer> buffers;
+  buffers.reserve(files.size());
+  for(auto& f : files)
+  {
+    buffers.emplace_back(span<const uint8_t>(f.pcm), f.format, f.sample_rate);
+    // The PCM data is not needed anymore once it is copied by OpenAL.
+    f.pcm = std::vector<uint8_t>();
+  }
+  return buffers;
+}
+
+}  // namespace hou
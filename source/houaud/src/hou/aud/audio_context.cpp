@@ -4,6 +4,8 @@
 
 #include "hou/aud/audio_context.hpp"
 
+#include "hou/cor/assertions.hpp"
+
 
 
 namespace hou
@@ -30,6 +32,14 @@ std::vector<std::string> audio_context::get_device_names()
 
 
 
+audio_context audio_context::create_loopback(
+  uint sample_rate, uint channel_count)
+{
+  return audio_context(device_type::open_loopback(sample_rate, channel_count));
+}
+
+
+
 audio_context::audio_context()
   : non_copyable()
   , m_al_device()
@@ -46,6 +56,14 @@ audio_context::audio_context(const std::string& dev_name)
 
 
 
+audio_context::audio_context(device_type&& dev)
+  : non_copyable()
+  , m_al_device(std::move(dev))
+  , m_al_context(m_al_device)
+{}
+
+
+
 bool audio_context::is_current() const
 {
   return m_al_context.is_current();
@@ -79,4 +97,22 @@ audio_context::device_type& audio_context::get_device() noexcept
   return m_al_device;
 }
 
+
+
+bool audio_context::is_loopback() const noexcept
+{
+  return m_al_device.is_loopback();
+}
+
+
+
+void audio_context::render(const span<int16_t>& buffer)
+{
+  HOU_PRECOND(is_loopback());
+  HOU_PRECOND(is_current());
+  HOU_PRECOND(buffer.size() % m_al_device.get_loopback_channel_count() == 0u);
+  m_al_device.render_samples(
+    buffer.data(), buffer.size() / m_al_device.get_loopback_channel_count());
+}
+
 }  // namespace hou
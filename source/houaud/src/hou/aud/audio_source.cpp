@@ -10,6 +10,19 @@
 
 #include "hou/mth/math_functions.hpp"
 
+#include <limits>
+
+
+
+// When AL state validation is enabled, the cached source properties are
+// compared to the values stored by OpenAL every time they are read.
+#ifdef HOU_ENABLE_AL_STATE_VALIDATION
+#define VALIDATE_CACHED_SOURCE_VALUE(cached, queried)                          \
+  HOU_INVARIANT(matches(cached, queried))
+#else
+#define VALIDATE_CACHED_SOURCE_VALUE(cached, queried)
+#endif
+
 
 
 namespace hou
@@ -18,9 +31,28 @@ namespace hou
 namespace
 {
 
+// Default OpenAL audio source property values.
+constexpr float default_pitch = 1.f;
+constexpr float default_gain = 1.f;
+constexpr float default_max_gain = 1.f;
+constexpr float default_min_gain = 0.f;
+constexpr float default_max_distance = std::numeric_limits<float>::max();
+constexpr float default_rolloff_factor = 1.f;
+constexpr float default_reference_distance = 1.f;
+constexpr float default_cone_outer_gain = 0.f;
+constexpr float default_cone_angle_deg = 360.f;
+
 audio_source::sample_position normalize(audio_source::sample_position value,
   audio_source::sample_position max) noexcept;
 
+#ifdef HOU_ENABLE_AL_STATE_VALIDATION
+bool matches(bool cached, bool queried);
+
+bool matches(float cached, float queried);
+
+bool matches(const vec3f& cached, const vec3f& queried);
+#endif
+
 audio_source::sample_position normalize(audio_source::sample_position value,
   audio_source::sample_position max) noexcept
 {
@@ -36,6 +68,29 @@ audio_source::sample_position normalize(audio_source::sample_position value,
   return value % max;
 }
 
+
+
+#ifdef HOU_ENABLE_AL_STATE_VALIDATION
+bool matches(bool cached, bool queried)
+{
+  return cached == queried;
+}
+
+
+
+bool matches(float cached, float queried)
+{
+  return close(cached, queried);
+}
+
+
+
+bool matches(const vec3f& cached, const vec3f& queried)
+{
+  return close(cached, queried);
+}
+#endif
+
 }  // namespace
 
 
@@ -44,6 +99,21 @@ audio_source::audio_source()
   : non_copyable()
   , m_handle(al::source_handle::generate())
   , m_requested_sample_pos(0)
+  , m_position(vec3f::zero())
+  , m_velocity(vec3f::zero())
+  , m_direction(vec3f::zero())
+  , m_pitch(default_pitch)
+  , m_gain(default_gain)
+  , m_max_gain(default_max_gain)
+  , m_min_gain(default_min_gain)
+  , m_max_distance(default_max_distance)
+  , m_rolloff_factor(default_rolloff_factor)
+  , m_reference_distance(default_reference_distance)
+  , m_cone_outer_gain(default_cone_outer_gain)
+  , m_cone_inner_angle_deg(default_cone_angle_deg)
+  , m_cone_outer_angle_deg(default_cone_angle_deg)
+  , m_looping(false)
+  , m_relative(false)
 {}
 
 
@@ -70,6 +140,7 @@ void audio_source::play()
     // The requested pos has to be set to 0 in case playback ends on its own.
     m_requested_sample_pos = 0;
     al::play_source(m_handle);
+    on_played();
   }
 }
 
@@ -187,10 +258,14 @@ void audio_source::set_sample_pos(sample_position pos)
   {
     // In order to ensure correct behavior in derived classes, before changing
     // the the sample position the audio source must be stopped and playback
-    // resumed afterwards.
+    // resumed afterwards. The derived classes are notified as well, so that
+    // the temporary stop is not mistaken for the end of the playback.
+    on_pause();
     al::stop_source(get_handle());
     on_set_sample_pos(pos);
+    on_play();
     al::play_source(get_handle());
+    on_played();
   }
   else
   {
@@ -247,7 +322,9 @@ void audio_source::set_looping(bool looping)
 
 bool audio_source::is_looping() const
 {
-  return static_cast<bool>(al::get_source_looping(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(
+    m_looping, static_cast<bool>(al::get_source_looping(m_handle)));
+  return m_looping;
 }
 
 
@@ -255,13 +332,16 @@ bool audio_source::is_looping() const
 void audio_source::set_pitch(non_negative<float> value)
 {
   al::set_source_pitch(m_handle, static_cast<ALfloat>(value));
+  m_pitch = value;
 }
 
 
 
 non_negative<float> audio_source::get_pitch() const
 {
-  return static_cast<float>(al::get_source_pitch(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(
+    m_pitch, static_cast<float>(al::get_source_pitch(m_handle)));
+  return m_pitch;
 }
 
 
@@ -269,13 +349,16 @@ non_negative<float> audio_source::get_pitch() const
 void audio_source::set_gain(non_negative<float> value)
 {
   al::set_source_gain(m_handle, static_cast<ALfloat>(value));
+  m_gain = value;
 }
 
 
 
 non_negative<float> audio_source::get_gain() const
 {
-  return static_cast<float>(al::get_source_gain(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(
+    m_gain, static_cast<float>(al::get_source_gain(m_handle)));
+  return m_gain;
 }
 
 
@@ -283,13 +366,16 @@ non_negative<float> audio_source::get_gain() const
 void audio_source::set_max_gain(non_negative<float> value)
 {
   al::set_source_max_gain(m_handle, static_cast<ALfloat>(value));
+  m_max_gain = value;
 }
 
 
 
 non_negative<float> audio_source::get_max_gain() const
 {
-  return static_cast<float>(al::get_source_max_gain(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(
+    m_max_gain, static_cast<float>(al::get_source_max_gain(m_handle)));
+  return m_max_gain;
 }
 
 
@@ -297,13 +383,16 @@ non_negative<float> audio_source::get_max_gain() const
 void audio_source::set_min_gain(non_negative<float> value)
 {
   al::set_source_min_gain(m_handle, static_cast<ALfloat>(value));
+  m_min_gain = value;
 }
 
 
 
 non_negative<float> audio_source::get_min_gain() const
 {
-  return static_cast<float>(al::get_source_min_gain(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(
+    m_min_gain, static_cast<float>(al::get_source_min_gain(m_handle)));
+  return m_min_gain;
 }
 
 
@@ -311,13 +400,16 @@ non_negative<float> audio_source::get_min_gain() const
 void audio_source::set_max_distance(non_negative<float> value)
 {
   al::set_source_max_distance(m_handle, static_cast<ALfloat>(value));
+  m_max_distance = value;
 }
 
 
 
 non_negative<float> audio_source::get_max_distance() const
 {
-  return static_cast<float>(al::get_source_max_distance(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(
+    m_max_distance, static_cast<float>(al::get_source_max_distance(m_handle)));
+  return m_max_distance;
 }
 
 
@@ -325,13 +417,16 @@ non_negative<float> audio_source::get_max_distance() const
 void audio_source::set_rolloff_factor(non_negative<float> value)
 {
   al::set_source_rolloff_factor(m_handle, static_cast<ALfloat>(value));
+  m_rolloff_factor = value;
 }
 
 
 
 non_negative<float> audio_source::get_rolloff_factor() const
 {
-  return static_cast<float>(al::get_source_rolloff_factor(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(m_rolloff_factor,
+    static_cast<float>(al::get_source_rolloff_factor(m_handle)));
+  return m_rolloff_factor;
 }
 
 
@@ -339,13 +434,16 @@ non_negative<float> audio_source::get_rolloff_factor() const
 void audio_source::set_reference_distance(non_negative<float> value)
 {
   al::set_source_reference_distance(m_handle, static_cast<ALfloat>(value));
+  m_reference_distance = value;
 }
 
 
 
 non_negative<float> audio_source::get_reference_distance() const
 {
-  return static_cast<float>(al::get_source_reference_distance(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(m_reference_distance,
+    static_cast<float>(al::get_source_reference_distance(m_handle)));
+  return m_reference_distance;
 }
 
 
@@ -353,27 +451,34 @@ non_negative<float> audio_source::get_reference_distance() const
 void audio_source::set_relative(bool value)
 {
   al::set_source_relative(m_handle, static_cast<ALboolean>(value));
+  m_relative = value;
 }
 
 
 
 bool audio_source::is_relative() const
 {
-  return static_cast<bool>(al::get_source_relative(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(
+    m_relative, static_cast<bool>(al::get_source_relative(m_handle)));
+  return m_relative;
 }
 
 
 
 void audio_source::set_cone_outer_gain(non_negative<float> value)
 {
+  HOU_PRECOND(value <= 1.f);
   al::set_source_cone_outer_gain(m_handle, static_cast<ALfloat>(value));
+  m_cone_outer_gain = value;
 }
 
 
 
 non_negative<float> audio_source::get_cone_outer_gain() const
 {
-  return static_cast<float>(al::get_source_cone_outer_gain(m_handle));
+  VALIDATE_CACHED_SOURCE_VALUE(m_cone_outer_gain,
+    static_cast<float>(al::get_source_cone_outer_gain(m_handle)));
+  return m_cone_outer_gain;
 }
 
 
@@ -381,16 +486,18 @@ non_negative<float> audio_source::get_cone_outer_gain() const
 void audio_source::set_cone_inner_angle(float value)
 {
   HOU_PRECOND(value >= 0.f && value <= 2.f * pi<float>());
-  al::set_source_cone_inner_angle(
-    m_handle, static_cast<ALfloat>(rad_to_deg(value)));
+  float value_deg = rad_to_deg(value);
+  al::set_source_cone_inner_angle(m_handle, static_cast<ALfloat>(value_deg));
+  m_cone_inner_angle_deg = value_deg;
 }
 
 
 
 float audio_source::get_cone_inner_angle() const
 {
-  return deg_to_rad(
+  VALIDATE_CACHED_SOURCE_VALUE(m_cone_inner_angle_deg,
     static_cast<float>(al::get_source_cone_inner_angle(m_handle)));
+  return deg_to_rad(m_cone_inner_angle_deg);
 }
 
 
@@ -398,15 +505,18 @@ float audio_source::get_cone_inner_angle() const
 void audio_source::set_cone_outer_angle(float value)
 {
   HOU_PRECOND(value >= 0.f && value <= 2.f * pi<float>());
-  al::set_source_cone_outer_angle(
-    m_handle, static_cast<ALfloat>(rad_to_deg(value)));
+  float value_deg = rad_to_deg(value);
+  al::set_source_cone_outer_angle(m_handle, static_cast<ALfloat>(value_deg));
+  m_cone_outer_angle_deg = value_deg;
 }
 
 
 
 float audio_source::get_cone_outer_angle() const
 {
-  return deg_to_rad(static_cast<float>(al::getSourceConeOuterAngle(m_handle)));
+  VALIDATE_CACHED_SOURCE_VALUE(m_cone_outer_angle_deg,
+    static_cast<float>(al::getSourceConeOuterAngle(m_handle)));
+  return deg_to_rad(m_cone_outer_angle_deg);
 }
 
 
@@ -414,16 +524,20 @@ float audio_source::get_cone_outer_angle() const
 void audio_source::set_position(const vec3f& pos)
 {
   al::set_source_position(m_handle, static_cast<const ALfloat*>(pos.data()));
+  m_position = pos;
 }
 
 
 
 vec3f audio_source::get_position() const
 {
-  vec3f retval;
+#ifdef HOU_ENABLE_AL_STATE_VALIDATION
+  vec3f queried;
   al::get_source_position(
-    m_handle, static_cast<ALfloat*>(const_cast<float*>(retval.data())));
-  return retval;
+    m_handle, static_cast<ALfloat*>(const_cast<float*>(queried.data())));
+  VALIDATE_CACHED_SOURCE_VALUE(m_position, queried);
+#endif
+  return m_position;
 }
 
 
@@ -431,16 +545,20 @@ vec3f audio_source::get_position() const
 void audio_source::set_velocity(const vec3f& vel)
 {
   al::set_source_velocity(m_handle, static_cast<const ALfloat*>(vel.data()));
+  m_velocity = vel;
 }
 
 
 
 vec3f audio_source::get_velocity() const
 {
-  vec3f retval;
+#ifdef HOU_ENABLE_AL_STATE_VALIDATION
+  vec3f queried;
   al::get_source_velocity(
-    m_handle, static_cast<ALfloat*>(const_cast<float*>(retval.data())));
-  return retval;
+    m_handle, static_cast<ALfloat*>(const_cast<float*>(queried.data())));
+  VALIDATE_CACHED_SOURCE_VALUE(m_velocity, queried);
+#endif
+  return m_velocity;
 }
 
 
@@ -448,16 +566,20 @@ vec3f audio_source::get_velocity() const
 void audio_source::set_direction(const vec3f& dir)
 {
   al::set_source_direction(m_handle, static_cast<const ALfloat*>(dir.data()));
+  m_direction = dir;
 }
 
 
 
 vec3f audio_source::get_direction() const
 {
-  vec3f retval;
+#ifdef HOU_ENABLE_AL_STATE_VALIDATION
+  vec3f queried;
   al::get_source_direction(
-    m_handle, static_cast<ALfloat*>(const_cast<float*>(retval.data())));
-  return retval;
+    m_handle, static_cast<ALfloat*>(const_cast<float*>(queried.data())));
+  VALIDATE_CACHED_SOURCE_VALUE(m_direction, queried);
+#endif
+  return m_direction;
 }
 
 
@@ -465,6 +587,7 @@ vec3f audio_source::get_direction() const
 void audio_source::on_set_looping(bool looping)
 {
   al::set_source_looping(m_handle, static_cast<ALboolean>(looping));
+  m_looping = looping;
 }
 
 
@@ -495,4 +618,11 @@ void audio_source::on_pause()
   // Do nothing.
 }
 
+
+
+void audio_source::on_played()
+{
+  // Do nothing.
+}
+
 }  // namespace hou
@@ -0,0 +1,93 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/audio_source_batch.hpp"
+
+#include "hou/aud/audio_source.hpp"
+
+#include "hou/al/al_state.hpp"
+
+#include "hou/cor/assertions.hpp"
+
+
+
+namespace hou
+{
+
+audio_source_batch::audio_source_batch()
+  : non_copyable()
+  , m_committed(false)
+{
+  al::defer_updates();
+}
+
+
+
+audio_source_batch::~audio_source_batch()
+{
+  if(!m_committed)
+  {
+    al::process_updates();
+  }
+}
+
+
+
+void audio_source_batch::set_positions(
+  const span<audio_source* const>& sources, const span<const vec3f>& positions)
+{
+  HOU_PRECOND(!m_committed);
+  HOU_PRECOND(sources.size() == positions.size());
+  for(size_t i = 0; i < sources.size(); ++i)
+  {
+    HOU_PRECOND(sources[i] != nullptr);
+    sources[i]->set_position(positions[i]);
+  }
+}
+
+
+
+void audio_source_batch::set_velocities(
+  const span<audio_source* const>& sources, const span<const vec3f>& velocities)
+{
+  HOU_PRECOND(!m_committed);
+  HOU_PRECOND(sources.size() == velocities.size());
+  for(size_t i = 0; i < sources.size(); ++i)
+  {
+    HOU_PRECOND(sources[i] != nullptr);
+    sources[i]->set_velocity(velocities[i]);
+  }
+}
+
+
+
+void audio_source_batch::set_directions(
+  const span<audio_source* const>& sources, const span<const vec3f>& directions)
+{
+  HOU_PRECOND(!m_committed);
+  HOU_PRECOND(sources.size() == directions.size());
+  for(size_t i = 0; i < sources.size(); ++i)
+  {
+    HOU_PRECOND(sources[i] != nullptr);
+    sources[i]->set_direction(directions[i]);
+  }
+}
+
+
+
+void audio_source_batch::commit()
+{
+  HOU_PRECOND(!m_committed);
+  al::process_updates();
+  m_committed = true;
+}
+
+
+
+bool audio_source_batch::is_committed() const noexcept
+{
+  return m_committed;
+}
+
+}  // namespace hou
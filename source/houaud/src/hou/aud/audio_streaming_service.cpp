@@ -0,0 +1,332 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/audio_streaming_service.hpp"
+
+#include "hou/aud/automatic_stream_audio_source.hpp"
+
+#include <algorithm>
+#include <functional>
+
+
+
+namespace hou
+{
+
+namespace
+{
+
+// Lower bound on the time between two updates of the same source, to avoid
+// busy looping if a deadline is computed as already expired.
+constexpr std::chrono::milliseconds g_min_update_interval(1);
+
+// Upper bound on the time between two updates of the same source, so that
+// changes not notified to the service are eventually picked up.
+constexpr std::chrono::milliseconds g_max_update_interval(250);
+
+// Lower bound on the audio left in the buffer queue of a source when it is
+// updated. The refill margin is this value plus a multiple of the estimated
+// update latency.
+constexpr std::chrono::milliseconds g_min_refill_margin(2);
+
+// Factor applied to the estimated update latency when computing the refill
+// margin.
+constexpr int g_latency_margin_factor = 2;
+
+// The latency estimate follows latency peaks immediately, and decays by
+// 1 / g_latency_decay_divisor of its value at each update otherwise.
+constexpr int g_latency_decay_divisor = 16;
+
+}  // namespace
+
+
+
+bool audio_streaming_service::is_later(const entry& lhs, const entry& rhs)
+{
+  // Used as heap comparison, so that the heap front is the earliest deadline.
+  return lhs.deadline > rhs.deadline;
+}
+
+
+
+audio_streaming_service& audio_streaming_service::get_instance()
+{
+  static audio_streaming_service service;
+  return service;
+}
+
+
+
+audio_streaming_service::audio_streaming_service()
+  : non_copyable()
+  , m_schedule()
+  , m_processing_commands()
+  , m_update_latency(0)
+  , m_commands()
+  , m_posted_command_count(0u)
+  , m_processed_command_count(0u)
+  , m_commands_pending(false)
+  , m_end_requested(false)
+  , m_scheduled_source_count(0u)
+  , m_update_count(0u)
+  , m_underrun_count(0u)
+  , m_last_underrun_time(clock::time_point().time_since_epoch().count())
+  , m_refill_margin(
+      std::chrono::duration_cast<clock::duration>(g_min_refill_margin).count())
+  , m_command_mutex()
+  , m_wake_condition()
+  , m_processed_condition()
+  , m_thread()
+{
+  m_thread
+    = std::thread(std::bind(&audio_streaming_service::thread_function, this));
+}
+
+
+
+audio_streaming_service::~audio_streaming_service()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_command_mutex);
+    m_end_requested = true;
+  }
+  m_wake_condition.notify_one();
+  m_thread.join();
+}
+
+
+
+void audio_streaming_service::schedule(automatic_stream_audio_source& src)
+{
+  post_command(command_type::schedule, src);
+}
+
+
+
+void audio_streaming_service::remove(automatic_stream_audio_source& src)
+{
+  std::unique_lock<std::mutex> lock(m_command_mutex);
+  m_commands.push_back(command{command_type::remove, &src});
+  uint64_t command_index = ++m_posted_command_count;
+  m_commands_pending = true;
+  m_wake_condition.notify_one();
+  m_processed_condition.wait(
+    lock, [&]() { return m_processed_command_count >= command_index; });
+}
+
+
+
+size_t audio_streaming_service::get_scheduled_source_count() const noexcept
+{
+  return m_scheduled_source_count;
+}
+
+
+
+uint64_t audio_streaming_service::get_update_count() const noexcept
+{
+  return m_update_count;
+}
+
+
+
+uint64_t audio_streaming_service::get_underrun_count() const noexcept
+{
+  return m_underrun_count;
+}
+
+
+
+audio_streaming_service::clock::time_point
+  audio_streaming_service::get_last_underrun_time() const noexcept
+{
+  return clock::time_point(clock::duration(m_last_underrun_time));
+}
+
+
+
+audio_streaming_service::clock::duration
+  audio_streaming_service::get_refill_margin() const noexcept
+{
+  return clock::duration(m_refill_margin);
+}
+
+
+
+void audio_streaming_service::post_command(
+  command_type type, automatic_stream_audio_source& src)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_command_mutex);
+    m_commands.push_back(command{type, &src});
+    ++m_posted_command_count;
+    m_commands_pending = true;
+  }
+  m_wake_condition.notify_one();
+}
+
+
+
+void audio_streaming_service::thread_function()
+{
+  while(!m_end_requested)
+  {
+    if(m_commands_pending)
+    {
+      process_commands();
+    }
+    update_due_sources();
+    wait_for_next_deadline();
+  }
+}
+
+
+
+void audio_streaming_service::process_commands()
+{
+  uint64_t processed_command_count = 0u;
+  {
+    std::lock_guard<std::mutex> lock(m_command_mutex);
+    std::swap(m_commands, m_processing_commands);
+    processed_command_count = m_posted_command_count;
+    m_commands_pending = false;
+  }
+
+  clock::time_point now = clock::now();
+  for(const auto& cmd : m_processing_commands)
+  {
+    switch(cmd.type)
+    {
+      case command_type::schedule:
+        set_deadline(cmd.src, now);
+        break;
+      case command_type::remove:
+        remove_entry(cmd.src);
+        break;
+    }
+  }
+  m_processing_commands.clear();
+  m_scheduled_source_count = m_schedule.size();
+
+  {
+    std::lock_guard<std::mutex> lock(m_command_mutex);
+    m_processed_command_count = processed_command_count;
+  }
+  m_processed_condition.notify_all();
+}
+
+
+
+void audio_streaming_service::update_due_sources()
+{
+  clock::time_point now = clock::now();
+  while(!m_schedule.empty() && m_schedule.front().deadline <= now)
+  {
+    std::pop_heap(m_schedule.begin(), m_schedule.end(), is_later);
+    entry& e = m_schedule.back();
+    update_refill_margin(now - e.deadline);
+
+    std::chrono::nanoseconds time_to_free_buffer(0);
+    std::chrono::nanoseconds queued_time(0);
+    bool underrun = false;
+    ++m_update_count;
+    bool needs_update
+      = e.src->update_from_service(time_to_free_buffer, queued_time, underrun);
+    if(underrun)
+    {
+      ++m_underrun_count;
+      m_last_underrun_time = clock::now().time_since_epoch().count();
+    }
+
+    if(needs_update)
+    {
+      // The next update happens when the first queued buffer can be refilled,
+      // unless this would leave less than the refill margin of queued audio.
+      std::chrono::nanoseconds time_to_next_update
+        = std::min<std::chrono::nanoseconds>(
+          time_to_free_buffer, queued_time - get_refill_margin());
+      e.deadline = clock::now()
+        + std::min<std::chrono::nanoseconds>(g_max_update_interval,
+            std::max<std::chrono::nanoseconds>(
+              g_min_update_interval, time_to_next_update));
+      std::push_heap(m_schedule.begin(), m_schedule.end(), is_later);
+    }
+    else
+    {
+      m_schedule.pop_back();
+    }
+
+    // Removal requests are processed between updates, so that a source being
+    // destroyed does not have to wait for all due sources to be updated.
+    if(m_commands_pending)
+    {
+      process_commands();
+    }
+    m_scheduled_source_count = m_schedule.size();
+    now = clock::now();
+  }
+}
+
+
+
+void audio_streaming_service::update_refill_margin(clock::duration latency)
+{
+  m_update_latency = std::max(
+    latency, m_update_latency - m_update_latency / g_latency_decay_divisor);
+  clock::duration refill_margin = std::chrono::duration_cast<clock::duration>(
+    g_min_refill_margin + g_latency_margin_factor * m_update_latency);
+  m_refill_margin = refill_margin.count();
+}
+
+
+
+void audio_streaming_service::wait_for_next_deadline()
+{
+  std::unique_lock<std::mutex> lock(m_command_mutex);
+  auto wake_requested
+    = [this]() { return m_commands_pending || m_end_requested; };
+  if(m_schedule.empty())
+  {
+    m_wake_condition.wait(lock, wake_requested);
+  }
+  else
+  {
+    m_wake_condition.wait_until(
+      lock, m_schedule.front().deadline, wake_requested);
+  }
+}
+
+
+
+void audio_streaming_service::set_deadline(
+  automatic_stream_audio_source* src, clock::time_point t)
+{
+  auto it = std::find_if(m_schedule.begin(), m_schedule.end(),
+    [src](const entry& e) { return e.src == src; });
+  if(it == m_schedule.end())
+  {
+    m_schedule.push_back(entry{t, src});
+    std::push_heap(m_schedule.begin(), m_schedule.end(), is_later);
+  }
+  else if(t < it->deadline)
+  {
+    it->deadline = t;
+    std::make_heap(m_schedule.begin(), m_schedule.end(), is_later);
+  }
+}
+
+
+
+void audio_streaming_service::remove_entry(automatic_stream_audio_source* src)
+{
+  auto it = std::find_if(m_schedule.begin(), m_schedule.end(),
+    [src](const entry& e) { return e.src == src; });
+  if(it != m_schedule.end())
+  {
+    m_schedule.erase(it);
+    std::make_heap(m_schedule.begin(), m_schedule.end(), is_later);
+  }
+}
+
+}  // namespace hou
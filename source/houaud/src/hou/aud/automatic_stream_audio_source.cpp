@@ -4,7 +4,7 @@
 
 #include "hou/aud/automatic_stream_audio_source.hpp"
 
-#include <functional>
+#include "hou/aud/audio_streaming_service.hpp"
 
 
 
@@ -14,24 +14,21 @@ namespace hou
 automatic_stream_audio_source::automatic_stream_audio_source(
   std::unique_ptr<audio_stream_in> as)
   : stream_audio_source(std::move(as))
-  , m_thread()
-  , m_streaming_thread_end_requested(false)
   , m_stream_mutex()
   , m_processing_buffer_flag_mutex()
 {
-  m_thread = std::thread(
-    std::bind(&automatic_stream_audio_source::thread_function, this));
+  // Make sure that the service outlives this object.
+  audio_streaming_service::get_instance();
 }
 
 
 
 automatic_stream_audio_source::~automatic_stream_audio_source()
 {
+  audio_streaming_service::get_instance().remove(*this);
   if(get_handle().get_name() != 0)
   {
-    m_streaming_thread_end_requested = true;
     stop();
-    m_thread.join();
   }
 }
 
@@ -71,6 +68,23 @@ void automatic_stream_audio_source::set_buffer_sample_count(
 
 
 
+uint64_t automatic_stream_audio_source::get_underrun_count() const
+{
+  std::lock_guard<std::mutex> lock(m_stream_mutex);
+  return stream_audio_source::get_underrun_count();
+}
+
+
+
+std::chrono::steady_clock::time_point
+  automatic_stream_audio_source::get_last_underrun_time() const
+{
+  std::lock_guard<std::mutex> lock(m_stream_mutex);
+  return stream_audio_source::get_last_underrun_time();
+}
+
+
+
 void automatic_stream_audio_source::on_set_looping(bool looping)
 {
   std::lock_guard<std::mutex> lock(m_stream_mutex);
@@ -98,8 +112,10 @@ automatic_stream_audio_source::sample_position
 
 void automatic_stream_audio_source::on_play()
 {
-  std::lock_guard<std::mutex> lock(m_processing_buffer_flag_mutex);
-  stream_audio_source::on_play();
+  // Buffer processing is only enabled in on_played. If it was enabled here,
+  // the service could update the source before the buffer queue is set up or
+  // start the source before play() does, and the second call to play the
+  // source would restart the buffer queue.
 }
 
 
@@ -112,17 +128,33 @@ void automatic_stream_audio_source::on_pause()
 
 
 
-void automatic_stream_audio_source::thread_function()
+void automatic_stream_audio_source::on_played()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_processing_buffer_flag_mutex);
+    stream_audio_source::on_play();
+  }
+  audio_streaming_service::get_instance().schedule(*this);
+}
+
+
+
+bool automatic_stream_audio_source::update_from_service(
+  std::chrono::nanoseconds& time_to_free_buffer,
+  std::chrono::nanoseconds& queued_time, bool& underrun)
 {
-  while(!m_streaming_thread_end_requested)
+  std::lock_guard<std::mutex> stream_lock(m_stream_mutex);
+  std::lock_guard<std::mutex> proc_lock(m_processing_buffer_flag_mutex);
+  uint64_t underrun_count = stream_audio_source::get_underrun_count();
+  update_buffer_queue();
+  underrun = stream_audio_source::get_underrun_count() != underrun_count;
+  if(!is_processing_buffer_queue())
   {
-    {
-      std::lock_guard<std::mutex> stream_lock(m_stream_mutex);
-      std::lock_guard<std::mutex> proc_lock(m_processing_buffer_flag_mutex);
-      update_buffer_queue();
-    }
-    std::this_thread::sleep_for(std::chrono::milliseconds(10u));
+    return false;
   }
+  time_to_free_buffer = get_time_to_free_buffer();
+  queued_time = get_queued_time();
+  return true;
 }
 
 }  // namespace hou
@@ -0,0 +1,89 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/compressed_audio_buffer.hpp"
+
+#include "hou/aud/ogg_memory_in.hpp"
+
+
+
+namespace hou
+{
+
+compressed_audio_buffer::compressed_audio_buffer(std::vector<uint8_t> data)
+  : non_copyable()
+  , m_data(std::make_shared<const std::vector<uint8_t>>(std::move(data)))
+  , m_format(audio_buffer_format::mono16)
+  , m_sample_rate(0u)
+  , m_sample_count(0u)
+{
+  // Opening a stream validates the data and reads the metadata.
+  ogg_memory_in stream(m_data);
+  m_format = stream.get_format();
+  m_sample_rate = stream.get_sample_rate();
+  m_sample_count = stream.get_sample_count();
+}
+
+
+
+compressed_audio_buffer::compressed_audio_buffer(binary_stream_in& bs)
+  : compressed_audio_buffer(bs.read_all<std::vector<uint8_t>>())
+{}
+
+
+
+compressed_audio_buffer::compressed_audio_buffer(binary_stream_in&& bs)
+  : compressed_audio_buffer(bs.read_all<std::vector<uint8_t>>())
+{}
+
+
+
+audio_buffer_format compressed_audio_buffer::get_format() const noexcept
+{
+  return m_format;
+}
+
+
+
+uint compressed_audio_buffer::get_channel_count() const noexcept
+{
+  return get_audio_buffer_format_channel_count(m_format);
+}
+
+
+
+uint compressed_audio_buffer::get_bytes_per_sample() const noexcept
+{
+  return get_audio_buffer_format_bytes_per_sample(m_format);
+}
+
+
+
+uint compressed_audio_buffer::get_sample_rate() const noexcept
+{
+  return m_sample_rate;
+}
+
+
+
+size_t compressed_audio_buffer::get_sample_count() const noexcept
+{
+  return m_sample_count;
+}
+
+
+
+size_t compressed_audio_buffer::get_compressed_byte_count() const noexcept
+{
+  return m_data->size();
+}
+
+
+
+std::unique_ptr<audio_stream_in> compressed_audio_buffer::create_stream() const
+{
+  return std::make_unique<ogg_memory_in>(m_data);
+}
+
+}  // namespace hou
@@ -0,0 +1,89 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/ogg_memory_in.hpp"
+
+#include "hou/cor/assertions.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+
+namespace hou
+{
+
+ogg_memory_in::ogg_memory_in(const span<const uint8_t>& data)
+  : ogg_in()
+  , m_shared_data(nullptr)
+  , m_data(data)
+  , m_data_pos(0u)
+{
+  open();
+}
+
+
+
+ogg_memory_in::ogg_memory_in(std::shared_ptr<const std::vector<uint8_t>> data)
+  : ogg_in()
+  , m_shared_data(std::move(data))
+  , m_data()
+  , m_data_pos(0u)
+{
+  HOU_PRECOND(m_shared_data != nullptr);
+  m_data = span<const uint8_t>(*m_shared_data);
+  open();
+}
+
+
+
+ogg_memory_in::ogg_memory_in(ogg_memory_in&& other) noexcept
+  : ogg_in(std::move(other))
+  , m_shared_data(std::move(other.m_shared_data))
+  , m_data(std::move(other.m_data))
+  , m_data_pos(std::move(other.m_data_pos))
+{}
+
+
+
+ogg_memory_in::~ogg_memory_in()
+{}
+
+
+
+size_t ogg_memory_in::on_read_ogg_data(void* buf, size_t byte_count)
+{
+  HOU_DEV_ASSERT(m_data_pos <= m_data.size());
+  byte_count = std::min(byte_count, m_data.size() - m_data_pos);
+  if(byte_count > 0u)
+  {
+    std::memcpy(buf, m_data.data() + m_data_pos, byte_count);
+    m_data_pos += byte_count;
+  }
+  return byte_count;
+}
+
+
+
+void ogg_memory_in::on_set_ogg_data_pos(size_t pos)
+{
+  HOU_DEV_ASSERT(pos <= m_data.size());
+  m_data_pos = pos;
+}
+
+
+
+size_t ogg_memory_in::on_get_ogg_data_pos() const
+{
+  return m_data_pos;
+}
+
+
+
+size_t ogg_memory_in::on_get_ogg_data_byte_count() const
+{
+  return m_data.size();
+}
+
+}  // namespace hou
@@ -0,0 +1,64 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/ogg_stream_in.hpp"
+
+#include "hou/cor/assertions.hpp"
+#include "hou/cor/narrow_cast.hpp"
+
+
+
+namespace hou
+{
+
+ogg_stream_in::ogg_stream_in(std::unique_ptr<binary_stream_in> bs)
+  : ogg_in()
+  , m_stream(std::move(bs))
+{
+  HOU_PRECOND(m_stream != nullptr);
+  open();
+}
+
+
+
+ogg_stream_in::ogg_stream_in(ogg_stream_in&& other) noexcept
+  : ogg_in(std::move(other))
+  , m_stream(std::move(other.m_stream))
+{}
+
+
+
+ogg_stream_in::~ogg_stream_in()
+{}
+
+
+
+size_t ogg_stream_in::on_read_ogg_data(void* buf, size_t byte_count)
+{
+  m_stream->read(static_cast<uint8_t*>(buf), byte_count);
+  return m_stream->get_read_byte_count();
+}
+
+
+
+void ogg_stream_in::on_set_ogg_data_pos(size_t pos)
+{
+  m_stream->set_byte_pos(narrow_cast<binary_stream::byte_position>(pos));
+}
+
+
+
+size_t ogg_stream_in::on_get_ogg_data_pos() const
+{
+  return narrow_cast<size_t>(m_stream->get_byte_pos());
+}
+
+
+
+size_t ogg_stream_in::on_get_ogg_data_byte_count() const
+{
+  return m_stream->get_byte_count();
+}
+
+}  // namespace hou
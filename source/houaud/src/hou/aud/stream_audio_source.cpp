@@ -32,6 +32,9 @@ stream_audio_source::stream_audio_source(std::unique_ptr<audio_stream_in> as)
   , m_sample_pos(0)
   , m_buffers_to_queue_count(0u)
   , m_buffer_byte_count(g_default_buffer_byte_count)
+  , m_staging_data(g_default_buffer_byte_count)
+  , m_underrun_count(0u)
+  , m_last_underrun_time()
 {
   set_sample_pos_and_stream_cursor(0);
 }
@@ -90,6 +93,8 @@ void stream_audio_source::set_buffer_sample_count(size_t buffer_sample_count)
   stop();
   m_buffer_byte_count
     = buffer_sample_count * (get_channel_count() * get_bytes_per_sample());
+  m_staging_data.resize(m_buffer_byte_count);
+  m_staging_data.shrink_to_fit();
 }
 
 
@@ -101,6 +106,21 @@ size_t stream_audio_source::get_buffer_sample_count() const
 
 
 
+uint64_t stream_audio_source::get_underrun_count() const
+{
+  return m_underrun_count;
+}
+
+
+
+std::chrono::steady_clock::time_point
+  stream_audio_source::get_last_underrun_time() const
+{
+  return m_last_underrun_time;
+}
+
+
+
 bool stream_audio_source::is_playing() const
 {
   return m_processing_buffer_queue || audio_source::is_playing();
@@ -133,8 +153,16 @@ void stream_audio_source::update_buffer_queue()
     // queue was not updated fast enough and the audio source automatically
     // stopped. In this case force a restart of the audio source with the newly
     // added buffers.
-    if(!audio_source::is_playing())
+    // The initial state is not an underrun, it only means that play has not
+    // been called on the audio source yet.
+    ALenum state = al::get_source_state(get_handle());
+    if(state != AL_PLAYING)
     {
+      if(state == AL_STOPPED)
+      {
+        ++m_underrun_count;
+        m_last_underrun_time = std::chrono::steady_clock::now();
+      }
       al::play_source(get_handle());
     }
   }
@@ -142,16 +170,46 @@ void stream_audio_source::update_buffer_queue()
 
 
 
-std::vector<uint8_t> stream_audio_source::read_data_chunk(size_t chunk_size)
+bool stream_audio_source::is_processing_buffer_queue() const noexcept
 {
-  std::vector<uint8_t> data;
-  if(m_audio_stream != nullptr)
+  return m_processing_buffer_queue;
+}
+
+
+
+std::chrono::nanoseconds stream_audio_source::get_time_to_free_buffer() const
+{
+  if(m_buffer_queue.get_used_buffer_count() == 0u || !has_audio())
   {
-    data.resize(chunk_size);
-    m_audio_stream->read(data);
-    data.resize(m_audio_stream->get_read_byte_count());
+    return std::chrono::nanoseconds(0);
   }
-  return data;
+  return get_time_to_play(m_buffer_queue.get_front_buffer_byte_count());
+}
+
+
+
+std::chrono::nanoseconds stream_audio_source::get_queued_time() const
+{
+  if(m_buffer_queue.get_used_buffer_count() == 0u || !has_audio())
+  {
+    return std::chrono::nanoseconds(0);
+  }
+  return get_time_to_play(m_buffer_queue.get_used_byte_count());
+}
+
+
+
+span<const uint8_t> stream_audio_source::read_data_chunk()
+{
+  if(m_audio_stream == nullptr)
+  {
+    return span<const uint8_t>();
+  }
+
+  HOU_DEV_ASSERT(m_staging_data.size() == m_buffer_byte_count);
+  m_audio_stream->read(m_staging_data.data(), m_staging_data.size());
+  return span<const uint8_t>(
+    m_staging_data.data(), m_audio_stream->get_read_byte_count());
 }
 
 
@@ -161,10 +219,8 @@ void stream_audio_source::free_buffers()
   uint processed_buffers = al::get_source_processed_buffers(get_handle());
   if(processed_buffers > 0)
   {
-    std::vector<ALuint> bufferNames(processed_buffers, 0);
-    al::source_unqueue_buffers(get_handle(),
-      narrow_cast<ALsizei>(bufferNames.size()), bufferNames.data());
-    size_t processed_bytes = m_buffer_queue.free_buffers(processed_buffers);
+    size_t processed_bytes
+      = m_buffer_queue.free_buffers(get_handle(), processed_buffers);
     set_sample_pos_variable(normalize_sample_pos(m_sample_pos
       + processed_bytes / (get_channel_count() * get_bytes_per_sample())));
   }
@@ -177,7 +233,7 @@ void stream_audio_source::fill_buffers()
   while(
     m_buffers_to_queue_count > 0u && m_buffer_queue.get_free_buffer_count() > 0)
   {
-    std::vector<uint8_t> data = read_data_chunk(m_buffer_byte_count);
+    span<const uint8_t> data = read_data_chunk();
     HOU_DEV_ASSERT(!data.empty());
 
     const audio_buffer& buf
@@ -258,6 +314,24 @@ void stream_audio_source::set_buffers_to_queue_count(uint pos)
 
 
 
+std::chrono::nanoseconds stream_audio_source::get_time_to_play(
+  size_t byte_count) const
+{
+  // The sample offset of the source is relative to the first queued buffer.
+  size_t sample_byte_count = get_channel_count() * get_bytes_per_sample();
+  size_t queued_sample_count = byte_count / sample_byte_count;
+  size_t played_sample_count
+    = narrow_cast<size_t>(audio_source::on_get_sample_pos());
+  size_t remaining_sample_count = queued_sample_count > played_sample_count
+    ? queued_sample_count - played_sample_count
+    : 0u;
+  return std::chrono::nanoseconds(
+    static_cast<std::chrono::nanoseconds::rep>(remaining_sample_count)
+    * 1000000000 / get_sample_rate());
+}
+
+
+
 void stream_audio_source::on_set_looping(bool looping)
 {
   m_looping = looping;
@@ -342,37 +416,45 @@ uint stream_audio_source::get_sample_count_internal() const
 
 stream_audio_source::buffer_queue::buffer_queue(size_t buffer_count)
   : m_buffers(buffer_count)
-  , m_buffer_sample_counts()
+  , m_buffer_byte_counts(buffer_count, 0u)
+  , m_unqueued_buffer_names(buffer_count, 0u)
   , m_free_buffer_count(buffer_count)
   , m_current_index(0u)
 {}
 
 
 
-size_t stream_audio_source::buffer_queue::free_buffers(size_t count)
+size_t stream_audio_source::buffer_queue::free_buffers(
+  const al::source_handle& source, size_t count)
 {
-  m_free_buffer_count += count;
-  HOU_DEV_ASSERT(m_free_buffer_count <= m_buffers.size());
+  HOU_DEV_ASSERT(count <= get_used_buffer_count());
+  al::source_unqueue_buffers(
+    source, narrow_cast<ALsizei>(count), m_unqueued_buffer_names.data());
+
+  // Buffers are queued in ring order, so the processed buffers are the used
+  // buffers starting from the oldest one.
+  size_t front_index
+    = (m_current_index + m_free_buffer_count) % m_buffers.size();
   size_t freed_bytes = 0u;
-  for(uint i = 0; i < count; ++i)
+  for(size_t i = 0; i < count; ++i)
   {
-    freed_bytes += m_buffer_sample_counts.front();
-    m_buffer_sample_counts.pop();
+    freed_bytes += m_buffer_byte_counts[(front_index + i) % m_buffers.size()];
   }
+  m_free_buffer_count += count;
   return freed_bytes;
 }
 
 
 
 const audio_buffer& stream_audio_source::buffer_queue::fill_buffer(
-  const std::vector<uint8_t>& data, audio_buffer_format format, int sample_rate)
+  const span<const uint8_t>& data, audio_buffer_format format, int sample_rate)
 {
   HOU_DEV_ASSERT(m_free_buffer_count > 0);
   audio_buffer& buffer = m_buffers[m_current_index];
   buffer.set_data(data, format, sample_rate);
+  m_buffer_byte_counts[m_current_index] = data.size();
   m_current_index = (m_current_index + 1) % m_buffers.size();
   --m_free_buffer_count;
-  m_buffer_sample_counts.push(data.size());
   return buffer;
 }
 
@@ -397,5 +479,28 @@ size_t stream_audio_source::buffer_queue::get_buffer_count() const
   return m_buffers.size();
 }
 
-}  // namespace hou
 
+
+size_t stream_audio_source::buffer_queue::get_front_buffer_byte_count() const
+{
+  HOU_DEV_ASSERT(get_used_buffer_count() > 0u);
+  return m_buffer_byte_counts[(m_current_index + m_free_buffer_count)
+    % m_buffers.size()];
+}
+
+
+
+size_t stream_audio_source::buffer_queue::get_used_byte_count() const
+{
+  size_t front_index
+    = (m_current_index + m_free_buffer_count) % m_buffers.size();
+  size_t used_byte_count = 0u;
+  for(size_t i = 0; i < get_used_buffer_count(); ++i)
+  {
+    used_byte_count
+      += m_buffer_byte_counts[(front_index + i) % m_buffers.size()];
+  }
+  return used_byte_count;
+}
+
+}  // namespace hou
@@ -0,0 +1,444 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/voice_pool.hpp"
+
+#include "hou/aud/audio_buffer.hpp"
+#include "hou/aud/listener.hpp"
+#include "hou/aud/sound_model.hpp"
+
+#include "hou/cor/assertions.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+
+namespace hou
+{
+
+namespace
+{
+
+// Default OpenAL audio source distance parameters.
+constexpr float g_reference_distance = 1.f;
+constexpr float g_rolloff_factor = 1.f;
+constexpr float g_max_distance = std::numeric_limits<float>::max();
+
+// Lower bound of the distance, so that the unclamped models do not divide by
+// zero when a sound is at the listener position.
+constexpr float g_min_distance = std::numeric_limits<float>::epsilon();
+
+float get_distance_attenuation(sound_distance_model model, float distance);
+
+std::chrono::nanoseconds get_buffer_duration(const audio_buffer& buffer);
+
+
+
+float get_distance_attenuation(sound_distance_model model, float distance)
+{
+  // Formulas from the OpenAL specification.
+  distance = std::max(distance, g_min_distance);
+  switch(model)
+  {
+    case sound_distance_model::inverse_distance_clamped:
+      distance
+        = std::min(std::max(distance, g_reference_distance), g_max_distance);
+      // Fall through.
+    case sound_distance_model::inverse_distance:
+      return g_reference_distance
+        / (g_reference_distance
+            + g_rolloff_factor * (distance - g_reference_distance));
+    case sound_distance_model::linear_distance_clamped:
+      distance
+        = std::min(std::max(distance, g_reference_distance), g_max_distance);
+      // Fall through.
+    case sound_distance_model::linear_distance:
+      return std::max(0.f,
+        1.f
+          - g_rolloff_factor * (distance - g_reference_distance)
+            / (g_max_distance - g_reference_distance));
+    case sound_distance_model::exponent_distance_clamped:
+      distance
+        = std::min(std::max(distance, g_reference_distance), g_max_distance);
+      // Fall through.
+    case sound_distance_model::exponent_distance:
+      return std::pow(distance / g_reference_distance, -g_rolloff_factor);
+  }
+  return 1.f;
+}
+
+
+
+std::chrono::nanoseconds get_buffer_duration(const audio_buffer& buffer)
+{
+  using rep = std::chrono::nanoseconds::rep;
+  return buffer.get_sample_rate() == 0
+    ? std::chrono::nanoseconds(0)
+    : std::chrono::nanoseconds(static_cast<rep>(buffer.get_sample_count())
+      * 1000000000 / static_cast<rep>(buffer.get_sample_rate()));
+}
+
+}  // namespace
+
+
+
+constexpr voice_pool::sound_id voice_pool::invalid_sound_id;
+constexpr size_t voice_pool::no_voice;
+
+
+
+voice_pool::voice_pool(size_t voice_count)
+  : non_copyable()
+  , m_voices()
+  , m_free_voices()
+  , m_sounds()
+  , m_ranking()
+  , m_next_id(invalid_sound_id + 1u)
+  , m_voice_bind_count(0u)
+  , m_voice_unbind_count(0u)
+{
+  HOU_PRECOND(voice_count > 0u);
+  m_voices.reserve(voice_count);
+  m_free_voices.reserve(voice_count);
+  for(size_t i = 0; i < voice_count; ++i)
+  {
+    m_voices.emplace_back();
+    m_free_voices.push_back(voice_count - i - 1u);
+  }
+}
+
+
+
+voice_pool::sound_id voice_pool::play(std::shared_ptr<audio_buffer> buffer,
+  non_negative<float> priority, bool looping)
+{
+  HOU_PRECOND(buffer != nullptr);
+
+  sound_id id = m_next_id;
+  ++m_next_id;
+  if(m_next_id == invalid_sound_id)
+  {
+    ++m_next_id;
+  }
+
+  std::chrono::nanoseconds duration = get_buffer_duration(*buffer);
+  sound& s = m_sounds
+               .emplace(id,
+                 sound{std::move(buffer), std::chrono::nanoseconds(0),
+                   duration, vec3f::zero(), 1.f, priority, 0.f, no_voice,
+                   looping})
+               .first->second;
+  if(!m_free_voices.empty())
+  {
+    size_t voice = m_free_voices.back();
+    m_free_voices.pop_back();
+    bind_voice(s, voice);
+  }
+  return id;
+}
+
+
+
+void voice_pool::stop(sound_id id)
+{
+  auto it = m_sounds.find(id);
+  if(it != m_sounds.end())
+  {
+    if(it->second.voice != no_voice)
+    {
+      unbind_voice(it->second);
+    }
+    m_sounds.erase(it);
+  }
+}
+
+
+
+void voice_pool::clear()
+{
+  for(auto& id_and_sound : m_sounds)
+  {
+    if(id_and_sound.second.voice != no_voice)
+    {
+      unbind_voice(id_and_sound.second);
+    }
+  }
+  m_sounds.clear();
+}
+
+
+
+void voice_pool::update(std::chrono::nanoseconds elapsed)
+{
+  sound_distance_model model = sound_model::get_distance_model();
+  vec3f listener_pos = listener::get_position();
+
+  // Advance the playback positions, remove the sounds which ended and compute
+  // the audibility of the others.
+  m_ranking.clear();
+  for(auto it = m_sounds.begin(); it != m_sounds.end();)
+  {
+    sound& s = it->second;
+    bool ended = false;
+    if(s.voice == no_voice)
+    {
+      s.time_pos += elapsed;
+      if(s.time_pos >= s.duration)
+      {
+        if(s.looping && s.duration.count() > 0)
+        {
+          s.time_pos %= s.duration;
+        }
+        else
+        {
+          ended = true;
+        }
+      }
+    }
+    else
+    {
+      const buffer_audio_source& voice = m_voices[s.voice];
+      if(voice.is_playing())
+      {
+        s.time_pos = voice.get_time_pos();
+      }
+      else
+      {
+        ended = true;
+      }
+    }
+
+    if(ended)
+    {
+      if(s.voice != no_voice)
+      {
+        unbind_voice(s);
+      }
+      it = m_sounds.erase(it);
+    }
+    else
+    {
+      s.audibility = s.priority * s.gain
+        * get_distance_attenuation(model, norm(s.position - listener_pos));
+      // A non-finite audibility would break the strict weak ordering used to
+      // rank the sounds.
+      if(!std::isfinite(s.audibility))
+      {
+        s.audibility = 0.f;
+      }
+      m_ranking.push_back(std::make_pair(s.audibility, it->first));
+      ++it;
+    }
+  }
+
+  // Select the most audible sounds. Ties are resolved in favor of the older
+  // sounds, so that sounds with equal audibility do not swap voices.
+  size_t real_count = std::min(m_voices.size(), m_ranking.size());
+  auto is_more_audible = [](const std::pair<float, sound_id>& lhs,
+                           const std::pair<float, sound_id>& rhs) {
+    return lhs.first > rhs.first
+      || (!(lhs.first < rhs.first) && lhs.second < rhs.second);
+  };
+  if(real_count < m_ranking.size())
+  {
+    std::nth_element(m_ranking.begin(), m_ranking.begin() + real_count,
+      m_ranking.end(), is_more_audible);
+  }
+
+  // Demote first, so that the freed voices can be used for the promotions.
+  // The first real_count elements are not sorted, so inaudible sounds among
+  // them are skipped individually: they are never bound to a voice.
+  for(size_t i = 0; i < m_ranking.size(); ++i)
+  {
+    sound& s = get_sound(m_ranking[i].second);
+    if(s.voice != no_voice
+      && (i >= real_count || m_ranking[i].first <= 0.f))
+    {
+      unbind_voice(s);
+    }
+  }
+  for(size_t i = 0; i < real_count; ++i)
+  {
+    sound& s = get_sound(m_ranking[i].second);
+    if(s.voice == no_voice && m_ranking[i].first > 0.f)
+    {
+      HOU_DEV_ASSERT(!m_free_voices.empty());
+      size_t voice = m_free_voices.back();
+      m_free_voices.pop_back();
+      bind_voice(s, voice);
+    }
+  }
+}
+
+
+
+bool voice_pool::is_playing(sound_id id) const
+{
+  return m_sounds.find(id) != m_sounds.end();
+}
+
+
+
+bool voice_pool::is_virtual(sound_id id) const
+{
+  return get_sound(id).voice == no_voice;
+}
+
+
+
+std::chrono::nanoseconds voice_pool::get_time_pos(sound_id id) const
+{
+  const sound& s = get_sound(id);
+  return s.voice == no_voice ? s.time_pos : m_voices[s.voice].get_time_pos();
+}
+
+
+
+void voice_pool::set_position(sound_id id, const vec3f& pos)
+{
+  sound& s = get_sound(id);
+  s.position = pos;
+  if(s.voice != no_voice)
+  {
+    m_voices[s.voice].set_position(pos);
+  }
+}
+
+
+
+vec3f voice_pool::get_position(sound_id id) const
+{
+  return get_sound(id).position;
+}
+
+
+
+void voice_pool::set_gain(sound_id id, non_negative<float> value)
+{
+  sound& s = get_sound(id);
+  s.gain = value;
+  if(s.voice != no_voice)
+  {
+    m_voices[s.voice].set_gain(value);
+  }
+}
+
+
+
+non_negative<float> voice_pool::get_gain(sound_id id) const
+{
+  return get_sound(id).gain;
+}
+
+
+
+void voice_pool::set_priority(sound_id id, non_negative<float> value)
+{
+  get_sound(id).priority = value;
+}
+
+
+
+non_negative<float> voice_pool::get_priority(sound_id id) const
+{
+  return get_sound(id).priority;
+}
+
+
+
+float voice_pool::get_audibility(sound_id id) const
+{
+  return get_sound(id).audibility;
+}
+
+
+
+size_t voice_pool::get_voice_count() const noexcept
+{
+  return m_voices.size();
+}
+
+
+
+size_t voice_pool::get_sound_count() const noexcept
+{
+  return m_sounds.size();
+}
+
+
+
+size_t voice_pool::get_real_sound_count() const noexcept
+{
+  return m_voices.size() - m_free_voices.size();
+}
+
+
+
+size_t voice_pool::get_virtual_sound_count() const noexcept
+{
+  return get_sound_count() - get_real_sound_count();
+}
+
+
+
+uint64_t voice_pool::get_voice_bind_count() const noexcept
+{
+  return m_voice_bind_count;
+}
+
+
+
+uint64_t voice_pool::get_voice_unbind_count() const noexcept
+{
+  return m_voice_unbind_count;
+}
+
+
+
+voice_pool::sound& voice_pool::get_sound(sound_id id)
+{
+  auto it = m_sounds.find(id);
+  HOU_PRECOND(it != m_sounds.end());
+  return it->second;
+}
+
+
+
+const voice_pool::sound& voice_pool::get_sound(sound_id id) const
+{
+  auto it = m_sounds.find(id);
+  HOU_PRECOND(it != m_sounds.end());
+  return it->second;
+}
+
+
+
+void voice_pool::bind_voice(sound& s, size_t voice)
+{
+  HOU_DEV_ASSERT(s.voice == no_voice);
+  buffer_audio_source& src = m_voices[voice];
+  src.set_buffer(s.buffer);
+  src.set_looping(s.looping);
+  src.set_gain(s.gain);
+  src.set_position(s.position);
+  src.set_time_pos(s.time_pos);
+  src.play();
+  s.voice = voice;
+  ++m_voice_bind_count;
+}
+
+
+
+void voice_pool::unbind_voice(sound& s)
+{
+  HOU_DEV_ASSERT(s.voice != no_voice);
+  m_voices[s.voice].set_buffer(nullptr);
+  m_free_voices.push_back(s.voice);
+  s.voice = no_voice;
+  ++m_voice_unbind_count;
+}
+
+}  // namespace hou
@@ -175,6 +175,31 @@ TEST_F(test_audio_buffer, set_data)
 
 
 
+TEST_F(test_audio_buffer_death_test, set_data_invalid_sample_rate)
+{
+  audio_buffer ab;
+  std::vector<uint8_t> data{1u, 2u, 3u, 4u};
+  EXPECT_PRECOND_ERROR(ab.set_data(data, audio_buffer_format::stereo16, 0));
+  EXPECT_PRECOND_ERROR(ab.set_data(data, audio_buffer_format::stereo16, -1));
+  EXPECT_EQ(audio_buffer_format::mono16, ab.get_format());
+  EXPECT_EQ(1, ab.get_sample_rate());
+  EXPECT_EQ(2u, ab.get_byte_count());
+}
+
+
+
+TEST_F(test_audio_buffer_death_test, set_data_invalid_byte_count)
+{
+  audio_buffer ab;
+  std::vector<uint8_t> data{1u, 2u, 3u, 4u, 5u, 6u};
+  EXPECT_PRECOND_ERROR(ab.set_data(data, audio_buffer_format::stereo16, 114));
+  EXPECT_EQ(audio_buffer_format::mono16, ab.get_format());
+  EXPECT_EQ(1, ab.get_sample_rate());
+  EXPECT_EQ(2u, ab.get_byte_count());
+}
+
+
+
 TEST_F(test_audio_buffer, set_data_with_move)
 {
   std::vector<uint8_t> data_ref1{1u, 2u, 3u, 4u};
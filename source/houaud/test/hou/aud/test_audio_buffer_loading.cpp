@@ -0,0 +1,108 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/test_aud_base.hpp"
+#include "hou/aud/test_data.hpp"
+#include "hou/test.hpp"
+
+#include "hou/aud/aud_exceptions.hpp"
+#include "hou/aud/audio_buffer_loading.hpp"
+#include "hou/aud/ogg_file_in.hpp"
+
+#include "hou/sys/sys_exceptions.hpp"
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_audio_buffer_loading : public test_aud_base
+{};
+
+class test_audio_buffer_loading_death_test : public test_audio_buffer_loading
+{};
+
+std::vector<uint8_t> read_ogg_file(const std::string& path);
+
+
+
+std::vector<uint8_t> read_ogg_file(const std::string& path)
+{
+  return ogg_file_in(path).read_all<std::vector<uint8_t>>();
+}
+
+}  // namespace
+
+
+
+TEST_F(test_audio_buffer_loading, decode_single_chunk)
+{
+  EXPECT_EQ(read_ogg_file(get_stereo16_ogg_filename()),
+    decode_ogg_file(get_stereo16_ogg_filename(), 4u));
+}
+
+
+
+TEST_F(test_audio_buffer_loading, decode_many_chunks)
+{
+  // The chunk boundaries do not match the packet boundaries.
+  std::vector<uint8_t> pcm_ref = read_ogg_file(get_stereo16_ogg_filename());
+  EXPECT_EQ(pcm_ref, decode_ogg_file(get_stereo16_ogg_filename(), 1u, 1000u));
+  EXPECT_EQ(pcm_ref, decode_ogg_file(get_stereo16_ogg_filename(), 3u, 1000u));
+  EXPECT_EQ(pcm_ref, decode_ogg_file(get_stereo16_ogg_filename(), 8u, 4099u));
+}
+
+
+
+TEST_F(test_audio_buffer_loading_death_test, decode_error_invalid_parameters)
+{
+  EXPECT_PRECOND_ERROR(decode_ogg_file(get_stereo16_ogg_filename(), 0u));
+  EXPECT_PRECOND_ERROR(decode_ogg_file(get_stereo16_ogg_filename(), 1u, 0u));
+}
+
+
+
+TEST_F(test_audio_buffer_loading_death_test, decode_error_invalid_file)
+{
+  EXPECT_ERROR_N(decode_ogg_file(u8"invalid_file.ogg", 2u), file_open_error,
+    u8"invalid_file.ogg");
+  EXPECT_ERROR_0(
+    decode_ogg_file(get_stereo16_wav_filename(), 2u), invalid_audio_data);
+}
+
+
+
+TEST_F(test_audio_buffer_loading, load_audio_buffer)
+{
+  audio_buffer ab
+    = load_ogg_audio_buffer(get_stereo16_ogg_filename(), 4u, 1000u);
+  EXPECT_EQ(audio_buffer_format::stereo16, ab.get_format());
+  EXPECT_EQ(44100, ab.get_sample_rate());
+  EXPECT_EQ(21231u, ab.get_sample_count());
+}
+
+
+
+TEST_F(test_audio_buffer_loading, load_audio_buffers)
+{
+  std::vector<std::string> paths(3u, get_stereo16_ogg_filename());
+  std::vector<audio_buffer> buffers = load_ogg_audio_buffers(paths, 4u, 5000u);
+  ASSERT_EQ(3u, buffers.size());
+  for(const auto& ab : buffers)
+  {
+    EXPECT_EQ(audio_buffer_format::stereo16, ab.get_format());
+    EXPECT_EQ(44100, ab.get_sample_rate());
+    EXPECT_EQ(21231u, ab.get_sample_count());
+  }
+}
+
+
+
+TEST_F(test_audio_buffer_loading, load_no_audio_buffers)
+{
+  EXPECT_TRUE(load_ogg_audio_buffers(std::vector<std::string>(), 4u).empty());
+}
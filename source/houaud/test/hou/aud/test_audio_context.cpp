@@ -4,7 +4,12 @@
 
 #include "hou/test.hpp"
 
+#include "hou/aud/audio_buffer.hpp"
 #include "hou/aud/audio_context.hpp"
+#include "hou/aud/buffer_audio_source.hpp"
+
+#include <algorithm>
+#include <vector>
 
 using namespace hou;
 using namespace testing;
@@ -17,6 +22,9 @@ namespace
 class test_audio_context : public Test
 {};
 
+class test_audio_context_death_test : public test_audio_context
+{};
+
 }  // namespace
 
 
@@ -99,3 +107,82 @@ TEST_F(test_audio_context, set_current)
   }
   EXPECT_EQ(nullptr, al::context::get_current());
 }
+
+
+
+TEST_F(test_audio_context, loopback_creation)
+{
+  audio_context ctx = audio_context::create_loopback(44100u, 2u);
+  EXPECT_TRUE(ctx.is_loopback());
+  EXPECT_NE(0u, ctx.get_impl().get_uid());
+  EXPECT_EQ(44100u, ctx.get_device().get_loopback_sample_rate());
+  EXPECT_EQ(2u, ctx.get_device().get_loopback_channel_count());
+}
+
+
+
+TEST_F(test_audio_context, render_silence)
+{
+  audio_context ctx = audio_context::create_loopback(44100u, 2u);
+  audio_context::set_current(ctx);
+  std::vector<int16_t> buffer(1024u, 1000);
+  ctx.render(buffer);
+
+  // The output might be dithered, so it is not necessarily exactly 0.
+  EXPECT_TRUE(std::all_of(buffer.begin(), buffer.end(),
+    [](int16_t s) { return s >= -2 && s <= 2; }));
+}
+
+
+
+TEST_F(test_audio_context, render_playing_source)
+{
+  audio_context ctx = audio_context::create_loopback(44100u, 1u);
+  audio_context::set_current(ctx);
+
+  // A square wave at full scale.
+  std::vector<uint8_t> data(4410u * 2u);
+  for(size_t i = 0; i < data.size(); i += 2u)
+  {
+    int16_t value = (i / 100u) % 2u == 0u ? 32767 : -32767;
+    data[i] = static_cast<uint8_t>(value & 0xff);
+    data[i + 1u] = static_cast<uint8_t>((value >> 8) & 0xff);
+  }
+  buffer_audio_source as(std::make_shared<audio_buffer>(
+    std::move(data), audio_buffer_format::mono16, 44100));
+  as.play();
+
+  std::vector<int16_t> buffer(1024u, 0);
+  ctx.render(buffer);
+  EXPECT_TRUE(std::any_of(buffer.begin(), buffer.end(),
+    [](int16_t s) { return s > 1000 || s < -1000; }));
+}
+
+
+
+TEST_F(test_audio_context_death_test, render_error_not_loopback)
+{
+  audio_context ctx;
+  audio_context::set_current(ctx);
+  std::vector<int16_t> buffer(64u);
+  EXPECT_PRECOND_ERROR(ctx.render(buffer));
+}
+
+
+
+TEST_F(test_audio_context_death_test, render_error_not_current)
+{
+  audio_context ctx = audio_context::create_loopback(44100u, 2u);
+  std::vector<int16_t> buffer(64u);
+  EXPECT_PRECOND_ERROR(ctx.render(buffer));
+}
+
+
+
+TEST_F(test_audio_context_death_test, render_error_invalid_buffer_size)
+{
+  audio_context ctx = audio_context::create_loopback(44100u, 2u);
+  audio_context::set_current(ctx);
+  std::vector<int16_t> buffer(63u);
+  EXPECT_PRECOND_ERROR(ctx.render(buffer));
+}
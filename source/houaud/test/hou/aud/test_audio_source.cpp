@@ -16,6 +16,8 @@
 
 #include "hou/mth/math_functions.hpp"
 
+#include <thread>
+
 using namespace hou;
 using namespace testing;
 
@@ -842,6 +844,7 @@ TYPED_TEST(test_audio_source, invalid_cone_outer_gain)
 {
   auto& as = this->get_audio_source();
   EXPECT_PRECOND_ERROR(as.set_cone_outer_gain(-3.f));
+  EXPECT_PRECOND_ERROR(as.set_cone_outer_gain(1.5f));
 }
 
 
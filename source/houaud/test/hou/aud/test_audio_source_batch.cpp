@@ -0,0 +1,140 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/test_aud_base.hpp"
+#include "hou/test.hpp"
+
+#include "hou/aud/audio_source_batch.hpp"
+#include "hou/aud/buffer_audio_source.hpp"
+
+#include <vector>
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_audio_source_batch : public test_aud_base
+{};
+
+class test_audio_source_batch_death_test : public test_audio_source_batch
+{};
+
+}  // namespace
+
+
+
+TEST_F(test_audio_source_batch, constructor)
+{
+  audio_source_batch asb;
+  EXPECT_FALSE(asb.is_committed());
+}
+
+
+
+TEST_F(test_audio_source_batch, commit)
+{
+  audio_source_batch asb;
+  asb.commit();
+  EXPECT_TRUE(asb.is_committed());
+}
+
+
+
+TEST_F(test_audio_source_batch_death_test, commit_twice)
+{
+  audio_source_batch asb;
+  asb.commit();
+  EXPECT_PRECOND_ERROR(asb.commit());
+}
+
+
+
+TEST_F(test_audio_source_batch, set_spatial_parameters)
+{
+  std::vector<buffer_audio_source> sources(3u);
+  std::vector<audio_source*> source_ptrs;
+  std::vector<vec3f> positions;
+  std::vector<vec3f> velocities;
+  std::vector<vec3f> directions;
+  for(size_t i = 0; i < sources.size(); ++i)
+  {
+    float f = static_cast<float>(i);
+    source_ptrs.push_back(&sources[i]);
+    positions.push_back(vec3f(f, 1.f, 2.f));
+    velocities.push_back(vec3f(3.f, f, 4.f));
+    directions.push_back(vec3f(5.f, 6.f, f));
+  }
+
+  {
+    audio_source_batch asb;
+    asb.set_positions(source_ptrs, positions);
+    asb.set_velocities(source_ptrs, velocities);
+    asb.set_directions(source_ptrs, directions);
+  }
+
+  for(size_t i = 0; i < sources.size(); ++i)
+  {
+    EXPECT_FLOAT_CLOSE(positions[i], sources[i].get_position());
+    EXPECT_FLOAT_CLOSE(velocities[i], sources[i].get_velocity());
+    EXPECT_FLOAT_CLOSE(directions[i], sources[i].get_direction());
+  }
+}
+
+
+
+TEST_F(test_audio_source_batch, set_after_commit)
+{
+  buffer_audio_source as;
+  std::vector<audio_source*> source_ptrs{&as};
+  std::vector<vec3f> positions{vec3f(1.f, 2.f, 3.f)};
+
+  audio_source_batch asb;
+  asb.set_positions(source_ptrs, positions);
+  asb.commit();
+  EXPECT_FLOAT_CLOSE(positions.front(), as.get_position());
+}
+
+
+
+TEST_F(test_audio_source_batch_death_test, set_error_committed)
+{
+  buffer_audio_source as;
+  std::vector<audio_source*> source_ptrs{&as};
+  std::vector<vec3f> values{vec3f(1.f, 2.f, 3.f)};
+
+  audio_source_batch asb;
+  asb.commit();
+  EXPECT_PRECOND_ERROR(asb.set_positions(source_ptrs, values));
+  EXPECT_PRECOND_ERROR(asb.set_velocities(source_ptrs, values));
+  EXPECT_PRECOND_ERROR(asb.set_directions(source_ptrs, values));
+}
+
+
+
+TEST_F(test_audio_source_batch_death_test, set_error_size_mismatch)
+{
+  buffer_audio_source as;
+  std::vector<audio_source*> source_ptrs{&as};
+  std::vector<vec3f> values{vec3f::zero(), vec3f::zero()};
+
+  audio_source_batch asb;
+  EXPECT_PRECOND_ERROR(asb.set_positions(source_ptrs, values));
+  EXPECT_PRECOND_ERROR(asb.set_velocities(source_ptrs, values));
+  EXPECT_PRECOND_ERROR(asb.set_directions(source_ptrs, values));
+}
+
+
+
+TEST_F(test_audio_source_batch_death_test, set_error_null_source)
+{
+  std::vector<audio_source*> source_ptrs{nullptr};
+  std::vector<vec3f> values{vec3f::zero()};
+
+  audio_source_batch asb;
+  EXPECT_PRECOND_ERROR(asb.set_positions(source_ptrs, values));
+}
@@ -0,0 +1,188 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/test_aud_base.hpp"
+#include "hou/aud/test_data.hpp"
+#include "hou/test.hpp"
+
+#include "hou/aud/audio_streaming_service.hpp"
+#include "hou/aud/automatic_stream_audio_source.hpp"
+#include "hou/aud/listener.hpp"
+#include "hou/aud/ogg_file_in.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_audio_streaming_service : public test_aud_base
+{
+public:
+  static void SetUpTestCase();
+};
+
+bool wait_for(const std::function<bool()>& condition);
+
+
+
+void test_audio_streaming_service::SetUpTestCase()
+{
+  test_aud_base::SetUpTestCase();
+  listener::set_gain(0.f);
+}
+
+
+
+bool wait_for(const std::function<bool()>& condition)
+{
+  for(size_t i = 0; i < 200u && !condition(); ++i)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return condition();
+}
+
+}  // namespace
+
+
+
+TEST_F(test_audio_streaming_service, playing_sources_are_scheduled)
+{
+  audio_streaming_service& service = audio_streaming_service::get_instance();
+  size_t initial_count = service.get_scheduled_source_count();
+
+  std::vector<std::unique_ptr<automatic_stream_audio_source>> sources;
+  for(size_t i = 0; i < 4u; ++i)
+  {
+    sources.push_back(std::make_unique<automatic_stream_audio_source>(
+      std::make_unique<ogg_file_in>(get_stereo16_ogg_filename())));
+    sources.back()->set_looping(true);
+    sources.back()->play();
+  }
+
+  EXPECT_TRUE(wait_for([&]() {
+    return service.get_scheduled_source_count() == initial_count + 4u;
+  }));
+  for(const auto& src : sources)
+  {
+    EXPECT_TRUE(src->is_playing());
+  }
+
+  for(auto& src : sources)
+  {
+    src->stop();
+  }
+  EXPECT_TRUE(wait_for([&]() {
+    return service.get_scheduled_source_count() == initial_count;
+  }));
+}
+
+
+
+TEST_F(test_audio_streaming_service, destroyed_sources_are_removed)
+{
+  audio_streaming_service& service = audio_streaming_service::get_instance();
+  size_t initial_count = service.get_scheduled_source_count();
+  {
+    automatic_stream_audio_source as(
+      std::make_unique<ogg_file_in>(get_stereo16_ogg_filename()));
+    as.set_looping(true);
+    as.play();
+    EXPECT_TRUE(wait_for([&]() {
+      return service.get_scheduled_source_count() == initial_count + 1u;
+    }));
+  }
+  EXPECT_EQ(initial_count, service.get_scheduled_source_count());
+}
+
+
+
+TEST_F(test_audio_streaming_service, playing_sources_are_updated)
+{
+  audio_streaming_service& service = audio_streaming_service::get_instance();
+  automatic_stream_audio_source as(
+    std::make_unique<ogg_file_in>(get_stereo16_ogg_filename()));
+  as.set_buffer_sample_count(441u);
+  as.set_looping(true);
+  uint64_t initial_update_count = service.get_update_count();
+  as.play();
+  EXPECT_TRUE(wait_for(
+    [&]() { return service.get_update_count() > initial_update_count + 4u; }));
+  EXPECT_TRUE(as.is_playing());
+}
+
+
+
+TEST_F(test_audio_streaming_service, underruns_are_recorded)
+{
+  audio_streaming_service& service = audio_streaming_service::get_instance();
+  automatic_stream_audio_source as(
+    std::make_unique<ogg_file_in>(get_stereo16_ogg_filename()));
+
+  // The buffer queue is much shorter than the minimum update interval, so
+  // that it runs empty between updates.
+  as.set_buffer_count(2u);
+  as.set_buffer_sample_count(4u);
+  as.set_looping(true);
+  uint64_t initial_underrun_count = service.get_underrun_count();
+  auto start_time = audio_streaming_service::clock::now();
+  as.play();
+  EXPECT_TRUE(wait_for([&]() { return as.get_underrun_count() > 0u; }));
+  EXPECT_LE(start_time, as.get_last_underrun_time());
+  EXPECT_LT(initial_underrun_count, service.get_underrun_count());
+  EXPECT_LE(start_time, service.get_last_underrun_time());
+  EXPECT_TRUE(as.is_playing());
+}
+
+
+
+TEST_F(test_audio_streaming_service, replay_is_not_an_underrun)
+{
+  automatic_stream_audio_source as(
+    std::make_unique<ogg_file_in>(get_stereo16_ogg_filename()));
+  as.play();
+  for(size_t i = 0; i < 3u; ++i)
+  {
+    // Wait for the playback to end on its own before restarting it.
+    EXPECT_TRUE(wait_for([&]() { return !as.is_playing(); }));
+    as.replay();
+    EXPECT_TRUE(as.is_playing());
+  }
+  EXPECT_EQ(0u, as.get_underrun_count());
+}
+
+
+
+TEST_F(test_audio_streaming_service, seek_is_not_an_underrun)
+{
+  automatic_stream_audio_source as(
+    std::make_unique<ogg_file_in>(get_stereo16_ogg_filename()));
+  as.set_looping(true);
+  as.play();
+  for(uint i = 0; i < 50u; ++i)
+  {
+    as.set_sample_pos(i * 100u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  EXPECT_TRUE(as.is_playing());
+  EXPECT_EQ(0u, as.get_underrun_count());
+}
+
+
+
+TEST_F(test_audio_streaming_service, refill_margin)
+{
+  audio_streaming_service& service = audio_streaming_service::get_instance();
+  EXPECT_LT(audio_streaming_service::clock::duration(0),
+    service.get_refill_margin());
+}
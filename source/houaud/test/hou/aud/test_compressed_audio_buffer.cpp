@@ -0,0 +1,169 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/test_aud_base.hpp"
+#include "hou/aud/test_data.hpp"
+#include "hou/test.hpp"
+
+#include "hou/aud/aud_exceptions.hpp"
+#include "hou/aud/compressed_audio_buffer.hpp"
+#include "hou/aud/listener.hpp"
+#include "hou/aud/manual_stream_audio_source.hpp"
+#include "hou/aud/ogg_file_in.hpp"
+
+#include "hou/sys/binary_file_in.hpp"
+
+#include <vector>
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_compressed_audio_buffer : public test_aud_base
+{
+public:
+  static void SetUpTestCase();
+};
+
+class test_compressed_audio_buffer_death_test
+  : public test_compressed_audio_buffer
+{};
+
+compressed_audio_buffer load_stereo16_ogg();
+
+
+
+void test_compressed_audio_buffer::SetUpTestCase()
+{
+  test_aud_base::SetUpTestCase();
+  listener::set_gain(0.f);
+}
+
+
+
+compressed_audio_buffer load_stereo16_ogg()
+{
+  return compressed_audio_buffer(binary_file_in(get_stereo16_ogg_filename()));
+}
+
+}  // namespace
+
+
+
+TEST_F(test_compressed_audio_buffer, data_constructor)
+{
+  std::vector<uint8_t> data = binary_file_in(get_stereo16_ogg_filename())
+                                .read_all<std::vector<uint8_t>>();
+  size_t data_size = data.size();
+  compressed_audio_buffer cab(std::move(data));
+  EXPECT_EQ(audio_buffer_format::stereo16, cab.get_format());
+  EXPECT_EQ(2u, cab.get_channel_count());
+  EXPECT_EQ(2u, cab.get_bytes_per_sample());
+  EXPECT_EQ(44100u, cab.get_sample_rate());
+  EXPECT_EQ(21231u, cab.get_sample_count());
+  EXPECT_EQ(data_size, cab.get_compressed_byte_count());
+}
+
+
+
+TEST_F(test_compressed_audio_buffer, stream_constructor)
+{
+  binary_file_in fi(get_stereo16_ogg_filename());
+  compressed_audio_buffer cab(fi);
+  EXPECT_EQ(audio_buffer_format::stereo16, cab.get_format());
+  EXPECT_EQ(44100u, cab.get_sample_rate());
+  EXPECT_EQ(21231u, cab.get_sample_count());
+  EXPECT_EQ(fi.get_byte_count(), cab.get_compressed_byte_count());
+}
+
+
+
+TEST_F(test_compressed_audio_buffer_death_test, invalid_data)
+{
+  binary_file_in fi(get_stereo16_wav_filename());
+  EXPECT_ERROR_0(compressed_audio_buffer cab(fi), invalid_audio_data);
+}
+
+
+
+TEST_F(test_compressed_audio_buffer, move_constructor)
+{
+  compressed_audio_buffer cab_dummy = load_stereo16_ogg();
+  compressed_audio_buffer cab(std::move(cab_dummy));
+  EXPECT_EQ(audio_buffer_format::stereo16, cab.get_format());
+  EXPECT_EQ(21231u, cab.get_sample_count());
+}
+
+
+
+TEST_F(test_compressed_audio_buffer, create_stream)
+{
+  compressed_audio_buffer cab = load_stereo16_ogg();
+  std::unique_ptr<audio_stream_in> stream = cab.create_stream();
+  ASSERT_NE(nullptr, stream);
+  EXPECT_EQ(cab.get_format(), stream->get_format());
+  EXPECT_EQ(cab.get_sample_rate(), stream->get_sample_rate());
+  EXPECT_EQ(cab.get_sample_count(), stream->get_sample_count());
+  EXPECT_EQ(0, stream->get_sample_pos());
+
+  std::vector<uint8_t> pcm_ref = ogg_file_in(get_stereo16_ogg_filename())
+                                   .read_all<std::vector<uint8_t>>();
+  EXPECT_EQ(pcm_ref, stream->read_all<std::vector<uint8_t>>());
+}
+
+
+
+TEST_F(test_compressed_audio_buffer, streams_have_independent_cursors)
+{
+  compressed_audio_buffer cab = load_stereo16_ogg();
+  std::unique_ptr<audio_stream_in> s1 = cab.create_stream();
+  std::unique_ptr<audio_stream_in> s2 = cab.create_stream();
+
+  std::vector<uint8_t> buffer1(256u);
+  std::vector<uint8_t> buffer2(256u);
+  s1->set_sample_pos(1000);
+  s1->read(buffer1);
+  s2->read(buffer2);
+  EXPECT_EQ(1064, s1->get_sample_pos());
+  EXPECT_EQ(64, s2->get_sample_pos());
+
+  s2->set_sample_pos(1000);
+  s2->read(buffer2);
+  EXPECT_EQ(buffer1, buffer2);
+}
+
+
+
+TEST_F(test_compressed_audio_buffer, stream_outlives_buffer)
+{
+  std::unique_ptr<audio_stream_in> stream;
+  {
+    compressed_audio_buffer cab = load_stereo16_ogg();
+    stream = cab.create_stream();
+  }
+  std::vector<uint8_t> pcm_ref = ogg_file_in(get_stereo16_ogg_filename())
+                                   .read_all<std::vector<uint8_t>>();
+  EXPECT_EQ(pcm_ref, stream->read_all<std::vector<uint8_t>>());
+}
+
+
+
+TEST_F(test_compressed_audio_buffer, shared_by_sources)
+{
+  compressed_audio_buffer cab = load_stereo16_ogg();
+  manual_stream_audio_source as1(cab.create_stream());
+  manual_stream_audio_source as2(cab.create_stream());
+  as2.set_sample_pos(1000u);
+  as1.play();
+  as2.play();
+  as1.update();
+  as2.update();
+  EXPECT_TRUE(as1.is_playing());
+  EXPECT_TRUE(as2.is_playing());
+  EXPECT_NE(as1.get_stream(), as2.get_stream());
+}
@@ -11,6 +11,7 @@
 #include "hou/aud/ogg_file_in.hpp"
 #include "hou/aud/wav_file_in.hpp"
 
+#include <chrono>
 #include <thread>
 
 using namespace hou;
@@ -66,6 +67,41 @@ TEST_F(test_manual_stream_audio_source, slow_buffer_queueing)
 
 
 
+TEST_F(test_manual_stream_audio_source, underrun)
+{
+  manual_stream_audio_source as;
+  as.set_buffer_count(3u);
+  as.set_buffer_sample_count(4u);
+  as.set_stream(std::make_unique<wav_file_in>(get_stereo16_wav_filename()));
+  EXPECT_EQ(0u, as.get_underrun_count());
+  EXPECT_EQ(
+    std::chrono::steady_clock::time_point(), as.get_last_underrun_time());
+
+  as.play();
+  // Sleep a short time to make sure the buffer queue has run empty.
+  std::this_thread::sleep_for(std::chrono::milliseconds(20u));
+  auto time_before_update = std::chrono::steady_clock::now();
+  as.update();
+  auto time_after_update = std::chrono::steady_clock::now();
+  EXPECT_EQ(1u, as.get_underrun_count());
+  EXPECT_LE(time_before_update, as.get_last_underrun_time());
+  EXPECT_GE(time_after_update, as.get_last_underrun_time());
+  EXPECT_TRUE(as.is_playing());
+}
+
+
+
+TEST_F(test_manual_stream_audio_source, no_underrun_before_play)
+{
+  manual_stream_audio_source as(
+    std::make_unique<ogg_file_in>(get_stereo16_ogg_filename()));
+  as.update();
+  EXPECT_EQ(0u, as.get_underrun_count());
+  EXPECT_FALSE(as.is_playing());
+}
+
+
+
 TEST_F(test_manual_stream_audio_source, streaming_end)
 {
   manual_stream_audio_source as(
@@ -77,6 +113,7 @@ TEST_F(test_manual_stream_audio_source, streaming_end)
   }
   EXPECT_FALSE(as.is_playing());
   EXPECT_EQ(0, as.get_sample_pos());
+  EXPECT_EQ(0u, as.get_underrun_count());
 }
 
 }  // namespace
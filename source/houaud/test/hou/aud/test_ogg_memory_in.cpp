@@ -0,0 +1,174 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/test.hpp"
+#include "hou/aud/test_data.hpp"
+
+#include "hou/aud/aud_exceptions.hpp"
+#include "hou/aud/ogg_file_in.hpp"
+#include "hou/aud/ogg_memory_in.hpp"
+
+#include "hou/sys/binary_file_in.hpp"
+#include "hou/sys/sys_exceptions.hpp"
+
+#include <vector>
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_ogg_memory_in : public Test
+{
+public:
+  static const std::string mono16_filename;
+  static const std::string stereo16_filename;
+  static const std::string wav_filename;
+};
+
+
+
+class test_ogg_memory_in_death_test : public test_ogg_memory_in
+{};
+
+
+
+const std::string test_ogg_memory_in::mono16_filename
+  = get_data_dir() + u8"TestOgg-mono-16-44100.ogg";
+const std::string test_ogg_memory_in::stereo16_filename
+  = get_data_dir() + u8"TestOgg-stereo-16-44100.ogg";
+const std::string test_ogg_memory_in::wav_filename
+  = get_data_dir() + u8"TestWav-mono-16-44100.wav";
+
+}  // namespace
+
+
+
+TEST_F(test_ogg_memory_in, data_constructor)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(mono16_filename).read_all<std::vector<uint8_t>>();
+  ogg_memory_in mi(data);
+  EXPECT_FALSE(mi.eof());
+  EXPECT_FALSE(mi.error());
+  EXPECT_EQ(42462u, mi.get_byte_count());
+  EXPECT_EQ(0u, mi.get_read_byte_count());
+  EXPECT_EQ(0u, mi.get_read_element_count());
+  EXPECT_EQ(0, mi.get_byte_pos());
+  EXPECT_EQ(audio_buffer_format::mono16, mi.get_format());
+  EXPECT_EQ(1u, mi.get_channel_count());
+  EXPECT_EQ(2u, mi.get_bytes_per_sample());
+  EXPECT_EQ(44100u, mi.get_sample_rate());
+  EXPECT_EQ(21231u, mi.get_sample_count());
+  EXPECT_EQ(0, mi.get_sample_pos());
+}
+
+
+
+TEST_F(test_ogg_memory_in_death_test, data_constructor_failure_invalid_data)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(wav_filename).read_all<std::vector<uint8_t>>();
+  EXPECT_ERROR_0(ogg_memory_in mi(data), invalid_audio_data);
+}
+
+
+
+TEST_F(test_ogg_memory_in_death_test, data_constructor_failure_no_data)
+{
+  std::vector<uint8_t> data;
+  EXPECT_ERROR_0(ogg_memory_in mi(data), invalid_audio_data);
+}
+
+
+
+TEST_F(test_ogg_memory_in, shared_data_constructor)
+{
+  auto data = std::make_shared<const std::vector<uint8_t>>(
+    binary_file_in(mono16_filename).read_all<std::vector<uint8_t>>());
+  ogg_memory_in mi(data);
+  EXPECT_EQ(2, data.use_count());
+  EXPECT_EQ(audio_buffer_format::mono16, mi.get_format());
+  EXPECT_EQ(44100u, mi.get_sample_rate());
+  EXPECT_EQ(21231u, mi.get_sample_count());
+}
+
+
+
+TEST_F(test_ogg_memory_in_death_test, shared_data_constructor_failure_null_data)
+{
+  EXPECT_PRECOND_ERROR(
+    ogg_memory_in mi(std::shared_ptr<const std::vector<uint8_t>>(nullptr)));
+}
+
+
+
+TEST_F(test_ogg_memory_in, move_constructor)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(stereo16_filename).read_all<std::vector<uint8_t>>();
+  ogg_memory_in mi_dummy(data);
+  ogg_memory_in mi(std::move(mi_dummy));
+  EXPECT_EQ(audio_buffer_format::stereo16, mi.get_format());
+  EXPECT_EQ(21231u, mi.get_sample_count());
+
+  // The moved object must keep decoding from the same data.
+  std::vector<uint8_t> pcm_ref
+    = ogg_file_in(stereo16_filename).read_all<std::vector<uint8_t>>();
+  EXPECT_EQ(pcm_ref, mi.read_all<std::vector<uint8_t>>());
+}
+
+
+
+TEST_F(test_ogg_memory_in, read_all)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(stereo16_filename).read_all<std::vector<uint8_t>>();
+  ogg_memory_in mi(data);
+  std::vector<uint8_t> pcm_ref
+    = ogg_file_in(stereo16_filename).read_all<std::vector<uint8_t>>();
+  EXPECT_EQ(pcm_ref, mi.read_all<std::vector<uint8_t>>());
+}
+
+
+
+TEST_F(test_ogg_memory_in, read_after_set_sample_pos)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(mono16_filename).read_all<std::vector<uint8_t>>();
+  ogg_memory_in mi(data);
+  ogg_file_in fi(mono16_filename);
+
+  std::vector<uint8_t> buffer(64u);
+  std::vector<uint8_t> buffer_ref(64u);
+  mi.set_sample_pos(10000);
+  fi.set_sample_pos(10000);
+  mi.read(buffer);
+  fi.read(buffer_ref);
+  EXPECT_EQ(buffer_ref, buffer);
+  EXPECT_EQ(10032, mi.get_sample_pos());
+
+  mi.set_sample_pos(0);
+  fi.set_sample_pos(0);
+  mi.read(buffer);
+  fi.read(buffer_ref);
+  EXPECT_EQ(buffer_ref, buffer);
+  EXPECT_EQ(32, mi.get_sample_pos());
+}
+
+
+
+TEST_F(test_ogg_memory_in_death_test, set_sample_pos_error_invalid_position)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(mono16_filename).read_all<std::vector<uint8_t>>();
+  ogg_memory_in mi(data);
+  EXPECT_ERROR_0(mi.set_sample_pos(-1), cursor_error);
+  EXPECT_ERROR_0(mi.set_sample_pos(static_cast<ogg_memory_in::sample_position>(
+                   mi.get_sample_count() + 1)),
+    cursor_error);
+}
@@ -0,0 +1,123 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/test.hpp"
+#include "hou/aud/test_data.hpp"
+
+#include "hou/aud/aud_exceptions.hpp"
+#include "hou/aud/ogg_file_in.hpp"
+#include "hou/aud/ogg_stream_in.hpp"
+
+#include "hou/sys/binary_file_in.hpp"
+
+#include <vector>
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_ogg_stream_in : public Test
+{
+public:
+  static const std::string mono16_filename;
+  static const std::string stereo16_filename;
+  static const std::string wav_filename;
+};
+
+
+
+class test_ogg_stream_in_death_test : public test_ogg_stream_in
+{};
+
+
+
+const std::string test_ogg_stream_in::mono16_filename
+  = get_data_dir() + u8"TestOgg-mono-16-44100.ogg";
+const std::string test_ogg_stream_in::stereo16_filename
+  = get_data_dir() + u8"TestOgg-stereo-16-44100.ogg";
+const std::string test_ogg_stream_in::wav_filename
+  = get_data_dir() + u8"TestWav-mono-16-44100.wav";
+
+}  // namespace
+
+
+
+TEST_F(test_ogg_stream_in, stream_constructor)
+{
+  ogg_stream_in si(std::make_unique<binary_file_in>(mono16_filename));
+  EXPECT_FALSE(si.eof());
+  EXPECT_FALSE(si.error());
+  EXPECT_EQ(42462u, si.get_byte_count());
+  EXPECT_EQ(0u, si.get_read_byte_count());
+  EXPECT_EQ(0u, si.get_read_element_count());
+  EXPECT_EQ(0, si.get_byte_pos());
+  EXPECT_EQ(audio_buffer_format::mono16, si.get_format());
+  EXPECT_EQ(1u, si.get_channel_count());
+  EXPECT_EQ(2u, si.get_bytes_per_sample());
+  EXPECT_EQ(44100u, si.get_sample_rate());
+  EXPECT_EQ(21231u, si.get_sample_count());
+  EXPECT_EQ(0, si.get_sample_pos());
+}
+
+
+
+TEST_F(test_ogg_stream_in_death_test, stream_constructor_failure_null_stream)
+{
+  EXPECT_PRECOND_ERROR(ogg_stream_in si(nullptr));
+}
+
+
+
+TEST_F(test_ogg_stream_in_death_test, stream_constructor_failure_invalid_data)
+{
+  EXPECT_ERROR_0(
+    ogg_stream_in si(std::make_unique<binary_file_in>(wav_filename)),
+    invalid_audio_data);
+}
+
+
+
+TEST_F(test_ogg_stream_in, move_constructor)
+{
+  ogg_stream_in si_dummy(std::make_unique<binary_file_in>(stereo16_filename));
+  ogg_stream_in si(std::move(si_dummy));
+  EXPECT_EQ(audio_buffer_format::stereo16, si.get_format());
+  EXPECT_EQ(21231u, si.get_sample_count());
+
+  // The moved object must keep decoding from the same stream.
+  std::vector<uint8_t> pcm_ref
+    = ogg_file_in(stereo16_filename).read_all<std::vector<uint8_t>>();
+  EXPECT_EQ(pcm_ref, si.read_all<std::vector<uint8_t>>());
+}
+
+
+
+TEST_F(test_ogg_stream_in, read_all)
+{
+  ogg_stream_in si(std::make_unique<binary_file_in>(stereo16_filename));
+  std::vector<uint8_t> pcm_ref
+    = ogg_file_in(stereo16_filename).read_all<std::vector<uint8_t>>();
+  EXPECT_EQ(pcm_ref, si.read_all<std::vector<uint8_t>>());
+}
+
+
+
+TEST_F(test_ogg_stream_in, read_after_set_sample_pos)
+{
+  ogg_stream_in si(std::make_unique<binary_file_in>(mono16_filename));
+  ogg_file_in fi(mono16_filename);
+
+  std::vector<uint8_t> buffer(64u);
+  std::vector<uint8_t> buffer_ref(64u);
+  si.set_sample_pos(10000);
+  fi.set_sample_pos(10000);
+  si.read(buffer);
+  fi.read(buffer_ref);
+  EXPECT_EQ(buffer_ref, buffer);
+  EXPECT_EQ(10032, si.get_sample_pos());
+}
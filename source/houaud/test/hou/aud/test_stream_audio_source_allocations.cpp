@@ -0,0 +1,135 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/test_aud_base.hpp"
+#include "hou/aud/test_data.hpp"
+#include "hou/test.hpp"
+
+#include "hou/aud/listener.hpp"
+#include "hou/aud/manual_stream_audio_source.hpp"
+#include "hou/aud/ogg_file_in.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <thread>
+
+using namespace hou;
+
+
+
+// The global allocation functions are replaced to count the allocations
+// performed by the current thread while counting is enabled.
+namespace
+{
+
+thread_local bool g_counting_allocations = false;
+thread_local size_t g_allocation_count = 0u;
+
+}  // namespace
+
+
+
+void* operator new(std::size_t size)
+{
+  if(g_counting_allocations)
+  {
+    ++g_allocation_count;
+  }
+  void* ptr = std::malloc(size == 0u ? 1u : size);
+  if(ptr == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+
+
+namespace
+{
+
+class test_stream_audio_source_allocations : public test_aud_base
+{
+public:
+  static void SetUpTestCase();
+};
+
+size_t count_update_allocations(
+  manual_stream_audio_source& as, std::chrono::milliseconds duration);
+
+
+
+void test_stream_audio_source_allocations::SetUpTestCase()
+{
+  test_aud_base::SetUpTestCase();
+  listener::set_gain(0.f);
+}
+
+
+
+size_t count_update_allocations(
+  manual_stream_audio_source& as, std::chrono::milliseconds duration)
+{
+  g_allocation_count = 0u;
+  auto end_time = std::chrono::steady_clock::now() + duration;
+  while(std::chrono::steady_clock::now() < end_time)
+  {
+    g_counting_allocations = true;
+    as.update();
+    g_counting_allocations = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  }
+  return g_allocation_count;
+}
+
+}  // namespace
+
+
+
+TEST_F(test_stream_audio_source_allocations, steady_state_streaming)
+{
+  manual_stream_audio_source as(
+    std::make_unique<ogg_file_in>(get_stereo16_ogg_filename()));
+  as.set_buffer_sample_count(512u);
+  as.play();
+  as.update();
+
+  EXPECT_EQ(0u,
+    count_update_allocations(as, std::chrono::milliseconds(150)));
+  EXPECT_TRUE(as.is_playing());
+  EXPECT_LT(0u, as.get_sample_pos());
+}
+
+
+
+TEST_F(test_stream_audio_source_allocations, looping_streaming)
+{
+  manual_stream_audio_source as(
+    std::make_unique<ogg_file_in>(get_stereo16_ogg_filename()));
+  as.set_buffer_sample_count(512u);
+  as.set_looping(true);
+  as.play();
+  as.update();
+
+  // The stream is shorter than the measured interval, so the stream cursor
+  // wraps around at least once.
+  EXPECT_EQ(0u,
+    count_update_allocations(as, std::chrono::milliseconds(600)));
+  EXPECT_TRUE(as.is_playing());
+}
@@ -0,0 +1,317 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/aud/test_aud_base.hpp"
+#include "hou/aud/test_data.hpp"
+#include "hou/test.hpp"
+
+#include "hou/aud/audio_buffer.hpp"
+#include "hou/aud/listener.hpp"
+#include "hou/aud/sound_model.hpp"
+#include "hou/aud/voice_pool.hpp"
+#include "hou/aud/wav_file_in.hpp"
+
+#include <cmath>
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_voice_pool : public test_aud_base
+{
+public:
+  static void SetUpTestCase();
+
+public:
+  test_voice_pool();
+
+public:
+  std::shared_ptr<audio_buffer> m_buffer;
+};
+
+class test_voice_pool_death_test : public test_voice_pool
+{};
+
+
+
+void test_voice_pool::SetUpTestCase()
+{
+  test_aud_base::SetUpTestCase();
+  listener::set_gain(0.f);
+}
+
+
+
+test_voice_pool::test_voice_pool()
+  : test_aud_base()
+  , m_buffer(
+      std::make_shared<audio_buffer>(wav_file_in(get_mono16_wav_filename())))
+{
+  listener::set_position(vec3f::zero());
+  sound_model::set_distance_model(
+    sound_distance_model::inverse_distance_clamped);
+}
+
+}  // namespace
+
+
+
+TEST_F(test_voice_pool, constructor)
+{
+  voice_pool vp(4u);
+  EXPECT_EQ(4u, vp.get_voice_count());
+  EXPECT_EQ(0u, vp.get_sound_count());
+  EXPECT_EQ(0u, vp.get_real_sound_count());
+  EXPECT_EQ(0u, vp.get_virtual_sound_count());
+  EXPECT_EQ(0u, vp.get_voice_bind_count());
+  EXPECT_EQ(0u, vp.get_voice_unbind_count());
+}
+
+
+
+TEST_F(test_voice_pool_death_test, constructor_error_no_voices)
+{
+  EXPECT_PRECOND_ERROR(voice_pool vp(0u));
+}
+
+
+
+TEST_F(test_voice_pool, play)
+{
+  voice_pool vp(2u);
+  voice_pool::sound_id id = vp.play(m_buffer);
+  EXPECT_NE(voice_pool::invalid_sound_id, id);
+  EXPECT_TRUE(vp.is_playing(id));
+  EXPECT_FALSE(vp.is_virtual(id));
+  EXPECT_EQ(1u, vp.get_sound_count());
+  EXPECT_EQ(1u, vp.get_real_sound_count());
+  EXPECT_EQ(1u, vp.get_voice_bind_count());
+}
+
+
+
+TEST_F(test_voice_pool_death_test, play_error_null_buffer)
+{
+  voice_pool vp(2u);
+  EXPECT_PRECOND_ERROR(vp.play(nullptr));
+}
+
+
+
+TEST_F(test_voice_pool, more_sounds_than_voices)
+{
+  voice_pool vp(2u);
+  voice_pool::sound_id id1 = vp.play(m_buffer);
+  voice_pool::sound_id id2 = vp.play(m_buffer);
+  voice_pool::sound_id id3 = vp.play(m_buffer);
+  EXPECT_FALSE(vp.is_virtual(id1));
+  EXPECT_FALSE(vp.is_virtual(id2));
+  EXPECT_TRUE(vp.is_virtual(id3));
+  EXPECT_EQ(3u, vp.get_sound_count());
+  EXPECT_EQ(2u, vp.get_real_sound_count());
+  EXPECT_EQ(1u, vp.get_virtual_sound_count());
+}
+
+
+
+TEST_F(test_voice_pool, priority_ranking)
+{
+  voice_pool vp(2u);
+  voice_pool::sound_id id1 = vp.play(m_buffer, 1.f, true);
+  voice_pool::sound_id id2 = vp.play(m_buffer, 2.f, true);
+  voice_pool::sound_id id3 = vp.play(m_buffer, 3.f, true);
+  EXPECT_TRUE(vp.is_virtual(id3));
+
+  vp.update(std::chrono::nanoseconds(0));
+  EXPECT_TRUE(vp.is_virtual(id1));
+  EXPECT_FALSE(vp.is_virtual(id2));
+  EXPECT_FALSE(vp.is_virtual(id3));
+  EXPECT_FLOAT_EQ(1.f, vp.get_audibility(id1));
+  EXPECT_FLOAT_EQ(2.f, vp.get_audibility(id2));
+  EXPECT_FLOAT_EQ(3.f, vp.get_audibility(id3));
+  EXPECT_EQ(3u, vp.get_voice_bind_count());
+  EXPECT_EQ(1u, vp.get_voice_unbind_count());
+
+  vp.set_priority(id1, 4.f);
+  vp.update(std::chrono::nanoseconds(0));
+  EXPECT_FALSE(vp.is_virtual(id1));
+  EXPECT_TRUE(vp.is_virtual(id2));
+  EXPECT_FALSE(vp.is_virtual(id3));
+  EXPECT_EQ(4u, vp.get_voice_bind_count());
+  EXPECT_EQ(2u, vp.get_voice_unbind_count());
+}
+
+
+
+TEST_F(test_voice_pool, distance_ranking)
+{
+  voice_pool vp(1u);
+  voice_pool::sound_id id1 = vp.play(m_buffer, 1.f, true);
+  voice_pool::sound_id id2 = vp.play(m_buffer, 1.f, true);
+  vp.set_position(id1, vec3f(4.f, 0.f, 0.f));
+  vp.set_position(id2, vec3f(0.f, 2.f, 0.f));
+  EXPECT_EQ(vec3f(4.f, 0.f, 0.f), vp.get_position(id1));
+
+  vp.update(std::chrono::nanoseconds(0));
+  EXPECT_TRUE(vp.is_virtual(id1));
+  EXPECT_FALSE(vp.is_virtual(id2));
+  EXPECT_FLOAT_EQ(0.25f, vp.get_audibility(id1));
+  EXPECT_FLOAT_EQ(0.5f, vp.get_audibility(id2));
+
+  listener::set_position(vec3f(4.f, 1.f, 0.f));
+  vp.update(std::chrono::nanoseconds(0));
+  EXPECT_FALSE(vp.is_virtual(id1));
+  EXPECT_TRUE(vp.is_virtual(id2));
+  EXPECT_FLOAT_EQ(1.f, vp.get_audibility(id1));
+}
+
+
+
+TEST_F(test_voice_pool, sound_at_listener_position)
+{
+  sound_model::set_distance_model(sound_distance_model::inverse_distance);
+  voice_pool vp(1u);
+  voice_pool::sound_id id1 = vp.play(m_buffer, 1.f, true);
+  voice_pool::sound_id id2 = vp.play(m_buffer, 0.f, true);
+  voice_pool::sound_id id3 = vp.play(m_buffer, 0.5f, true);
+  vp.set_position(id3, vec3f(2.f, 0.f, 0.f));
+
+  vp.update(std::chrono::nanoseconds(0));
+  EXPECT_TRUE(std::isfinite(vp.get_audibility(id1)));
+  EXPECT_LT(1.f, vp.get_audibility(id1));
+  EXPECT_FLOAT_EQ(0.f, vp.get_audibility(id2));
+  EXPECT_FLOAT_EQ(0.25f, vp.get_audibility(id3));
+  EXPECT_FALSE(vp.is_virtual(id1));
+  EXPECT_TRUE(vp.is_virtual(id2));
+  EXPECT_TRUE(vp.is_virtual(id3));
+}
+
+
+
+TEST_F(test_voice_pool, gain_ranking)
+{
+  voice_pool vp(1u);
+  voice_pool::sound_id id1 = vp.play(m_buffer, 1.f, true);
+  voice_pool::sound_id id2 = vp.play(m_buffer, 1.f, true);
+  vp.set_gain(id1, 0.5f);
+  EXPECT_FLOAT_EQ(0.5f, vp.get_gain(id1));
+
+  vp.update(std::chrono::nanoseconds(0));
+  EXPECT_TRUE(vp.is_virtual(id1));
+  EXPECT_FALSE(vp.is_virtual(id2));
+}
+
+
+
+TEST_F(test_voice_pool, inaudible_sounds_are_virtual)
+{
+  voice_pool vp(2u);
+  voice_pool::sound_id id = vp.play(m_buffer, 1.f, true);
+  vp.set_priority(id, 0.f);
+  vp.update(std::chrono::nanoseconds(0));
+  EXPECT_TRUE(vp.is_playing(id));
+  EXPECT_TRUE(vp.is_virtual(id));
+  EXPECT_EQ(0u, vp.get_real_sound_count());
+}
+
+
+
+TEST_F(test_voice_pool, virtual_time_advance)
+{
+  voice_pool vp(1u);
+  vp.play(m_buffer, 2.f, true);
+  voice_pool::sound_id id = vp.play(m_buffer, 1.f, true);
+  ASSERT_TRUE(vp.is_virtual(id));
+  EXPECT_EQ(std::chrono::nanoseconds(0), vp.get_time_pos(id));
+
+  vp.update(std::chrono::milliseconds(100));
+  EXPECT_TRUE(vp.is_virtual(id));
+  EXPECT_EQ(std::chrono::milliseconds(100), vp.get_time_pos(id));
+
+  // The sound duration is 21103 / 44100 seconds, about 478 ms.
+  vp.update(std::chrono::milliseconds(400));
+  EXPECT_TRUE(vp.is_playing(id));
+  EXPECT_GT(std::chrono::milliseconds(100), vp.get_time_pos(id));
+}
+
+
+
+TEST_F(test_voice_pool, virtual_sound_end)
+{
+  voice_pool vp(1u);
+  vp.play(m_buffer, 2.f, true);
+  voice_pool::sound_id id = vp.play(m_buffer, 1.f, false);
+  ASSERT_TRUE(vp.is_virtual(id));
+
+  vp.update(std::chrono::milliseconds(400));
+  EXPECT_TRUE(vp.is_playing(id));
+  vp.update(std::chrono::milliseconds(400));
+  EXPECT_FALSE(vp.is_playing(id));
+  EXPECT_EQ(1u, vp.get_sound_count());
+}
+
+
+
+TEST_F(test_voice_pool, promoted_sound_resumes_from_virtual_position)
+{
+  voice_pool vp(1u);
+  voice_pool::sound_id id1 = vp.play(m_buffer, 2.f, true);
+  voice_pool::sound_id id2 = vp.play(m_buffer, 1.f, true);
+  vp.update(std::chrono::milliseconds(200));
+  vp.stop(id1);
+  vp.update(std::chrono::nanoseconds(0));
+  ASSERT_FALSE(vp.is_virtual(id2));
+  EXPECT_LE(std::chrono::milliseconds(190), vp.get_time_pos(id2));
+}
+
+
+
+TEST_F(test_voice_pool, stop)
+{
+  voice_pool vp(1u);
+  voice_pool::sound_id id1 = vp.play(m_buffer);
+  voice_pool::sound_id id2 = vp.play(m_buffer);
+  vp.stop(id1);
+  EXPECT_FALSE(vp.is_playing(id1));
+  EXPECT_EQ(1u, vp.get_sound_count());
+  EXPECT_EQ(0u, vp.get_real_sound_count());
+  EXPECT_EQ(1u, vp.get_voice_unbind_count());
+
+  vp.stop(id1);
+  EXPECT_EQ(1u, vp.get_sound_count());
+
+  vp.update(std::chrono::nanoseconds(0));
+  EXPECT_FALSE(vp.is_virtual(id2));
+  EXPECT_EQ(2u, vp.get_voice_bind_count());
+}
+
+
+
+TEST_F(test_voice_pool, clear)
+{
+  voice_pool vp(2u);
+  vp.play(m_buffer);
+  vp.play(m_buffer);
+  vp.play(m_buffer);
+  vp.clear();
+  EXPECT_EQ(0u, vp.get_sound_count());
+  EXPECT_EQ(0u, vp.get_real_sound_count());
+  EXPECT_EQ(2u, vp.get_voice_bind_count());
+  EXPECT_EQ(2u, vp.get_voice_unbind_count());
+}
+
+
+
+TEST_F(test_voice_pool_death_test, invalid_sound_id)
+{
+  voice_pool vp(1u);
+  EXPECT_FALSE(vp.is_playing(voice_pool::invalid_sound_id));
+  EXPECT_PRECOND_ERROR(vp.is_virtual(voice_pool::invalid_sound_id));
+  EXPECT_PRECOND_ERROR(vp.get_time_pos(voice_pool::invalid_sound_id));
+  EXPECT_PRECOND_ERROR(vp.set_gain(voice_pool::invalid_sound_id, 1.f));
+}
@@ -0,0 +1,201 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_GFX_DYNAMIC_MESH_HPP
+#define HOU_GFX_DYNAMIC_MESH_HPP
+
+#include "hou/gfx/mesh.hpp"
+
+#include "hou/gfx/gfx_config.hpp"
+
+#include "hou/cor/span.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+
+
+namespace hou
+{
+
+/** Represents a mesh whose vertices can be modified after creation.
+ *
+ * The vertices are stored in a dynamic vertex buffer, so that they can be
+ * updated in place, fully or partially, without creating a new mesh.
+ * The vertex buffer has a capacity which can be greater than the number of
+ * vertices in the mesh. When more vertices than the capacity are set, the
+ * capacity grows geometrically. It never shrinks, so that a mesh whose number
+ * of vertices varies from frame to frame does not cause a reallocation every
+ * frame.
+ *
+ * \tparam T the type of vertex stored by the mesh.
+ */
+template <typename T>
+class dynamic_mesh_t : public mesh
+{
+public:
+  /** Type of the vertices stored in the mesh. */
+  using vertex_type = T;
+
+  /** Type used to represent the collection of vertices stored in the mesh. */
+  using vertex_collection = std::vector<T>;
+
+public:
+  /** Creates a mesh with the given mesh_draw_mode, mesh_fill_mode, and
+   * vertices.
+   *
+   * The capacity of the mesh is equal to the number of vertices.
+   *
+   * \param dm the mesh_draw_mode.
+   *
+   * \param fm the mesh_fill_mode.
+   *
+   * \param vertices the vertices.
+   */
+  dynamic_mesh_t(
+    mesh_draw_mode dm, mesh_fill_mode fm, const span<const T>& vertices);
+
+  /** Creates an indexed mesh with the given mesh_draw_mode, mesh_fill_mode,
+   * vertices, and 16 bit indices.
+   *
+   * Throws if an index is not lower than the number of vertices.
+   *
+   * The indices cannot be modified after creation.
+   *
+   * \param dm the mesh_draw_mode.
+   *
+   * \param fm the mesh_fill_mode.
+   *
+   * \param vertices the vertices.
+   *
+   * \param indices the indices.
+   */
+  dynamic_mesh_t(mesh_draw_mode dm, mesh_fill_mode fm,
+    const span<const T>& vertices, const span<const uint16_t>& indices);
+
+  /** Creates an indexed mesh with the given mesh_draw_mode, mesh_fill_mode,
+   * vertices, and 32 bit indices.
+   *
+   * Throws if an index is not lower than the number of vertices.
+   *
+   * The indices cannot be modified after creation.
+   *
+   * \param dm the mesh_draw_mode.
+   *
+   * \param fm the mesh_fill_mode.
+   *
+   * \param vertices the vertices.
+   *
+   * \param indices the indices.
+   */
+  dynamic_mesh_t(mesh_draw_mode dm, mesh_fill_mode fm,
+    const span<const T>& vertices, const span<const uint32_t>& indices);
+
+  /** Gets the vertices in the mesh inside a vector.
+   *
+   * \return a vector containing the vertices of the mesh.
+   */
+  vertex_collection get_vertices() const;
+
+  /** Replaces all the vertices in the mesh.
+   *
+   * The number of vertices in the mesh becomes the size of vertices, and the
+   * draw range is reset.
+   * If the capacity is not sufficient, the vertex buffer is recreated with at
+   * least twice the previous capacity.
+   * Throws if the mesh is indexed and the indices reference vertices beyond
+   * the size of vertices.
+   *
+   * \param vertices the vertices.
+   */
+  void set_vertices(const span<const T>& vertices);
+
+  /** Replaces a sub-set of the vertices in the mesh.
+   *
+   * No reallocation is performed.
+   * Throws if offset plus the size of vertices is greater than the number of
+   * vertices in the mesh.
+   *
+   * \param offset the index of the first vertex to be replaced.
+   *
+   * \param vertices the vertices.
+   */
+  void set_sub_vertices(size_t offset, const span<const T>& vertices);
+
+  /** Gets the number of vertices the mesh can hold without reallocating its
+   * vertex buffer.
+   *
+   * \return the capacity of the mesh.
+   */
+  size_t get_vertex_capacity() const noexcept;
+
+  /** Gets the vertex buffer storing the vertices of the mesh.
+   *
+   * The vertex buffer is replaced when the capacity grows.
+   *
+   * \return the vertex buffer storing the vertices of the mesh.
+   */
+  const dynamic_vertex_buffer<T>& get_vertex_buffer() const noexcept;
+
+private:
+  void reserve(size_t vertex_count);
+
+private:
+  std::unique_ptr<dynamic_vertex_buffer<T>> m_vbo;
+};
+
+/** Checks if two dynamic_mesh_t objects are equal.
+ *
+ * \param lhs the left operand.
+ *
+ * \param rhs the right operand.
+ *
+ * \return true if the two objects are equal.
+ */
+template <typename T>
+bool operator==(const dynamic_mesh_t<T>& lhs, const dynamic_mesh_t<T>& rhs);
+
+/** Checks if two dynamic_mesh_t objects are not equal.
+ *
+ * \param lhs the left operand.
+ *
+ * \param rhs the right operand.
+ *
+ * \return true if the two objects are not equal.
+ */
+template <typename T>
+bool operator!=(const dynamic_mesh_t<T>& lhs, const dynamic_mesh_t<T>& rhs);
+
+/** Checks if two dynamic_mesh_t objects are equal with the specified accuracy.
+ *
+ * \param lhs the left operand.
+ *
+ * \param rhs the right operand.
+ *
+ * \param acc the accuracy.
+ *
+ * \return true if the two objects are equal.
+ */
+template <typename T>
+bool close(const dynamic_mesh_t<T>& lhs, const dynamic_mesh_t<T>& rhs,
+  float acc = std::numeric_limits<float>::epsilon());
+
+/** Writes the object into a stream.
+ *
+ * \param os the stream.
+ *
+ * \param m the dynamic_mesh_t.
+ *
+ * \return a reference to os.
+ */
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const dynamic_mesh_t<T>& m);
+
+}  // namespace hou
+
+#include "hou/gfx/dynamic_mesh.inl"
+
+#endif
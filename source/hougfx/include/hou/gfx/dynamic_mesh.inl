@@ -0,0 +1,153 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+namespace hou
+{
+
+template <typename T>
+dynamic_mesh_t<T>::dynamic_mesh_t(
+  mesh_draw_mode dm, mesh_fill_mode fm, const span<const T>& vertices)
+  : mesh(dm, fm, 0u)
+  , m_vbo(nullptr)
+{
+  set_vertices(vertices);
+}
+
+
+
+template <typename T>
+dynamic_mesh_t<T>::dynamic_mesh_t(mesh_draw_mode dm, mesh_fill_mode fm,
+  const span<const T>& vertices, const span<const uint16_t>& indices)
+  : dynamic_mesh_t(dm, fm, vertices)
+{
+  set_index_data(indices);
+  HOU_PRECOND(get_referenced_vertex_count() <= get_vertex_count());
+}
+
+
+
+template <typename T>
+dynamic_mesh_t<T>::dynamic_mesh_t(mesh_draw_mode dm, mesh_fill_mode fm,
+  const span<const T>& vertices, const span<const uint32_t>& indices)
+  : dynamic_mesh_t(dm, fm, vertices)
+{
+  set_index_data(indices);
+  HOU_PRECOND(get_referenced_vertex_count() <= get_vertex_count());
+}
+
+
+
+template <typename T>
+typename dynamic_mesh_t<T>::vertex_collection
+  dynamic_mesh_t<T>::get_vertices() const
+{
+  return m_vbo->get_sub_data(0u, get_vertex_count());
+}
+
+
+
+template <typename T>
+void dynamic_mesh_t<T>::set_vertices(const span<const T>& vertices)
+{
+  HOU_PRECOND(vertices.size() >= get_referenced_vertex_count());
+  reserve(vertices.size());
+  m_vbo->set_sub_data(0u, vertices);
+  set_vertex_count(vertices.size());
+}
+
+
+
+template <typename T>
+void dynamic_mesh_t<T>::set_sub_vertices(
+  size_t offset, const span<const T>& vertices)
+{
+  HOU_PRECOND(offset + vertices.size() <= get_vertex_count());
+  m_vbo->set_sub_data(offset, vertices);
+}
+
+
+
+template <typename T>
+size_t dynamic_mesh_t<T>::get_vertex_capacity() const noexcept
+{
+  return m_vbo->get_size();
+}
+
+
+
+template <typename T>
+const dynamic_vertex_buffer<T>& dynamic_mesh_t<T>::get_vertex_buffer() const
+  noexcept
+{
+  return *m_vbo;
+}
+
+
+
+template <typename T>
+void dynamic_mesh_t<T>::reserve(size_t vertex_count)
+{
+  if(m_vbo != nullptr && m_vbo->get_size() >= vertex_count)
+  {
+    return;
+  }
+  // Empty vertex buffers are not allowed, so at least one vertex is reserved.
+  size_t new_size = m_vbo == nullptr
+    ? std::max<size_t>(1u, vertex_count)
+    : std::max(vertex_count, 2u * m_vbo->get_size());
+  m_vbo = std::make_unique<dynamic_vertex_buffer<T>>(new_size);
+  m_vao.set_vertex_data(*m_vbo, 0u, T::get_vertex_format());
+}
+
+
+
+template <typename T>
+bool operator==(const dynamic_mesh_t<T>& lhs, const dynamic_mesh_t<T>& rhs)
+{
+  return lhs.get_vertex_count() == rhs.get_vertex_count()
+    && lhs.get_index_count() == rhs.get_index_count()
+    && lhs.get_draw_mode() == rhs.get_draw_mode()
+    && lhs.get_fill_mode() == rhs.get_fill_mode()
+    && lhs.get_vertices() == rhs.get_vertices()
+    && lhs.get_indices() == rhs.get_indices();
+}
+
+
+
+template <typename T>
+bool operator!=(const dynamic_mesh_t<T>& lhs, const dynamic_mesh_t<T>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+
+
+template <typename T>
+bool close(
+  const dynamic_mesh_t<T>& lhs, const dynamic_mesh_t<T>& rhs, float acc)
+{
+  return lhs.get_vertex_count() == rhs.get_vertex_count()
+    && lhs.get_index_count() == rhs.get_index_count()
+    && lhs.get_draw_mode() == rhs.get_draw_mode()
+    && lhs.get_fill_mode() == rhs.get_fill_mode()
+    && close(lhs.get_vertices(), rhs.get_vertices(), acc)
+    && lhs.get_indices() == rhs.get_indices();
+}
+
+
+
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const dynamic_mesh_t<T>& m)
+{
+  os << "{draw_mode = " << m.get_draw_mode()
+     << ", fill_mode = " << m.get_fill_mode()
+     << ", vertices = " << m.get_vertices();
+  if(m.is_indexed())
+  {
+    os << ", indices = " << m.get_indices();
+  }
+  return os << "}";
+}
+
+}  // namespace hou
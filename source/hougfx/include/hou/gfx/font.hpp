@@ -11,6 +11,7 @@
 
 #include "hou/cor/character_encodings.hpp"
 #include "hou/cor/span.hpp"
+#include "hou/cor/uid_generator.hpp"
 
 #include "hou/mth/matrix_fwd.hpp"
 #include "hou/mth/rectangle_fwd.hpp"
@@ -43,6 +44,9 @@ public:
   /** Underlying data type. */
   using data_type = std::vector<uint8_t>;
 
+  /** Unique identifier type. */
+  using uid_type = uid_generator::uid_type;
+
 public:
   /** Creates a font object from the given font raw data.
    *
@@ -102,6 +106,15 @@ public:
    */
   ~font();
 
+  /** Gets the unique identifier of the font.
+   *
+   * The identifier can be used to tell apart glyphs generated by different
+   * font objects, for example when caching them.
+   *
+   * \return the unique identifier of the font.
+   */
+  uid_type get_uid() const noexcept;
+
   /** Gets the number of available font faces.
    *
    * \return the number of available font faces.
@@ -277,6 +290,7 @@ private:
   void destroy();
 
 private:
+  uid_type m_uid;
   FT_Face m_face;
   uint m_face_index;
   uint m_pixel_height;
@@ -15,6 +15,7 @@
 #include "hou/mth/rectangle.hpp"
 #include "hou/mth/transform2.hpp"
 
+#include "hou/gfx/glyph_atlas.hpp"
 #include "hou/gfx/mesh.hpp"
 #include "hou/gfx/text_box_formatting_params.hpp"
 #include "hou/gfx/text_mesh.hpp"
@@ -34,7 +35,11 @@ class font;
 /** Formatted, renderable text.
  *
  * The text will be formatted according to the given parameters.
- * The object stores a mesh and a texture atlas for quick rendering.
+ * The object stores a mesh and references a texture atlas for quick
+ * rendering.
+ * The atlas can either be owned by the formatted_text object or be a
+ * glyph_atlas shared by many formatted_text objects. In the latter case the
+ * glyph_atlas must outlive the formatted_text.
  */
 class HOU_GFX_API formatted_text : public non_copyable
 {
@@ -42,6 +47,9 @@ public:
   /** Type representing a collection of mesh vertices. */
   using VertexContainer = std::vector<text_vertex>;
 
+  /** Type representing a collection of mesh indices. */
+  using IndexContainer = std::vector<uint32_t>;
+
 public:
   /** Create a formatted_text with the given utf-8 string and formatting
    * parameters.
@@ -65,18 +73,73 @@ public:
     const text_box_formatting_params& tbfp
     = text_box_formatting_params::standard);
 
+  /** Create a formatted_text with the given utf-8 string and formatting
+   * parameters, using a shared glyph atlas.
+   *
+   * Glyphs missing from the atlas are rasterized and added to it.
+   *
+   * \param text the text.
+   * \param f the font.
+   * \param atlas the glyph atlas.
+   * \param tbfp the text box formatting parameters.
+   *
+   * \throws hou::overflow_error if there is no space left in the atlas.
+   */
+  formatted_text(const std::string& text, const font& f, glyph_atlas& atlas,
+    const text_box_formatting_params& tbfp
+    = text_box_formatting_params::standard);
+
+  /** Create a formatted_text with the given utf-32 string and formatting
+   * parameters, using a shared glyph atlas.
+   *
+   * Glyphs missing from the atlas are rasterized and added to it.
+   *
+   * \param text the text.
+   * \param f the font.
+   * \param atlas the glyph atlas.
+   * \param tbfp the text box formatting parameters.
+   *
+   * \throws hou::overflow_error if there is no space left in the atlas.
+   */
+  formatted_text(std::u32string text, const font& f, glyph_atlas& atlas,
+    const text_box_formatting_params& tbfp
+    = text_box_formatting_params::standard);
+
   /** Retrieves the texture atlas.
    *
    * \return the texture atlas.
    */
   const texture2_array& get_atlas() const;
 
+  /** Retrieves the glyph atlas.
+   *
+   * \return the glyph atlas.
+   */
+  const glyph_atlas& get_glyph_atlas() const;
+
   /** Retrieves the text mesh.
    *
    * \return the text mesh.
    */
   const text_mesh& get_mesh() const;
 
+  /** Retrieves a copy of the text mesh vertices stored in main memory.
+   *
+   * The vertices can be used to build batches of text without reading the
+   * mesh data back from the VRAM.
+   *
+   * \return the text mesh vertices.
+   */
+  const VertexContainer& get_vertices() const;
+
+  /** Retrieves a copy of the text mesh indices stored in main memory.
+   *
+   * Each glyph is rendered as two triangles referencing four vertices.
+   *
+   * \return the text mesh indices.
+   */
+  const IndexContainer& get_indices() const;
+
   /** Retrieves the text bounding box.
    *
    * \return the text bounding box.
@@ -84,8 +147,15 @@ public:
   const rectf& get_bounding_box() const;
 
 private:
-  std::unique_ptr<texture2_array> m_atlas;
+  void format(std::u32string text, const font& f, glyph_atlas& atlas,
+    const text_box_formatting_params& tbfp);
+
+private:
+  std::unique_ptr<glyph_atlas> m_owned_atlas;
+  const glyph_atlas* m_atlas;
   std::unique_ptr<text_mesh> m_mesh;
+  VertexContainer m_vertices;
+  IndexContainer m_indices;
   rectf m_bounding_box;
 };
 
@@ -0,0 +1,212 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_GFX_GLYPH_ATLAS_HPP
+#define HOU_GFX_GLYPH_ATLAS_HPP
+
+#include "hou/gfx/gfx_config.hpp"
+
+#include "hou/cor/non_copyable.hpp"
+
+#include "hou/cor/character_encodings.hpp"
+#include "hou/cor/span.hpp"
+
+#include "hou/gfx/font.hpp"
+#include "hou/gfx/glyph_metrics.hpp"
+#include "hou/gfx/texture2_array.hpp"
+
+#include "hou/mth/matrix.hpp"
+
+#include <map>
+#include <tuple>
+
+
+
+namespace hou
+{
+
+class glyph;
+
+/** Long lived texture atlas storing rasterized glyphs.
+ *
+ * Glyphs are identified by the font they were generated from, the face index
+ * and pixel height of the font at generation time, and their code point.
+ * When a glyph is requested for the first time it is rasterized and uploaded
+ * into a free area of the atlas texture.
+ * Subsequent requests for the same glyph reuse the stored data, so that many
+ * formatted_text objects can share the same atlas texture.
+ *
+ * There must be a current context to create a glyph_atlas object.
+ * A glyph_atlas object should be used only if the owning context is current.
+ */
+class HOU_GFX_API glyph_atlas : public non_copyable
+{
+public:
+  /** Information about a glyph stored in the atlas.
+   */
+  class HOU_GFX_API entry
+  {
+  public:
+    /** Creates an entry.
+     *
+     * \param metrics the glyph metrics.
+     *
+     * \param position the position of the glyph image inside the atlas.
+     *
+     * \param size the size of the glyph image.
+     */
+    entry(const glyph_metrics& metrics, const vec3u& position,
+      const vec2u& size) noexcept;
+
+    /** Gets the glyph metrics.
+     *
+     * \return the glyph metrics.
+     */
+    const glyph_metrics& get_metrics() const noexcept;
+
+    /** Gets the position of the glyph image inside the atlas, in texels.
+     *
+     * The third element is the atlas layer.
+     *
+     * \return the position of the glyph image inside the atlas.
+     */
+    const vec3u& get_position() const noexcept;
+
+    /** Gets the size of the glyph image, in texels.
+     *
+     * \return the size of the glyph image.
+     */
+    const vec2u& get_size() const noexcept;
+
+  private:
+    glyph_metrics m_metrics;
+    vec3u m_position;
+    vec2u m_size;
+  };
+
+public:
+  /** Retrieves the default atlas size.
+   *
+   * \return the default atlas size, clamped to the maximum texture size.
+   */
+  static vec3u get_default_size();
+
+  /** Retrieves the gutter between glyphs in the atlas.
+   *
+   * Each glyph is followed by this number of empty texels, both horizontally
+   * and vertically, so that filtering does not sample texels of neighbouring
+   * glyphs.
+   *
+   * \return the gutter size in texels.
+   */
+  static uint get_gutter() noexcept;
+
+public:
+  /** Creates an empty atlas with the given texture size.
+   *
+   * \param size the size of the atlas texture. Each element must be greater
+   * than zero and lower or equal than the corresponding element of
+   * texture2_array::get_max_size().
+   */
+  explicit glyph_atlas(const vec3u& size = get_default_size());
+
+  /** Move constructor.
+   *
+   * \param other the other glyph_atlas.
+   */
+  glyph_atlas(glyph_atlas&& other) noexcept = default;
+
+  /** Gets the atlas texture.
+   *
+   * \return the atlas texture.
+   */
+  const texture2_array& get_texture() const noexcept;
+
+  /** Gets the number of glyphs stored in the atlas.
+   *
+   * \return the number of glyphs stored in the atlas.
+   */
+  size_t get_entry_count() const noexcept;
+
+  /** Checks if a glyph is stored in the atlas.
+   *
+   * The current face index and pixel height of the font are taken into
+   * account.
+   *
+   * \param f the font.
+   *
+   * \param c the code point.
+   *
+   * \return true if the glyph is stored in the atlas.
+   */
+  bool contains(const font& f, utf32::code_unit c) const;
+
+  /** Gets the entry of a glyph, rasterizing it and storing it into the atlas
+   * if it is not already present.
+   *
+   * The current face index and pixel height of the font are taken into
+   * account.
+   *
+   * \param f the font.
+   *
+   * \param c the code point.
+   *
+   * \throws hou::overflow_error if there is no space left in the atlas.
+   *
+   * \return the entry of the glyph.
+   */
+  const entry& get_entry(const font& f, utf32::code_unit c);
+
+  /** Stores the glyphs of all the given characters into the atlas.
+   *
+   * \param f the font.
+   *
+   * \param characters the code points.
+   *
+   * \throws hou::overflow_error if there is no space left in the atlas.
+   */
+  void reserve(const font& f, const span<const utf32::code_unit>& characters);
+
+  /** Stores an already rasterized glyph into the atlas.
+   *
+   * If the glyph is already present, the existing entry is returned and the
+   * atlas is not modified.
+   *
+   * \param f the font the glyph was generated from.
+   *
+   * \param c the code point.
+   *
+   * \param g the glyph, generated with the current face index and pixel
+   * height of f.
+   *
+   * \throws hou::overflow_error if there is no space left in the atlas.
+   *
+   * \return the entry of the glyph.
+   */
+  const entry& insert(const font& f, utf32::code_unit c, const glyph& g);
+
+  /** Removes all glyphs from the atlas.
+   *
+   * Meshes referencing glyphs in the atlas become invalid.
+   */
+  void clear();
+
+private:
+  using key_type = std::tuple<font::uid_type, uint, uint, utf32::code_unit>;
+
+private:
+  static key_type make_key(const font& f, utf32::code_unit c);
+
+  vec3u allocate(const vec2u& size);
+
+private:
+  texture2_array m_texture;
+  std::map<key_type, entry> m_entries;
+  vec3u m_pen;
+  uint m_shelf_height;
+};
+
+}  // namespace hou
+
+#endif
@@ -7,6 +7,7 @@
 
 #include "hou/cor/non_copyable.hpp"
 
+#include "hou/gfx/gl_type.hpp"
 #include "hou/gfx/mesh_draw_mode.hpp"
 #include "hou/gfx/mesh_fill_mode.hpp"
 #include "hou/gfx/vertex_array.hpp"
@@ -17,7 +18,9 @@
 #include "hou/cor/span.hpp"
 #include "hou/cor/std_vector.hpp"
 
+#include <cstdint>
 #include <iostream>
+#include <memory>
 
 
 
@@ -30,7 +33,9 @@ namespace hou
  * There must be a current context to create a mesh object.
  * a mesh object should be used only if the owning context is current.
  *
- * \tparam T the type of vertex stored by the mesh.
+ * A mesh can optionally be indexed. In this case the primitives are assembled
+ * from the vertices referenced by an index buffer, so that vertices shared by
+ * several primitives are stored only once.
  */
 class HOU_GFX_API mesh : public non_copyable
 {
@@ -39,6 +44,8 @@ public:
    *
    * The draw operation automatically binds the mesh to the current
    * graphic_context.
+   * Indexed meshes are drawn with glDrawElements.
+   * Only the elements in the current draw range are drawn.
    *
    * \param m the mesh to be drawn.
    */
@@ -85,6 +92,99 @@ public:
    */
   size_t get_vertex_count() const noexcept;
 
+  /** Checks if the mesh is indexed.
+   *
+   * \return true if the mesh is indexed.
+   */
+  bool is_indexed() const noexcept;
+
+  /** Gets the number of indices in the mesh.
+   *
+   * \return the number of indices in the mesh, or 0 if the mesh is not
+   * indexed.
+   */
+  size_t get_index_count() const noexcept;
+
+  /** Gets the type of the indices in the mesh.
+   *
+   * \return gl_type::unsigned_short_integer or gl_type::unsigned_integer.
+   * The value is meaningless if the mesh is not indexed.
+   */
+  gl_type get_index_type() const noexcept;
+
+  /** Gets the buffer storing the indices of the mesh.
+   *
+   * \return a pointer to the index buffer, or nullptr if the mesh is not
+   * indexed.
+   */
+  const vertex_buffer* get_index_buffer() const noexcept;
+
+  /** Gets the indices in the mesh inside a vector.
+   *
+   * \return a vector containing the indices of the mesh, or an empty vector if
+   * the mesh is not indexed.
+   */
+  std::vector<uint32_t> get_indices() const;
+
+  /** Sets the range of elements drawn by mesh::draw.
+   *
+   * The elements are indices if the mesh is indexed, vertices otherwise.
+   * Throws if first plus count is greater than the number of elements.
+   * By default the whole mesh is drawn.
+   *
+   * \param first the first element to be drawn.
+   *
+   * \param count the number of elements to be drawn.
+   */
+  void set_draw_range(size_t first, size_t count);
+
+  /** Resets the draw range so that the whole mesh is drawn.
+   */
+  void reset_draw_range() noexcept;
+
+  /** Gets the first element in the draw range.
+   *
+   * \return the first element in the draw range.
+   */
+  size_t get_draw_first() const noexcept;
+
+  /** Gets the number of elements in the draw range.
+   *
+   * \return the number of elements in the draw range.
+   */
+  size_t get_draw_count() const noexcept;
+
+protected:
+  /** Sets the number of vertices in the mesh and resets the draw range.
+   *
+   * To be used by derived classes whose vertex count can change.
+   *
+   * \param vertex_count the number of vertices.
+   */
+  void set_vertex_count(size_t vertex_count) noexcept;
+
+  /** Gets the number of vertices referenced by the indices of the mesh.
+   *
+   * This is the greatest index plus one, so that a vertex count smaller than
+   * this value would make the indices reference vertices outside the mesh.
+   *
+   * \return the number of vertices referenced by the indices, or 0 if the mesh
+   * is not indexed.
+   */
+  size_t get_referenced_vertex_count() const noexcept;
+
+  /** Sets the indices of the mesh and binds them to the vertex array object.
+   *
+   * \param indices the indices.
+   */
+  void set_index_data(const span<const uint16_t>& indices);
+
+  /** Sets the indices of the mesh and binds them to the vertex array object.
+   *
+   * \param indices the indices.
+   */
+  void set_index_data(const span<const uint32_t>& indices);
+
 protected:
   /** The vertex array object. */
   vertex_array m_vao;
@@ -93,6 +193,12 @@ private:
   mesh_draw_mode m_draw_mode;
   mesh_fill_mode m_fill_mode;
   size_t m_vertex_count;
+  std::unique_ptr<vertex_buffer> m_ibo;
+  gl_type m_index_type;
+  size_t m_index_count;
+  size_t m_referenced_vertex_count;
+  size_t m_draw_first;
+  size_t m_draw_count;
 };
 
 /** Represents a mesh.
@@ -125,12 +231,50 @@ public:
    */
   mesh_t(mesh_draw_mode dm, mesh_fill_mode fm, const span<const T>& vertices);
 
+  /** Creates an indexed mesh with the given mesh_draw_mode, mesh_fill_mode,
+   * vertices, and 16 bit indices.
+   *
+   * Throws if an index is not lower than the number of vertices.
+   *
+   * \param dm the mesh_draw_mode.
+   *
+   * \param fm the mesh_fill_mode.
+   *
+   * \param vertices the vertices.
+   *
+   * \param indices the indices.
+   */
+  mesh_t(mesh_draw_mode dm, mesh_fill_mode fm, const span<const T>& vertices,
+    const span<const uint16_t>& indices);
+
+  /** Creates an indexed mesh with the given mesh_draw_mode, mesh_fill_mode,
+   * vertices, and 32 bit indices.
+   *
+   * Throws if an index is not lower than the number of vertices.
+   *
+   * \param dm the mesh_draw_mode.
+   *
+   * \param fm the mesh_fill_mode.
+   *
+   * \param vertices the vertices.
+   *
+   * \param indices the indices.
+   */
+  mesh_t(mesh_draw_mode dm, mesh_fill_mode fm, const span<const T>& vertices,
+    const span<const uint32_t>& indices);
+
   /** Gets the vertices in the mesh inside a vector.
    *
    * \return a vector containing the vertices of the mesh.
    */
   vertex_collection get_vertices() const;
 
+  /** Gets the vertex buffer storing the vertices of the mesh.
+   *
+   * \return the vertex buffer storing the vertices of the mesh.
+   */
+  const static_vertex_buffer<T>& get_vertex_buffer() const noexcept;
+
 private:
   static_vertex_buffer<T> m_vbo;
 };
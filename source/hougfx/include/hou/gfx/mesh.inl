@@ -12,6 +12,28 @@ mesh_t<T>::mesh_t(
 
 
 
+template <typename T>
+mesh_t<T>::mesh_t(mesh_draw_mode dm, mesh_fill_mode fm,
+  const span<const T>& vertices, const span<const uint16_t>& indices)
+  : mesh_t(dm, fm, vertices)
+{
+  set_index_data(indices);
+  HOU_PRECOND(get_referenced_vertex_count() <= get_vertex_count());
+}
+
+
+
+template <typename T>
+mesh_t<T>::mesh_t(mesh_draw_mode dm, mesh_fill_mode fm,
+  const span<const T>& vertices, const span<const uint32_t>& indices)
+  : mesh_t(dm, fm, vertices)
+{
+  set_index_data(indices);
+  HOU_PRECOND(get_referenced_vertex_count() <= get_vertex_count());
+}
+
+
+
 template <typename T>
 typename mesh_t<T>::vertex_collection mesh_t<T>::get_vertices() const
 {
@@ -20,13 +42,23 @@ typename mesh_t<T>::vertex_collection mesh_t<T>::get_vertices() const
 
 
 
+template <typename T>
+const static_vertex_buffer<T>& mesh_t<T>::get_vertex_buffer() const noexcept
+{
+  return m_vbo;
+}
+
+
+
 template <typename T>
 bool operator==(const mesh_t<T>& lhs, const mesh_t<T>& rhs)
 {
   return lhs.get_vertex_count() == rhs.get_vertex_count()
+    && lhs.get_index_count() == rhs.get_index_count()
     && lhs.get_draw_mode() == rhs.get_draw_mode()
     && lhs.get_fill_mode() == rhs.get_fill_mode()
-    && lhs.get_vertices() == rhs.get_vertices();
+    && lhs.get_vertices() == rhs.get_vertices()
+    && lhs.get_indices() == rhs.get_indices();
 }
 
 
@@ -43,9 +75,11 @@ template <typename T>
 bool close(const mesh_t<T>& lhs, const mesh_t<T>& rhs, float acc)
 {
   return lhs.get_vertex_count() == rhs.get_vertex_count()
+    && lhs.get_index_count() == rhs.get_index_count()
     && lhs.get_draw_mode() == rhs.get_draw_mode()
     && lhs.get_fill_mode() == rhs.get_fill_mode()
-    && close(lhs.get_vertices(), rhs.get_vertices(), acc);
+    && close(lhs.get_vertices(), rhs.get_vertices(), acc)
+    && lhs.get_indices() == rhs.get_indices();
 }
 
 
@@ -53,9 +87,14 @@ bool close(const mesh_t<T>& lhs, const mesh_t<T>& rhs, float acc)
 template <typename T>
 std::ostream& operator<<(std::ostream& os, const mesh_t<T>& m)
 {
-  return os << "{draw_mode = " << m.get_draw_mode()
-            << ", fill_mode = " << m.get_fill_mode()
-            << ", vertices = " << m.get_vertices() << "}";
+  os << "{draw_mode = " << m.get_draw_mode()
+     << ", fill_mode = " << m.get_fill_mode()
+     << ", vertices = " << m.get_vertices();
+  if(m.is_indexed())
+  {
+    os << ", indices = " << m.get_indices();
+  }
+  return os << "}";
 }
 
 }  // namespace hou
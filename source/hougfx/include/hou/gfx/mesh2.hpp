@@ -5,6 +5,7 @@
 #ifndef HOU_GFX_MESH2_HPP
 #define HOU_GFX_MESH2_HPP
 
+#include "hou/gfx/dynamic_mesh.hpp"
 #include "hou/gfx/mesh.hpp"
 #include "hou/gfx/mesh2_fwd.hpp"
 #include "hou/gfx/vertex2.hpp"
@@ -35,6 +36,8 @@ HOU_GFX_API mesh2 rectangle_mesh2(const vec2f& size);
  * The texture coordinates are always equal to zero.
  * The color is always white.
  * The size refers to the outside of the border.
+ * The mesh is indexed, so that the corners closing the shape are not
+ * repeated.
  *
  * \param size the size of the rectangle.
  *
@@ -49,9 +52,10 @@ HOU_GFX_API mesh2 rectangle_outline_mesh2(const vec2f& size, float thickness);
  *
  * The texture coordinates are always equal to zero.
  * The color is always white.
- * The actual vertex count is equal to pointCount plus 2, as the center of
- * the ellipse is also defined as a vertex and one vertex has to be repeated
- * twice to close the shape.
+ * The mesh is indexed. The actual vertex count is equal to pointCount plus
+ * 1, as the center of the ellipse is also defined as a vertex. The index
+ * count is equal to pointCount plus 2, as one vertex is referenced twice to
+ * close the shape.
  *
  * \param size the size of the ellipse.
  *
@@ -71,9 +75,9 @@ HOU_GFX_API mesh2 ellipse_mesh2(const vec2f& size, uint pointCount);
  * and inner perimiter of the outline each.
  * The size refers to the outside of the border.
  *
- * The actual vertex count is equal to double pointCount plus 2, as the center
- * of the ellipse is also defined as a vertex and one vertex has to be repeated
- * twice to close the shape.
+ * The mesh is indexed. The actual vertex count is equal to double
+ * pointCount. The index count is equal to double pointCount plus 2, as two
+ * vertices are referenced twice to close the shape.
  *
  * \param size the size of the ellipse.
  *
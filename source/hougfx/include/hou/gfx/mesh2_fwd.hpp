@@ -17,12 +17,21 @@ class vertex2;
 template <typename vertex>
 class mesh_t;
 
+template <typename vertex>
+class dynamic_mesh_t;
+
 /** mesh of vertex2.
  *
  *  Used to represent 2d shapes such as rectangles, circles...
  */
 using mesh2 = mesh_t<vertex2>;
 
+/** Modifiable mesh of vertex2.
+ *
+ *  Used to represent 2d shapes whose vertices change over time.
+ */
+using dynamic_mesh2 = dynamic_mesh_t<vertex2>;
+
 }  // namespace hou
 
 #endif
@@ -10,24 +10,86 @@
 #include "hou/gfx/mesh2_fwd.hpp"
 #include "hou/gfx/shader_program.hpp"
 #include "hou/gfx/texture2.hpp"
+#include "hou/gfx/vertex_array.hpp"
+#include "hou/gfx/vertex_buffer.hpp"
 
 #include "hou/gfx/gfx_config.hpp"
 
+#include "hou/cor/pragmas.hpp"
+#include "hou/cor/span.hpp"
+
+#include "hou/gl/open_gl.hpp"
+
 #include "hou/mth/transform2.hpp"
 
 #include "hou/sys/color.hpp"
 
+#include <memory>
+
 
 
 namespace hou
 {
 
+class mesh;
 class render_surface;
 
 /** shader program used to render Mesh2d objects.
  */
 class HOU_GFX_API mesh2_renderer : public shader_program
 {
+public:
+  HOU_PRAGMA_PACK_PUSH(1)
+
+  /** Per-instance data used when drawing instanced meshes.
+   */
+  class HOU_GFX_API instance_data
+  {
+  public:
+    /** Retrieves the vertex_format.
+     */
+    static const vertex_format& get_vertex_format();
+
+  public:
+    /** Builds an instance_data object with identity transform and white
+     * color.
+     */
+    instance_data() noexcept;
+
+    /** Builds an instance_data object with the given transform and color.
+     *
+     * \param trn the transform.
+     *
+     * \param col the color.
+     */
+    instance_data(const trans2f& trn, const color& col) noexcept;
+
+    /** Sets the transform.
+     *
+     * \param trn the transform.
+     */
+    void set_transform(const trans2f& trn) noexcept;
+
+    /** Gets the color.
+     *
+     * \return the color.
+     */
+    color get_color() const noexcept;
+
+    /** Sets the color.
+     *
+     * \param col the color.
+     */
+    void set_color(const color& col) noexcept;
+
+  private:
+    GLfloat m_transform_row0[3];
+    GLfloat m_transform_row1[3];
+    GLfloat m_color[4];
+  };
+
+  HOU_PRAGMA_PACK_POP()
+
 public:
   /** Constructor.
    */
@@ -110,11 +172,115 @@ public:
    */
   void draw(render_surface& target, const mesh2& m, const trans2f& trn);
 
+  /** Draws a dynamic mesh onto a render_surface with the given parameters.
+   *
+   * \param target the rendering target.
+   *
+   * \param m the mesh.
+   *
+   * \param tex the texture.
+   *
+   * \param col the color.
+   *
+   * \param trn the transform.
+   */
+  void draw(render_surface& target, const dynamic_mesh2& m,
+    const texture2& tex, const color& col = color::white(),
+    const trans2f& trn = trans2f::identity());
+
+  /** Draws a dynamic mesh onto a render_surface with the given parameters.
+   *
+   * \param target the rendering target.
+   *
+   * \param m the mesh.
+   *
+   * \param col the color.
+   *
+   * \param trn the transform.
+   */
+  void draw(render_surface& target, const dynamic_mesh2& m,
+    const color& col = color::white(),
+    const trans2f& trn = trans2f::identity());
+
+  /** Draws a dynamic mesh onto a render_surface with the given parameters.
+   *
+   * \param target the rendering target.
+   *
+   * \param m the mesh.
+   *
+   * \param tex the texture.
+   *
+   * \param trn the transform.
+   */
+  void draw(render_surface& target, const dynamic_mesh2& m,
+    const texture2& tex, const trans2f& trn);
+
+  /** Draws a dynamic mesh onto a render_surface with the given parameters.
+   *
+   * \param target the rendering target.
+   *
+   * \param m the mesh.
+   *
+   * \param trn the transform.
+   */
+  void draw(
+    render_surface& target, const dynamic_mesh2& m, const trans2f& trn);
+
+  /** Draws many instances of a mesh onto a render_surface with a single draw
+   * call.
+   *
+   * The transform and color of each instance are read from a per-instance
+   * vertex buffer.
+   * The color and transform set on the renderer are not used.
+   *
+   * \param target the rendering target.
+   *
+   * \param m the mesh.
+   *
+   * \param tex the texture.
+   *
+   * \param instances the per-instance data.
+   */
+  void draw_instanced(render_surface& target, const mesh2& m,
+    const texture2& tex, const span<const instance_data>& instances);
+
+  /** Draws many instances of a mesh onto a render_surface with a single draw
+   * call.
+   *
+   * The transform and color of each instance are read from a per-instance
+   * vertex buffer.
+   * The color and transform set on the renderer are not used.
+   *
+   * \param target the rendering target.
+   *
+   * \param m the mesh.
+   *
+   * \param instances the per-instance data.
+   */
+  void draw_instanced(render_surface& target, const mesh2& m,
+    const span<const instance_data>& instances);
+
+  /** Gets the number of instances the per-instance vertex buffer can
+   * currently hold.
+   *
+   * \return the capacity of the per-instance vertex buffer.
+   */
+  size_t get_instance_capacity() const noexcept;
+
+private:
+  void draw_mesh(render_surface& target, const mesh& m, const texture2& tex,
+    const color& col, const trans2f& trn);
+  void reserve_instance_buffer(size_t instance_count);
+
 private:
   texture2 m_blank_texture;
   int m_uni_color;
   int m_uni_texture;
   int m_uni_transform;
+  std::unique_ptr<shader_program> m_instanced_program;
+  int m_uni_instanced_texture;
+  std::unique_ptr<dynamic_vertex_buffer<instance_data>> m_instance_vbo;
+  vertex_array m_instance_vao;
 };
 
 }  // namespace hou
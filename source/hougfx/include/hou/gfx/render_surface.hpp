@@ -189,6 +189,10 @@ public:
   /**
    * Copies the content of the render_surface onto the current window
    * framebuffer and swaps the current window framebuffers.
+   *
+   * This also checks for OpenGL errors raised during the frame, if the
+   * current context checks for errors once per frame, and ends the current
+   * frame for gl::frame_stats.
    */
   void display() const;
 
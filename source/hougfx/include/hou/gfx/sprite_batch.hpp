@@ -0,0 +1,226 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_GFX_SPRITE_BATCH_HPP
+#define HOU_GFX_SPRITE_BATCH_HPP
+
+#include "hou/gfx/shader_program.hpp"
+#include "hou/gfx/texture2.hpp"
+#include "hou/gfx/vertex2.hpp"
+#include "hou/gfx/vertex_array.hpp"
+#include "hou/gfx/vertex_buffer.hpp"
+
+#include "hou/gfx/gfx_config.hpp"
+
+#include "hou/cor/span.hpp"
+
+#include "hou/mth/rectangle.hpp"
+#include "hou/mth/transform2.hpp"
+
+#include "hou/sys/color.hpp"
+
+#include <memory>
+#include <vector>
+
+
+
+namespace hou
+{
+
+class render_surface;
+
+/** shader program used to render many sprites and triangle lists with few
+ * draw calls.
+ *
+ * The vertices of the added sprites are transformed and colored on the CPU and
+ * accumulated into a main-memory buffer.
+ * When drawing, the vertices are uploaded into one of a ring of dynamic vertex
+ * buffers, so that the upload does not have to wait for the GPU to finish
+ * reading the buffer used for the previous draw.
+ * Consecutive sprites using the same texture are rendered with a single draw
+ * call.
+ * If sorting by texture is enabled, sprites are grouped by texture before
+ * drawing, so that each texture costs exactly one draw call. In this case the
+ * draw order is only preserved among sprites with the same texture.
+ */
+class HOU_GFX_API sprite_batch : public shader_program
+{
+public:
+  /** Constructor.
+   *
+   * \param vertex_capacity the initial capacity of each vertex buffer. The
+   * buffers grow automatically if more vertices are added.
+   *
+   * \param buffer_count the number of vertex buffers in the ring. Must be
+   * greater than 0.
+   */
+  explicit sprite_batch(
+    size_t vertex_capacity = 6u * 1024u, size_t buffer_count = 3u);
+
+  /** Adds a quad displaying a whole texture to the batch.
+   *
+   * The quad has its top left corner in the origin.
+   * The texture must be alive until draw is called.
+   *
+   * \param tex the texture.
+   *
+   * \param size the size of the quad.
+   *
+   * \param col the color.
+   *
+   * \param trn the transform.
+   */
+  void add_quad(const texture2& tex, const vec2f& size,
+    const color& col = color::white(),
+    const trans2f& trn = trans2f::identity());
+
+  /** Adds a quad displaying a section of a texture to the batch.
+   *
+   * The quad has its top left corner in the origin and the same size as the
+   * texture section.
+   * The texture must be alive until draw is called.
+   *
+   * \param tex the texture.
+   *
+   * \param tex_rect the texture section, in pixels.
+   *
+   * \param col the color.
+   *
+   * \param trn the transform.
+   */
+  void add_quad(const texture2& tex, const rectf& tex_rect,
+    const color& col = color::white(),
+    const trans2f& trn = trans2f::identity());
+
+  /** Adds an untextured quad to the batch.
+   *
+   * The quad has its top left corner in the origin.
+   *
+   * \param size the size of the quad.
+   *
+   * \param col the color.
+   *
+   * \param trn the transform.
+   */
+  void add_quad(const vec2f& size, const color& col = color::white(),
+    const trans2f& trn = trans2f::identity());
+
+  /** Adds a list of triangles to the batch.
+   *
+   * The color of each vertex is multiplied by col.
+   * The number of vertices must be a multiple of 3.
+   * The texture must be alive until draw is called.
+   *
+   * \param tex the texture.
+   *
+   * \param vertices the vertices of the triangles.
+   *
+   * \param col the color.
+   *
+   * \param trn the transform.
+   */
+  void add_triangles(const texture2& tex, const span<const vertex2>& vertices,
+    const color& col = color::white(),
+    const trans2f& trn = trans2f::identity());
+
+  /** Adds a list of untextured triangles to the batch.
+   *
+   * The color of each vertex is multiplied by col.
+   * The number of vertices must be a multiple of 3.
+   *
+   * \param vertices the vertices of the triangles.
+   *
+   * \param col the color.
+   *
+   * \param trn the transform.
+   */
+  void add_triangles(const span<const vertex2>& vertices,
+    const color& col = color::white(),
+    const trans2f& trn = trans2f::identity());
+
+  /** Draws all the sprites in the batch onto a render_surface and clears the
+   * batch.
+   *
+   * \param target the rendering target.
+   */
+  void draw(render_surface& target);
+
+  /** Removes all sprites from the batch without rendering them.
+   */
+  void clear();
+
+  /** Sets if the sprites are grouped by texture when drawing.
+   *
+   * The default value is false.
+   *
+   * \param value true to enable sorting by texture.
+   */
+  void set_sorting_by_texture(bool value) noexcept;
+
+  /** Checks if the sprites are grouped by texture when drawing.
+   *
+   * \return true if sorting by texture is enabled.
+   */
+  bool is_sorting_by_texture() const noexcept;
+
+  /** Gets the number of vertices currently in the batch.
+   *
+   * \return the number of vertices currently in the batch.
+   */
+  size_t get_vertex_count() const noexcept;
+
+  /** Gets the number of vertices the next vertex buffer in the ring can
+   * currently hold.
+   *
+   * \return the capacity of the next vertex buffer.
+   */
+  size_t get_vertex_capacity() const noexcept;
+
+  /** Gets the number of vertex buffers in the ring.
+   *
+   * \return the number of vertex buffers in the ring.
+   */
+  size_t get_buffer_count() const noexcept;
+
+  /** Gets the number of draw calls needed to render the current batch.
+   *
+   * \return the number of draw calls needed to render the current batch.
+   */
+  size_t get_draw_call_count() const;
+
+private:
+  struct run
+  {
+    const texture2* tex;
+    size_t first;
+    size_t count;
+  };
+
+  struct stream_buffer
+  {
+    std::unique_ptr<dynamic_vertex_buffer<vertex2>> vbo;
+    vertex_array vao;
+  };
+
+private:
+  void add_vertex(const vec2f& pos, const vec2f& tex_coords, const color& col,
+    const trans2f& trn);
+  void begin_run(const texture2& tex, size_t vertex_count);
+  void sort_runs();
+  void reserve_buffer(stream_buffer& sb, size_t vertex_count);
+
+private:
+  texture2 m_blank_texture;
+  std::vector<vertex2> m_vertices;
+  std::vector<vertex2> m_sorted_vertices;
+  std::vector<run> m_runs;
+  std::vector<stream_buffer> m_buffers;
+  size_t m_current_buffer;
+  bool m_sorting_by_texture;
+  int m_uni_texture;
+};
+
+}  // namespace hou
+
+#endif
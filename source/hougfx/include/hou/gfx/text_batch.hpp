@@ -0,0 +1,131 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_GFX_TEXT_BATCH_HPP
+#define HOU_GFX_TEXT_BATCH_HPP
+
+#include "hou/gfx/shader_program.hpp"
+#include "hou/gfx/vertex_array.hpp"
+#include "hou/gfx/vertex_buffer.hpp"
+
+#include "hou/gfx/gfx_config.hpp"
+
+#include "hou/mth/transform2.hpp"
+
+#include "hou/sys/color.hpp"
+
+#include "hou/gl/open_gl.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+
+
+namespace hou
+{
+
+class formatted_text;
+class render_surface;
+class texture2_array;
+
+/** shader program used to render many formatted_text objects with few draw
+ * calls.
+ *
+ * The vertices of the added texts are transformed and colored on the CPU and
+ * accumulated into a single streamed vertex buffer, and their indices into a
+ * single streamed index buffer.
+ * When drawing, consecutive texts referencing the same atlas are rendered
+ * with a single draw call, so that texts sharing a glyph_atlas cost one draw
+ * call in total.
+ * Texts are rendered in the order in which they were added.
+ */
+class HOU_GFX_API text_batch : public shader_program
+{
+public:
+  /** Constructor.
+   *
+   * \param vertex_capacity the initial capacity of the vertex buffer. Each
+   * glyph uses 4 vertices and 6 indices, and the index buffer is sized
+   * accordingly. The buffers grow automatically if more glyphs are added.
+   * The default capacity holds 1024 glyphs.
+   */
+  explicit text_batch(size_t vertex_capacity = 4u * 1024u);
+
+  /** Adds a formatted_text to the batch.
+   *
+   * The text is not rendered until draw is called.
+   * The atlas of the text must be alive until then.
+   *
+   * \param text the formatted_text.
+   *
+   * \param col the color.
+   *
+   * \param trn the transform.
+   */
+  void add(const formatted_text& text, const color& col = color::white(),
+    const trans2f& trn = trans2f::identity());
+
+  /** Draws all the texts in the batch onto a render_surface and clears the
+   * batch.
+   *
+   * \param target the rendering target.
+   */
+  void draw(render_surface& target);
+
+  /** Removes all texts from the batch without rendering them.
+   */
+  void clear();
+
+  /** Gets the number of vertices currently in the batch.
+   *
+   * \return the number of vertices currently in the batch.
+   */
+  size_t get_vertex_count() const noexcept;
+
+  /** Gets the number of vertices the vertex buffer can currently hold.
+   *
+   * \return the capacity of the vertex buffer.
+   */
+  size_t get_vertex_capacity() const noexcept;
+
+  /** Gets the number of draw calls needed to render the current batch.
+   *
+   * \return the number of draw calls needed to render the current batch.
+   */
+  size_t get_draw_call_count() const noexcept;
+
+private:
+  struct vertex
+  {
+    GLfloat position[2];
+    GLfloat tex_coords[3];
+    GLfloat color[4];
+  };
+
+  struct run
+  {
+    const texture2_array* atlas;
+    size_t first;
+    size_t count;
+  };
+
+private:
+  static const vertex_format& get_vertex_format();
+
+  void reserve_buffers(size_t vertex_count, size_t index_count);
+
+private:
+  std::vector<vertex> m_vertices;
+  std::vector<uint32_t> m_indices;
+  std::vector<run> m_runs;
+  std::unique_ptr<dynamic_vertex_buffer<vertex>> m_vbo;
+  std::unique_ptr<dynamic_vertex_buffer<uint32_t>> m_ibo;
+  vertex_array m_vao;
+  int m_uni_texture;
+};
+
+}  // namespace hou
+
+#endif
@@ -68,9 +68,15 @@ public:
    * \param binding_index the binding index to be used.
    *
    * \param vf the format of the vertices contained in vb.
+   *
+   * \param first_attrib_index the index assigned to the first attribute in vf.
+   * The following attributes are assigned consecutive indices.
+   *
+   * \param divisor the number of instances sharing an element of vb when
+   * drawing instanced. 0 means that an element is read for each vertex.
    */
-  void set_vertex_data(
-    const vertex_buffer& vb, uint binding_index, const vertex_format& vf);
+  void set_vertex_data(const vertex_buffer& vb, uint binding_index,
+    const vertex_format& vf, uint first_attrib_index = 0u, uint divisor = 0u);
 
   /** Binds a vertex_buffer as an element buffer.
    *
@@ -43,6 +43,8 @@ public:
 // FT_Library is a pointer, can return by value.
 FT_Library get_ft_library();
 
+uint32_t generate_uid();
+
 
 
 ft_library_wrapper::ft_library_wrapper()
@@ -76,12 +78,21 @@ FT_Library get_ft_library()
   return wrapper.library;
 }
 
+
+
+uint32_t generate_uid()
+{
+  static uid_generator uid_gen(1u);
+  return uid_gen.generate();
+}
+
 }  // namespace
 
 
 
 font::font(data_type&& data)
-  : m_face()
+  : m_uid(generate_uid())
+  , m_face()
   , m_face_index(0u)
   , m_pixel_height(10u)
   , m_data(std::move(data))
@@ -110,11 +121,13 @@ font::font(binary_stream_in&& font_stream)
 
 
 font::font(font&& other) noexcept
-  : m_face(std::move(other.m_face))
+  : m_uid(std::move(other.m_uid))
+  , m_face(std::move(other.m_face))
   , m_face_index(std::move(other.m_face_index))
   , m_pixel_height(std::move(other.m_pixel_height))
   , m_data(std::move(other.m_data))
 {
+  other.m_uid = 0u;
   other.m_face = nullptr;
 }
 
@@ -130,6 +143,13 @@ font::~font()
 
 
 
+font::uid_type font::get_uid() const noexcept
+{
+  return m_uid;
+}
+
+
+
 uint font::get_face_index_count() const noexcept
 {
   HOU_DEV_ASSERT(m_face != nullptr);
@@ -5,8 +5,9 @@
 
 #include "hou/gfx/font.hpp"
 #include "hou/gfx/glyph.hpp"
-#include "hou/gfx/texture_channel_mapping.hpp"
+#include "hou/gfx/glyph_atlas.hpp"
 
+#include <limits>
 #include <map>
 #include <set>
 
@@ -24,7 +25,6 @@ public:
   glyph_cache(const span<const utf32::code_unit>& characters, const font& f);
 
   const std::map<utf32::code_unit, glyph>& get_glyphs() const;
-  const glyph& get_glyph(utf32::code_unit c) const;
   const vec2u& get_max_glyph_size() const;
   size_t get_size() const;
 
@@ -57,52 +57,38 @@ private:
 
 
 
-class glyph_atlas
-{
-public:
-  glyph_atlas(const glyph_cache& cache);
-
-  const image3_r& get_image() const;
-  const atlas_glyph_coordinates& get_atlas_glyph_coordinates(
-    utf32::code_unit c) const;
-
-private:
-  static vec3u compute_atlas_grid_size(const glyph_cache& cache);
-
-private:
-  vec3u m_atlas_grid_size;
-  image3_r m_image;
-  std::map<utf32::code_unit, atlas_glyph_coordinates> m_glyph_coords;
-};
+vec3u compute_atlas_size(const glyph_cache& cache);
 
 
 
 class text_formatter
 {
 public:
-  text_formatter(std::u32string text, const font&, const glyph_cache& cache,
-    const glyph_atlas& atlas, const text_box_formatting_params params);
+  text_formatter(std::u32string text, const font& f, glyph_atlas& atlas,
+    const text_box_formatting_params params);
 
   const std::vector<text_vertex>& get_vertices() const;
+  const std::vector<uint32_t>& get_indices() const;
   const rectf& get_bounding_box() const;
 
 private:
-  static constexpr uint s_vertices_per_glyph = 6u;
+  static constexpr uint s_vertices_per_glyph = 4u;
+  static constexpr uint s_indices_per_glyph = 6u;
   static constexpr utf32::code_unit s_line_feed = 0x0000000A;
   static constexpr utf32::code_unit s_whitespace = 0x00000020;
 
 private:
   float compute_glyph_advance(const glyph_metrics& gm, const font& f) const;
   vec2f compute_glyph_bearing(const glyph_metrics& gm, const font& f) const;
-  void insert_line_breaks(const font& f, const glyph_cache& cache,
-    const text_box_formatting_params& tbfp);
-  void generate_vertices(
-    const font& f, const glyph_cache& cache, const glyph_atlas& atlas);
+  void insert_line_breaks(
+    const font& f, glyph_atlas& atlas, const text_box_formatting_params& tbfp);
+  void generate_vertices(const font& f, glyph_atlas& atlas);
   void compute_bounding_box();
 
 private:
   std::u32string m_text;
   std::vector<text_vertex> m_vertices;
+  std::vector<uint32_t> m_indices;
   size_t m_line_coord;
   size_t m_column_coord;
   float m_line_spacing;
@@ -144,13 +130,6 @@ const std::map<utf32::code_unit, glyph>& glyph_cache::get_glyphs() const
 
 
 
-const glyph& glyph_cache::get_glyph(utf32::code_unit c) const
-{
-  return m_glyphs.at(c);
-}
-
-
-
 const vec2u& glyph_cache::get_max_glyph_size() const
 {
   return m_max_glyph_size;
@@ -158,23 +137,36 @@ const vec2u& glyph_cache::get_max_glyph_size() const
 
 
 
-vec3u glyph_atlas::compute_atlas_grid_size(const glyph_cache& cache)
+vec3u compute_atlas_size(const glyph_cache& cache)
 {
   static const vec3u max_atlas_size(
     std::min(2048u, texture2_array::get_max_size().x()),
     std::min(2048u, texture2_array::get_max_size().y()),
     std::min(256u, texture2_array::get_max_size().z()));
 
+  // Make sure that the atlas is never empty, even if the text is empty or
+  // contains only whitespace.
+  // Each cell also holds the gutter the glyph_atlas leaves after each glyph.
+  const uint gutter = glyph_atlas::get_gutter();
+  vec2u cell_size(std::max(1u, cache.get_max_glyph_size().x()) + gutter,
+    std::max(1u, cache.get_max_glyph_size().y()) + gutter);
+
   vec3u maxAtlasGridSize = max_atlas_size;
-  maxAtlasGridSize.x() /= cache.get_max_glyph_size().x();
-  maxAtlasGridSize.y() /= cache.get_max_glyph_size().y();
+  maxAtlasGridSize.x() /= cell_size.x();
+  maxAtlasGridSize.y() /= cell_size.y();
 
-  uint char_count = static_cast<uint>(cache.get_size());
-  return vec3u(std::min(char_count, maxAtlasGridSize.x()),
+  uint char_count = std::max(1u, static_cast<uint>(cache.get_size()));
+  vec3u grid_size(std::min(char_count, maxAtlasGridSize.x()),
     std::min(char_count / maxAtlasGridSize.x(), maxAtlasGridSize.y() - 1u) + 1u,
     std::min(char_count / (maxAtlasGridSize.x() * maxAtlasGridSize.y()),
       maxAtlasGridSize.z() - 1u)
       + 1u);
+
+  // The glyph_atlas packs glyphs in shelves. Each glyph plus its gutter is at
+  // most as large as a cell, so each shelf is at most as tall as a grid row
+  // and fits at least as many glyphs, and the grid always fits in the atlas.
+  return vec3u(grid_size.x() * cell_size.x(), grid_size.y() * cell_size.y(),
+    grid_size.z());
 }
 
 
@@ -256,52 +248,11 @@ size_t glyph_cache::get_size() const
 
 
 
-glyph_atlas::glyph_atlas(const glyph_cache& cache)
-  : m_atlas_grid_size(compute_atlas_grid_size(cache))
-  , m_image(vec3u(m_atlas_grid_size.x() * cache.get_max_glyph_size().x(),
-      m_atlas_grid_size.y() * cache.get_max_glyph_size().y(),
-      m_atlas_grid_size.z()))
-  , m_glyph_coords()
-{
-  uint atlas_grid_layer_size = m_atlas_grid_size.x() * m_atlas_grid_size.y();
-  uint idx = 0;
-  for(const auto& kv : cache.get_glyphs())
-  {
-    vec3u glyph_position(idx % atlas_grid_layer_size % m_atlas_grid_size.x()
-        * cache.get_max_glyph_size().x(),
-      idx % atlas_grid_layer_size / m_atlas_grid_size.x()
-        * cache.get_max_glyph_size().y(),
-      idx / atlas_grid_layer_size);
-    m_image.set_sub_image(glyph_position, kv.second.get_image());
-    m_glyph_coords.insert(std::make_pair(kv.first,
-      atlas_glyph_coordinates(
-        glyph_position, kv.second.get_image().get_size(), m_image.get_size())));
-    ++idx;
-  }
-}
-
-
-
-const image3_r& glyph_atlas::get_image() const
-{
-  return m_image;
-}
-
-
-
-const atlas_glyph_coordinates& glyph_atlas::get_atlas_glyph_coordinates(
-  utf32::code_unit c) const
-{
-  return m_glyph_coords.at(c);
-}
-
-
-
 text_formatter::text_formatter(std::u32string text, const font& f,
-  const glyph_cache& cache, const glyph_atlas& atlas,
-  const text_box_formatting_params tbfp)
+  glyph_atlas& atlas, const text_box_formatting_params tbfp)
   : m_text(text)
   , m_vertices(s_vertices_per_glyph * text.size(), text_vertex())
+  , m_indices()
   , m_line_coord((tbfp.get_text_flow() == text_flow::left_right
                    || tbfp.get_text_flow() == text_flow::right_left)
         ? 0u
@@ -315,8 +266,8 @@ text_formatter::text_formatter(std::u32string text, const font& f,
         : -1.f)
   , m_bounding_box()
 {
-  insert_line_breaks(f, cache, tbfp);
-  generate_vertices(f, cache, atlas);
+  insert_line_breaks(f, atlas, tbfp);
+  generate_vertices(f, atlas);
   compute_bounding_box();
 }
 
@@ -349,8 +300,8 @@ vec2f text_formatter::compute_glyph_bearing(
 
 
 
-void text_formatter::insert_line_breaks(const font& f, const glyph_cache& cache,
-  const text_box_formatting_params& tbfp)
+void text_formatter::insert_line_breaks(
+  const font& f, glyph_atlas& atlas, const text_box_formatting_params& tbfp)
 {
   // This function wraps text inside the bounding box.
   // The algorithm should be improved to be consistent with common typographic
@@ -390,7 +341,7 @@ void text_formatter::insert_line_breaks(const font& f, const glyph_cache& cache,
     {
       HOU_DEV_ASSERT(i < m_text.size());
       word_size += std::fabs(
-        compute_glyph_advance(cache.get_glyph(m_text[i]).get_metrics(), f));
+        compute_glyph_advance(atlas.get_entry(f, m_text[i]).get_metrics(), f));
     }
 
     // If the first word is a space, remove it for size computations.
@@ -398,7 +349,7 @@ void text_formatter::insert_line_breaks(const font& f, const glyph_cache& cache,
     if(m_text[pos] == s_whitespace)
     {
       word_size_adjustment = std::fabs(
-        compute_glyph_advance(cache.get_glyph(s_whitespace).get_metrics(), f));
+        compute_glyph_advance(atlas.get_entry(f, s_whitespace).get_metrics(), f));
     }
 
     // If the word can't possibly fit on any line.
@@ -442,8 +393,7 @@ void text_formatter::insert_line_breaks(const font& f, const glyph_cache& cache,
 
 
 
-void text_formatter::generate_vertices(
-  const font& f, const glyph_cache& cache, const glyph_atlas& atlas)
+void text_formatter::generate_vertices(const font& f, glyph_atlas& atlas)
 {
   vec2f pen_pos(0.f, 0.f);
   for(size_t i = 0; i < m_text.size(); ++i)
@@ -456,8 +406,10 @@ void text_formatter::generate_vertices(
     }
     else
     {
-      const glyph_metrics& gm = cache.get_glyph(c).get_metrics();
-      const atlas_glyph_coordinates& ac = atlas.get_atlas_glyph_coordinates(c);
+      const glyph_atlas::entry& ge = atlas.get_entry(f, c);
+      const glyph_metrics& gm = ge.get_metrics();
+      atlas_glyph_coordinates ac(
+        ge.get_position(), ge.get_size(), atlas.get_texture().get_size());
 
       float advance = compute_glyph_advance(gm, f);
 
@@ -484,12 +436,17 @@ void text_formatter::generate_vertices(
       vec3f v3_tex = ac.get_bottom_right_tex();
       text_vertex v3(v3_pos, v3_tex);
 
-      m_vertices[i * 6 + 0] = v0;
-      m_vertices[i * 6 + 1] = v1;
-      m_vertices[i * 6 + 2] = v2;
-      m_vertices[i * 6 + 3] = v2;
-      m_vertices[i * 6 + 4] = v1;
-      m_vertices[i * 6 + 5] = v3;
+      size_t first = i * s_vertices_per_glyph;
+      m_vertices[first + 0] = v0;
+      m_vertices[first + 1] = v1;
+      m_vertices[first + 2] = v2;
+      m_vertices[first + 3] = v3;
+
+      // The two triangles of the glyph quad share the v1-v2 diagonal.
+      uint32_t index = narrow_cast<uint32_t>(first);
+      m_indices.insert(m_indices.end(),
+        {index + 0u, index + 1u, index + 2u, index + 2u, index + 1u,
+          index + 3u});
 
       if(advance > 0.f)
       {
@@ -508,7 +465,7 @@ void text_formatter::compute_bounding_box()
   }
 
   static constexpr size_t tl_offset = 0u;
-  static constexpr size_t br_offset = 5u;
+  static constexpr size_t br_offset = 3u;
 
   vec2f top_left = m_vertices[tl_offset].get_position();
   vec2f bottom_right = m_vertices[br_offset].get_position();
@@ -549,6 +506,13 @@ const std::vector<text_vertex>& text_formatter::get_vertices() const
 
 
 
+const std::vector<uint32_t>& text_formatter::get_indices() const
+{
+  return m_indices;
+}
+
+
+
 const rectf& text_formatter::get_bounding_box() const
 {
   return m_bounding_box;
@@ -568,25 +532,56 @@ formatted_text::formatted_text(const std::string& text, const font& f,
 formatted_text::formatted_text(
   std::u32string text, const font& f, const text_box_formatting_params& tbfp)
   : non_copyable()
+  , m_owned_atlas(nullptr)
   , m_atlas(nullptr)
   , m_mesh(nullptr)
+  , m_vertices()
+  , m_indices()
   , m_bounding_box()
 {
   glyph_cache gc(text, f);
-  glyph_atlas ga(gc);
-  text_formatter formatter(text, f, gc, ga, tbfp);
-
-  m_atlas
-    = std::make_unique<texture2_array>(ga.get_image(), texture_format::r, 1u);
-  m_atlas->set_channel_mapping(texture_channel_mapping::alpha);
-  m_mesh = std::make_unique<text_mesh>(
-    mesh_draw_mode::triangles, mesh_fill_mode::fill, formatter.get_vertices());
-  m_bounding_box = formatter.get_bounding_box();
+  m_owned_atlas = std::make_unique<glyph_atlas>(compute_atlas_size(gc));
+  for(const auto& kv : gc.get_glyphs())
+  {
+    m_owned_atlas->insert(f, kv.first, kv.second);
+  }
+  m_atlas = m_owned_atlas.get();
+  format(std::move(text), f, *m_owned_atlas, tbfp);
+}
+
+
+
+formatted_text::formatted_text(const std::string& text, const font& f,
+  glyph_atlas& atlas, const text_box_formatting_params& tbfp)
+  : formatted_text(convert_encoding<utf32, utf8>(text), f, atlas, tbfp)
+{}
+
+
+
+formatted_text::formatted_text(std::u32string text, const font& f,
+  glyph_atlas& atlas, const text_box_formatting_params& tbfp)
+  : non_copyable()
+  , m_owned_atlas(nullptr)
+  , m_atlas(&atlas)
+  , m_mesh(nullptr)
+  , m_vertices()
+  , m_indices()
+  , m_bounding_box()
+{
+  format(std::move(text), f, atlas, tbfp);
 }
 
 
 
 const texture2_array& formatted_text::get_atlas() const
+{
+  HOU_DEV_ASSERT(m_atlas != nullptr);
+  return m_atlas->get_texture();
+}
+
+
+
+const glyph_atlas& formatted_text::get_glyph_atlas() const
 {
   HOU_DEV_ASSERT(m_atlas != nullptr);
   return *m_atlas;
@@ -602,9 +597,47 @@ const text_mesh& formatted_text::get_mesh() const
 
 
 
+const formatted_text::VertexContainer& formatted_text::get_vertices() const
+{
+  return m_vertices;
+}
+
+
+
+const formatted_text::IndexContainer& formatted_text::get_indices() const
+{
+  return m_indices;
+}
+
+
+
 const rectf& formatted_text::get_bounding_box() const
 {
   return m_bounding_box;
 }
 
+
+
+void formatted_text::format(std::u32string text, const font& f,
+  glyph_atlas& atlas, const text_box_formatting_params& tbfp)
+{
+  text_formatter formatter(std::move(text), f, atlas, tbfp);
+  m_vertices = formatter.get_vertices();
+  m_indices = formatter.get_indices();
+  // 16 bit indices are used whenever possible to halve the index buffer size.
+  if(m_vertices.size()
+    <= static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1u)
+  {
+    m_mesh = std::make_unique<text_mesh>(mesh_draw_mode::triangles,
+      mesh_fill_mode::fill, m_vertices,
+      std::vector<uint16_t>(m_indices.begin(), m_indices.end()));
+  }
+  else
+  {
+    m_mesh = std::make_unique<text_mesh>(
+      mesh_draw_mode::triangles, mesh_fill_mode::fill, m_vertices, m_indices);
+  }
+  m_bounding_box = formatter.get_bounding_box();
+}
+
 }  // namespace hou
@@ -0,0 +1,200 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gfx/glyph_atlas.hpp"
+
+#include "hou/gfx/glyph.hpp"
+#include "hou/gfx/pixel_view.hpp"
+#include "hou/gfx/texture_channel_mapping.hpp"
+
+#include "hou/cor/cor_exceptions.hpp"
+
+#include <algorithm>
+
+
+
+namespace hou
+{
+
+glyph_atlas::entry::entry(
+  const glyph_metrics& metrics, const vec3u& position, const vec2u& size) noexcept
+  : m_metrics(metrics)
+  , m_position(position)
+  , m_size(size)
+{}
+
+
+
+const glyph_metrics& glyph_atlas::entry::get_metrics() const noexcept
+{
+  return m_metrics;
+}
+
+
+
+const vec3u& glyph_atlas::entry::get_position() const noexcept
+{
+  return m_position;
+}
+
+
+
+const vec2u& glyph_atlas::entry::get_size() const noexcept
+{
+  return m_size;
+}
+
+
+
+vec3u glyph_atlas::get_default_size()
+{
+  return vec3u(std::min(1024u, texture2_array::get_max_size().x()),
+    std::min(1024u, texture2_array::get_max_size().y()),
+    std::min(4u, texture2_array::get_max_size().z()));
+}
+
+
+
+uint glyph_atlas::get_gutter() noexcept
+{
+  return 1u;
+}
+
+
+
+glyph_atlas::glyph_atlas(const vec3u& size)
+  : non_copyable()
+  , m_texture(size, texture_format::r, 1u)
+  , m_entries()
+  , m_pen(vec3u::zero())
+  , m_shelf_height(0u)
+{
+  m_texture.set_channel_mapping(texture_channel_mapping::alpha);
+}
+
+
+
+const texture2_array& glyph_atlas::get_texture() const noexcept
+{
+  return m_texture;
+}
+
+
+
+size_t glyph_atlas::get_entry_count() const noexcept
+{
+  return m_entries.size();
+}
+
+
+
+bool glyph_atlas::contains(const font& f, utf32::code_unit c) const
+{
+  return m_entries.count(make_key(f, c)) > 0u;
+}
+
+
+
+const glyph_atlas::entry& glyph_atlas::get_entry(
+  const font& f, utf32::code_unit c)
+{
+  auto it = m_entries.find(make_key(f, c));
+  if(it != m_entries.end())
+  {
+    return it->second;
+  }
+  return insert(f, c, f.get_glyph(c));
+}
+
+
+
+void glyph_atlas::reserve(
+  const font& f, const span<const utf32::code_unit>& characters)
+{
+  for(auto c : characters)
+  {
+    get_entry(f, c);
+  }
+}
+
+
+
+const glyph_atlas::entry& glyph_atlas::insert(
+  const font& f, utf32::code_unit c, const glyph& g)
+{
+  key_type key = make_key(f, c);
+  auto it = m_entries.find(key);
+  if(it != m_entries.end())
+  {
+    return it->second;
+  }
+
+  const image2_r& im = g.get_image();
+  vec3u position = allocate(im.get_size());
+  if(im.get_size().x() > 0u && im.get_size().y() > 0u)
+  {
+    m_texture.set_sub_image(position, pixel_view2(im));
+  }
+
+  auto inserted = m_entries.insert(
+    std::make_pair(key, entry(g.get_metrics(), position, im.get_size())));
+  HOU_DEV_ASSERT(inserted.second);
+  return inserted.first->second;
+}
+
+
+
+void glyph_atlas::clear()
+{
+  m_entries.clear();
+  m_pen = vec3u::zero();
+  m_shelf_height = 0u;
+  m_texture.clear();
+}
+
+
+
+glyph_atlas::key_type glyph_atlas::make_key(const font& f, utf32::code_unit c)
+{
+  return key_type(f.get_uid(), f.get_face_index(), f.get_pixel_height(), c);
+}
+
+
+
+vec3u glyph_atlas::allocate(const vec2u& size)
+{
+  // Glyphs are packed in horizontal shelves. A new shelf is opened when the
+  // current one is full, and a new layer when the current layer is full.
+  // Glyphs are separated by a gutter, so that filtering does not sample texels
+  // of neighbouring glyphs.
+  const uint gutter = get_gutter();
+
+  const vec3u& tex_size = m_texture.get_size();
+  HOU_CHECK_0(size.x() <= tex_size.x() && size.y() <= tex_size.y(),
+    overflow_error);
+
+  if(m_pen.x() + size.x() > tex_size.x())
+  {
+    m_pen.x() = 0u;
+    m_pen.y() += m_shelf_height;
+    m_shelf_height = 0u;
+  }
+
+  if(m_pen.y() + size.y() > tex_size.y())
+  {
+    m_pen.x() = 0u;
+    m_pen.y() = 0u;
+    ++m_pen.z();
+    m_shelf_height = 0u;
+  }
+
+  HOU_CHECK_0(m_pen.z() < tex_size.z(), overflow_error);
+
+  vec3u position = m_pen;
+  m_pen.x() += size.x() + gutter;
+  m_shelf_height = std::max(m_shelf_height, size.y() + gutter);
+  return position;
+}
+
+}  // namespace hou
@@ -55,37 +55,35 @@ void set_blending_enabled(bool value)
 
 blending_factor get_source_blending_factor()
 {
-  return blending_factor(gl::get_integer(GL_BLEND_SRC_ALPHA));
+  return blending_factor(gl::get_blend_src_factor());
 }
 
 
 
 void set_source_blending_factor(blending_factor f)
 {
-  gl::set_blend_func(
-    static_cast<GLenum>(f), gl::get_integer(GL_BLEND_DST_ALPHA));
+  gl::set_blend_func(static_cast<GLenum>(f), gl::get_blend_dst_factor());
 }
 
 
 
 blending_factor get_destination_blending_factor()
 {
-  return blending_factor(gl::get_integer(GL_BLEND_DST_ALPHA));
+  return blending_factor(gl::get_blend_dst_factor());
 }
 
 
 
 void set_destination_blending_factor(blending_factor f)
 {
-  gl::set_blend_func(
-    gl::get_integer(GL_BLEND_SRC_ALPHA), static_cast<GLenum>(f));
+  gl::set_blend_func(gl::get_blend_src_factor(), static_cast<GLenum>(f));
 }
 
 
 
 blending_equation get_blending_equation()
 {
-  return blending_equation(gl::get_integer(GL_BLEND_EQUATION_ALPHA));
+  return blending_equation(gl::get_blend_equation());
 }
 
 
@@ -100,7 +98,7 @@ void set_blending_equation(blending_equation eq)
 color get_blending_color()
 {
   GLfloat color[4];
-  gl::get_float_v(GL_BLEND_COLOR, color);
+  gl::get_blend_color(color);
   return color_f(color[0], color[1], color[2], color[3]);
 }
 
@@ -6,6 +6,8 @@
 
 #include "hou/gl/gl_functions.hpp"
 
+#include <algorithm>
+
 
 
 namespace hou
@@ -16,8 +18,20 @@ void mesh::draw(const mesh& mesh)
   vertex_array::bind(mesh.m_vao);
   gl::set_polygon_mode(
     GL_FRONT_AND_BACK, static_cast<GLenum>(mesh.m_fill_mode));
-  gl::draw_arrays(static_cast<GLenum>(mesh.m_draw_mode), 0,
-    narrow_cast<GLsizei>(mesh.m_vertex_count));
+  if(mesh.is_indexed())
+  {
+    gl::draw_elements(static_cast<GLenum>(mesh.m_draw_mode),
+      narrow_cast<GLsizei>(mesh.m_draw_count),
+      static_cast<GLenum>(mesh.m_index_type),
+      narrow_cast<GLintptr>(
+        mesh.m_draw_first * get_gl_type_byte_size(mesh.m_index_type)));
+  }
+  else
+  {
+    gl::draw_arrays(static_cast<GLenum>(mesh.m_draw_mode),
+      narrow_cast<GLint>(mesh.m_draw_first),
+      narrow_cast<GLsizei>(mesh.m_draw_count));
+  }
 }
 
 
@@ -28,6 +42,12 @@ mesh::mesh(mesh_draw_mode dm, mesh_fill_mode fm, size_t vertex_count)
   , m_draw_mode(dm)
   , m_fill_mode(fm)
   , m_vertex_count(vertex_count)
+  , m_ibo(nullptr)
+  , m_index_type(gl_type::unsigned_integer)
+  , m_index_count(0u)
+  , m_referenced_vertex_count(0u)
+  , m_draw_first(0u)
+  , m_draw_count(vertex_count)
 {}
 
 
@@ -56,4 +76,132 @@ size_t mesh::get_vertex_count() const noexcept
   return m_vertex_count;
 }
 
+
+
+bool mesh::is_indexed() const noexcept
+{
+  return m_ibo != nullptr;
+}
+
+
+
+size_t mesh::get_index_count() const noexcept
+{
+  return m_index_count;
+}
+
+
+
+gl_type mesh::get_index_type() const noexcept
+{
+  return m_index_type;
+}
+
+
+
+const vertex_buffer* mesh::get_index_buffer() const noexcept
+{
+  return m_ibo.get();
+}
+
+
+
+std::vector<uint32_t> mesh::get_indices() const
+{
+  if(!is_indexed())
+  {
+    return std::vector<uint32_t>();
+  }
+  else if(m_index_type == gl_type::unsigned_short_integer)
+  {
+    std::vector<uint16_t> indices
+      = static_cast<const static_vertex_buffer<uint16_t>&>(*m_ibo).get_data();
+    return std::vector<uint32_t>(indices.begin(), indices.end());
+  }
+  else
+  {
+    return static_cast<const static_vertex_buffer<uint32_t>&>(*m_ibo)
+      .get_data();
+  }
+}
+
+
+
+void mesh::set_draw_range(size_t first, size_t count)
+{
+  HOU_PRECOND(
+    first + count <= (is_indexed() ? m_index_count : m_vertex_count));
+  m_draw_first = first;
+  m_draw_count = count;
+}
+
+
+
+void mesh::reset_draw_range() noexcept
+{
+  m_draw_first = 0u;
+  m_draw_count = is_indexed() ? m_index_count : m_vertex_count;
+}
+
+
+
+size_t mesh::get_draw_first() const noexcept
+{
+  return m_draw_first;
+}
+
+
+
+size_t mesh::get_draw_count() const noexcept
+{
+  return m_draw_count;
+}
+
+
+
+void mesh::set_vertex_count(size_t vertex_count) noexcept
+{
+  m_vertex_count = vertex_count;
+  reset_draw_range();
+}
+
+
+
+size_t mesh::get_referenced_vertex_count() const noexcept
+{
+  return m_referenced_vertex_count;
+}
+
+
+
+void mesh::set_index_data(const span<const uint16_t>& indices)
+{
+  HOU_DEV_ASSERT(m_ibo == nullptr);
+  m_ibo = std::make_unique<static_vertex_buffer<uint16_t>>(indices);
+  m_index_type = gl_type::unsigned_short_integer;
+  m_index_count = indices.size();
+  m_referenced_vertex_count = indices.size() == 0u
+    ? 0u
+    : static_cast<size_t>(*std::max_element(indices.begin(), indices.end()))
+      + 1u;
+  m_vao.set_element_data(*m_ibo);
+  reset_draw_range();
+}
+
+
+
+void mesh::set_index_data(const span<const uint32_t>& indices)
+{
+  HOU_DEV_ASSERT(m_ibo == nullptr);
+  m_ibo = std::make_unique<static_vertex_buffer<uint32_t>>(indices);
+  m_index_type = gl_type::unsigned_integer;
+  m_index_count = indices.size();
+  m_referenced_vertex_count = indices.size() == 0u
+    ? 0u
+    : static_cast<size_t>(*std::max_element(indices.begin(), indices.end()))
+      + 1u;
+  m_vao.set_element_data(*m_ibo);
+  reset_draw_range();
+}
+
 }  // namespace hou
@@ -4,9 +4,13 @@
 
 #include "hou/gfx/mesh2.hpp"
 
+#include "hou/cor/narrow_cast.hpp"
+
 #include "hou/mth/math_functions.hpp"
 #include "hou/mth/rectangle.hpp"
 
+#include <limits>
+
 
 
 namespace hou
@@ -17,6 +21,8 @@ namespace
 
 mesh2 generic_rectangle_mesh2(
   float l, float t, float w, float h, float tl, float tt, float tw, float th);
+mesh2 indexed_mesh2(mesh_draw_mode dm, const std::vector<vertex2>& vertices,
+  const std::vector<uint32_t>& indices);
 
 
 
@@ -34,6 +40,21 @@ mesh2 generic_rectangle_mesh2(
       vertex2(vec2f(r, t), vec2f(tr, tt), color::white())});
 }
 
+
+
+mesh2 indexed_mesh2(mesh_draw_mode dm, const std::vector<vertex2>& vertices,
+  const std::vector<uint32_t>& indices)
+{
+  // 16 bit indices are used whenever possible to halve the index buffer size.
+  if(vertices.size()
+    <= static_cast<size_t>(std::numeric_limits<uint16_t>::max()) + 1u)
+  {
+    return mesh2(dm, mesh_fill_mode::fill, vertices,
+      std::vector<uint16_t>(indices.begin(), indices.end()));
+  }
+  return mesh2(dm, mesh_fill_mode::fill, vertices, indices);
+}
+
 }  // namespace
 
 
@@ -51,7 +72,7 @@ mesh2 rectangle_outline_mesh2(const vec2f& size, float thickness)
   rectf er(vec2f::zero(), size);
   vec2f tv(thickness, thickness);
   rectf ir(tv, size - 2 * tv);
-  return mesh2(mesh_draw_mode::triangle_strip, mesh_fill_mode::fill,
+  return indexed_mesh2(mesh_draw_mode::triangle_strip,
     std::vector<vertex2>{
       vertex2(vec2f(er.l(), er.t()), vec2f::zero(), color::white()),
       vertex2(vec2f(ir.l(), ir.t()), vec2f::zero(), color::white()),
@@ -60,9 +81,8 @@ mesh2 rectangle_outline_mesh2(const vec2f& size, float thickness)
       vertex2(vec2f(er.r(), er.b()), vec2f::zero(), color::white()),
       vertex2(vec2f(ir.r(), ir.b()), vec2f::zero(), color::white()),
       vertex2(vec2f(er.r(), er.t()), vec2f::zero(), color::white()),
-      vertex2(vec2f(ir.r(), ir.t()), vec2f::zero(), color::white()),
-      vertex2(vec2f(er.l(), er.t()), vec2f::zero(), color::white()),
-      vertex2(vec2f(ir.l(), ir.t()), vec2f::zero(), color::white())});
+      vertex2(vec2f(ir.r(), ir.t()), vec2f::zero(), color::white())},
+    std::vector<uint32_t>{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 0u, 1u});
 }
 
 
@@ -71,9 +91,11 @@ mesh2 ellipse_mesh2(const vec2f& size, uint point_count)
 {
   vec2f radius = size / 2.f;
 
-  std::vector<vertex2> vertices(point_count + 2);
+  std::vector<vertex2> vertices(point_count + 1);
+  std::vector<uint32_t> indices(point_count + 2);
   vertices[0].set_position(radius);
   vertices[0].set_color(color::white());
+  indices[0] = 0u;
 
   float t = 0.f;
   float dt = 2.f * pi<float>() / point_count;
@@ -82,9 +104,11 @@ mesh2 ellipse_mesh2(const vec2f& size, uint point_count)
     vec2f dPos(radius.x() * cosf(t), radius.y() * sinf(t));
     vertices[i].set_position(radius + dPos);
     vertices[i].set_color(color::white());
+    indices[i] = narrow_cast<uint32_t>(i);
     t += dt;
   }
-  return mesh2(mesh_draw_mode::triangle_fan, mesh_fill_mode::fill, vertices);
+  indices.back() = 1u;
+  return indexed_mesh2(mesh_draw_mode::triangle_fan, vertices, indices);
 }
 
 
@@ -97,7 +121,8 @@ mesh2 ellipse_outline_mesh2(
 
   float t = 0.f;
   float dt = 2 * pi<float>() / point_count;
-  std::vector<vertex2> vertices(2 * point_count + 2);
+  std::vector<vertex2> vertices(2 * point_count);
+  std::vector<uint32_t> indices(2 * point_count + 2);
   for(size_t i = 0; i < vertices.size(); ++i)
   {
     float c = cosf(t);
@@ -106,16 +131,20 @@ mesh2 ellipse_outline_mesh2(
     vec2f ed_pos(e_radius.x() * c, e_radius.y() * s);
     vertices[i].set_position(e_radius + ed_pos);
     vertices[i].set_color(color::white());
+    indices[i] = narrow_cast<uint32_t>(i);
     ++i;
     HOU_DEV_ASSERT(i < vertices.size());
 
     vec2f idPos(i_radius.x() * c, i_radius.y() * s);
     vertices[i].set_position(e_radius + idPos);
     vertices[i].set_color(color::white());
+    indices[i] = narrow_cast<uint32_t>(i);
 
     t += dt;
   }
-  return mesh2(mesh_draw_mode::triangle_strip, mesh_fill_mode::fill, vertices);
+  indices[indices.size() - 2u] = 0u;
+  indices[indices.size() - 1u] = 1u;
+  return indexed_mesh2(mesh_draw_mode::triangle_strip, vertices, indices);
 }
 
 
@@ -7,9 +7,16 @@
 #include "hou/gfx/mesh2.hpp"
 #include "hou/gfx/render_surface.hpp"
 #include "hou/gfx/shader.hpp"
+#include "hou/gfx/vertex_format.hpp"
+
+#include "hou/gl/gl_functions.hpp"
+
+#include "hou/cor/narrow_cast.hpp"
 
 #include "hou/sys/color.hpp"
 
+#include <algorithm>
+
 #define UNI_COLOR "colorUni"
 #define UNI_TEXTURE "textureUni"
 #define UNI_TRANSFORM "transformUni"
@@ -22,8 +29,16 @@ namespace hou
 namespace
 {
 
+class mesh2_instanced_program : public shader_program
+{
+public:
+  mesh2_instanced_program();
+};
+
 std::string get_gl_vertex_shader_source();
 std::string get_gl_fragment_shader_source();
+std::string get_gl_instanced_vertex_shader_source();
+std::string get_gl_instanced_fragment_shader_source();
 
 
 
@@ -66,10 +81,129 @@ std::string get_gl_fragment_shader_source()
 }
 // clang-format on
 
+
+
+// clang-format off
+std::string get_gl_instanced_vertex_shader_source()
+{
+  return
+    "#version 330 core\n"
+    "layout (location = 0) in vec2 posIn;\n"
+    "layout (location = 1) in vec2 texIn;\n"
+    "layout (location = 2) in vec4 colorIn;\n"
+    "layout (location = 3) in vec3 transformRow0In;\n"
+    "layout (location = 4) in vec3 transformRow1In;\n"
+    "layout (location = 5) in vec4 instanceColorIn;\n"
+    "out vec2 texVs;\n"
+    "out vec4 colorVs;\n"
+    "void main()\n"
+    "{\n"
+      "texVs = texIn;\n"
+      "colorVs = instanceColorIn * colorIn;\n"
+      "vec3 pos = vec3(posIn, 1.f);\n"
+      "gl_Position = vec4(dot(transformRow0In, pos), dot(transformRow1In, pos),"
+        " 0.f, 1.f);\n"
+    "}\n";
+}
+// clang-format on
+
+
+
+// clang-format off
+std::string get_gl_instanced_fragment_shader_source()
+{
+  return
+    "#version 330 core\n"
+    "in vec2 texVs;\n"
+    "in vec4 colorVs;\n"
+    "out vec4 color;\n"
+    "uniform sampler2D " UNI_TEXTURE ";\n"
+    "void main()\n"
+    "{\n"
+      "color = colorVs * texture(" UNI_TEXTURE ", texVs);\n"
+    "}\n";
+}
+// clang-format on
+
+
+
+mesh2_instanced_program::mesh2_instanced_program()
+  : shader_program(vertex_shader(get_gl_instanced_vertex_shader_source()),
+      fragment_shader(get_gl_instanced_fragment_shader_source()))
+{}
+
 }  // namespace
 
 
 
+const vertex_format& mesh2_renderer::instance_data::get_vertex_format()
+{
+  static constexpr bool must_be_normalized = true;
+  static const vertex_format vf(0, sizeof(instance_data),
+    {vertex_attrib_format(gl_type::float_decimal, 3u,
+       offsetof(instance_data, m_transform_row0), !must_be_normalized),
+      vertex_attrib_format(gl_type::float_decimal, 3u,
+        offsetof(instance_data, m_transform_row1), !must_be_normalized),
+      vertex_attrib_format(gl_type::float_decimal, 4u,
+        offsetof(instance_data, m_color), must_be_normalized)});
+  return vf;
+}
+
+
+
+mesh2_renderer::instance_data::instance_data() noexcept
+  : instance_data(trans2f::identity(), color::white())
+{}
+
+
+
+mesh2_renderer::instance_data::instance_data(
+  const trans2f& trn, const color& col) noexcept
+  : m_transform_row0{0.f, 0.f, 0.f}
+  , m_transform_row1{0.f, 0.f, 0.f}
+  , m_color{0.f, 0.f, 0.f, 0.f}
+{
+  set_transform(trn);
+  set_color(col);
+}
+
+
+
+void mesh2_renderer::instance_data::set_transform(const trans2f& trn) noexcept
+{
+  mat4x4f m = trn.to_mat4x4();
+  m_transform_row0[0] = m(0, 0);
+  m_transform_row0[1] = m(0, 1);
+  m_transform_row0[2] = m(0, 3);
+  m_transform_row1[0] = m(1, 0);
+  m_transform_row1[1] = m(1, 1);
+  m_transform_row1[2] = m(1, 3);
+}
+
+
+
+color mesh2_renderer::instance_data::get_color() const noexcept
+{
+  color col(0u, 0u, 0u, 0u);
+  col.set_red_f(m_color[0]);
+  col.set_green_f(m_color[1]);
+  col.set_blue_f(m_color[2]);
+  col.set_alpha_f(m_color[3]);
+  return col;
+}
+
+
+
+void mesh2_renderer::instance_data::set_color(const color& col) noexcept
+{
+  m_color[0] = col.get_red_f();
+  m_color[1] = col.get_green_f();
+  m_color[2] = col.get_blue_f();
+  m_color[3] = col.get_alpha_f();
+}
+
+
+
 mesh2_renderer::mesh2_renderer()
   : shader_program(vertex_shader(get_gl_vertex_shader_source()),
       fragment_shader(get_gl_fragment_shader_source()))
@@ -77,6 +211,11 @@ mesh2_renderer::mesh2_renderer()
   , m_uni_color(get_uniform_location(UNI_COLOR))
   , m_uni_texture(get_uniform_location(UNI_TEXTURE))
   , m_uni_transform(get_uniform_location(UNI_TRANSFORM))
+  , m_instanced_program(std::make_unique<mesh2_instanced_program>())
+  , m_uni_instanced_texture(
+      m_instanced_program->get_uniform_location(UNI_TEXTURE))
+  , m_instance_vbo(nullptr)
+  , m_instance_vao()
 {
   m_blank_texture.set_image(
     image2_rgba(m_blank_texture.get_size(), pixel_rgba(color::white())));
@@ -110,14 +249,7 @@ void mesh2_renderer::set_transform(const trans2f& trans)
 void mesh2_renderer::draw(render_surface& target, const mesh2& m,
   const texture2& tex, const color& col, const trans2f& trn)
 {
-  static constexpr uint texUnit = 0u;
-  render_surface::set_current_render_target(target);
-  set_color(col);
-  set_texture_unit(texUnit);
-  set_transform(trn);
-  bind(*this);
-  texture::bind(tex, texUnit);
-  mesh::draw(m);
+  draw_mesh(target, m, tex, col, trn);
 }
 
 void mesh2_renderer::draw(
@@ -138,4 +270,128 @@ void mesh2_renderer::draw(
   draw(target, m, m_blank_texture, color::white(), trn);
 }
 
+
+
+void mesh2_renderer::draw(render_surface& target, const dynamic_mesh2& m,
+  const texture2& tex, const color& col, const trans2f& trn)
+{
+  draw_mesh(target, m, tex, col, trn);
+}
+
+void mesh2_renderer::draw(render_surface& target, const dynamic_mesh2& m,
+  const color& col, const trans2f& trn)
+{
+  draw(target, m, m_blank_texture, col, trn);
+}
+
+void mesh2_renderer::draw(render_surface& target, const dynamic_mesh2& m,
+  const texture2& tex, const trans2f& trn)
+{
+  draw(target, m, tex, color::white(), trn);
+}
+
+void mesh2_renderer::draw(
+  render_surface& target, const dynamic_mesh2& m, const trans2f& trn)
+{
+  draw(target, m, m_blank_texture, color::white(), trn);
+}
+
+
+
+void mesh2_renderer::draw_instanced(render_surface& target, const mesh2& m,
+  const texture2& tex, const span<const instance_data>& instances)
+{
+  if(instances.size() == 0u)
+  {
+    return;
+  }
+
+  reserve_instance_buffer(instances.size());
+  m_instance_vbo->set_sub_data(0u, instances);
+  m_instance_vao.set_vertex_data(
+    m.get_vertex_buffer(), 0u, vertex2::get_vertex_format());
+  if(m.is_indexed())
+  {
+    m_instance_vao.set_element_data(*m.get_index_buffer());
+  }
+
+  static constexpr uint tex_unit = 0u;
+  render_surface::set_current_render_target(target);
+  gl::set_program_uniform_i(
+    m_instanced_program->get_handle(), m_uni_instanced_texture, tex_unit);
+  bind(*m_instanced_program);
+  texture::bind(tex, tex_unit);
+  vertex_array::bind(m_instance_vao);
+  gl::set_polygon_mode(
+    GL_FRONT_AND_BACK, static_cast<GLenum>(m.get_fill_mode()));
+  if(m.is_indexed())
+  {
+    gl::draw_elements_instanced(static_cast<GLenum>(m.get_draw_mode()),
+      narrow_cast<GLsizei>(m.get_draw_count()),
+      static_cast<GLenum>(m.get_index_type()),
+      narrow_cast<GLintptr>(
+        m.get_draw_first() * get_gl_type_byte_size(m.get_index_type())),
+      narrow_cast<GLsizei>(instances.size()));
+  }
+  else
+  {
+    gl::draw_arrays_instanced(static_cast<GLenum>(m.get_draw_mode()),
+      narrow_cast<GLint>(m.get_draw_first()),
+      narrow_cast<GLsizei>(m.get_draw_count()),
+      narrow_cast<GLsizei>(instances.size()));
+  }
+}
+
+
+
+void mesh2_renderer::draw_instanced(render_surface& target, const mesh2& m,
+  const span<const instance_data>& instances)
+{
+  draw_instanced(target, m, m_blank_texture, instances);
+}
+
+
+
+size_t mesh2_renderer::get_instance_capacity() const noexcept
+{
+  return m_instance_vbo == nullptr ? 0u : m_instance_vbo->get_size();
+}
+
+
+
+void mesh2_renderer::draw_mesh(render_surface& target, const mesh& m,
+  const texture2& tex, const color& col, const trans2f& trn)
+{
+  static constexpr uint texUnit = 0u;
+  render_surface::set_current_render_target(target);
+  set_color(col);
+  set_texture_unit(texUnit);
+  set_transform(trn);
+  bind(*this);
+  texture::bind(tex, texUnit);
+  mesh::draw(m);
+}
+
+
+
+void mesh2_renderer::reserve_instance_buffer(size_t instance_count)
+{
+  if(m_instance_vbo != nullptr && m_instance_vbo->get_size() >= instance_count)
+  {
+    return;
+  }
+  size_t new_size = m_instance_vbo == nullptr
+    ? instance_count
+    : std::max(instance_count, 2u * m_instance_vbo->get_size());
+  m_instance_vbo
+    = std::make_unique<dynamic_vertex_buffer<instance_data>>(new_size);
+  static constexpr uint instance_binding_index = 1u;
+  static constexpr uint instance_divisor = 1u;
+  m_instance_vao.set_vertex_data(*m_instance_vbo, instance_binding_index,
+    instance_data::get_vertex_format(),
+    narrow_cast<uint>(
+      vertex2::get_vertex_format().get_vertex_attrib_formats().size()),
+    instance_divisor);
+}
+
 }  // namespace hou
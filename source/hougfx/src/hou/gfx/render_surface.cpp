@@ -9,6 +9,8 @@
 
 #include "hou/cor/narrow_cast.hpp"
 
+#include "hou/gl/gl_exceptions.hpp"
+#include "hou/gl/gl_frame_stats.hpp"
 #include "hou/gl/gl_functions.hpp"
 
 #include "hou/sys/color.hpp"
@@ -179,7 +181,9 @@ void render_surface::display() const
     wnd_size.x(), 0,
     GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT,
     GL_NEAREST);
+  HOU_GL_CHECK_FRAME_ERROR();
   wnd->swap_buffers();
+  gl::end_frame_stats();
 }
 
 
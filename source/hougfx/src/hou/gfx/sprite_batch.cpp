@@ -0,0 +1,352 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gfx/sprite_batch.hpp"
+
+#include "hou/gfx/mesh_draw_mode.hpp"
+#include "hou/gfx/mesh_fill_mode.hpp"
+#include "hou/gfx/render_surface.hpp"
+#include "hou/gfx/shader.hpp"
+
+#include "hou/gl/gl_functions.hpp"
+
+#include "hou/cor/narrow_cast.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#define UNI_TEXTURE "textureUni"
+
+
+
+namespace hou
+{
+
+namespace
+{
+
+std::string get_gl_vertex_shader_source();
+std::string get_gl_fragment_shader_source();
+color modulate(const color& lhs, const color& rhs);
+
+
+
+// clang-format off
+std::string get_gl_vertex_shader_source()
+{
+  return
+    "#version 330 core\n"
+    "layout (location = 0) in vec2 posIn;\n"
+    "layout (location = 1) in vec2 texIn;\n"
+    "layout (location = 2) in vec4 colorIn;\n"
+    "out vec2 texVs;\n"
+    "out vec4 colorVs;\n"
+    "void main()\n"
+    "{\n"
+      "texVs = texIn;\n"
+      "colorVs = colorIn;\n"
+      "gl_Position = vec4(posIn, 0.f, 1.f);\n"
+    "}\n";
+}
+// clang-format on
+
+
+
+// clang-format off
+std::string get_gl_fragment_shader_source()
+{
+  return
+    "#version 330 core\n"
+    "in vec2 texVs;\n"
+    "in vec4 colorVs;\n"
+    "out vec4 color;\n"
+    "uniform sampler2D " UNI_TEXTURE ";\n"
+    "void main()\n"
+    "{\n"
+      "color = colorVs * texture(" UNI_TEXTURE ", texVs);\n"
+    "}\n";
+}
+// clang-format on
+
+
+
+color modulate(const color& lhs, const color& rhs)
+{
+  color out(0u, 0u, 0u, 0u);
+  out.set_red_f(lhs.get_red_f() * rhs.get_red_f());
+  out.set_green_f(lhs.get_green_f() * rhs.get_green_f());
+  out.set_blue_f(lhs.get_blue_f() * rhs.get_blue_f());
+  out.set_alpha_f(lhs.get_alpha_f() * rhs.get_alpha_f());
+  return out;
+}
+
+}  // namespace
+
+
+
+sprite_batch::sprite_batch(size_t vertex_capacity, size_t buffer_count)
+  : shader_program(vertex_shader(get_gl_vertex_shader_source()),
+      fragment_shader(get_gl_fragment_shader_source()))
+  , m_blank_texture(vec2u(1u, 1u), texture_format::rgba, 1u)
+  , m_vertices()
+  , m_sorted_vertices()
+  , m_runs()
+  , m_buffers(buffer_count)
+  , m_current_buffer(0u)
+  , m_sorting_by_texture(false)
+  , m_uni_texture(get_uniform_location(UNI_TEXTURE))
+{
+  HOU_PRECOND(buffer_count > 0u);
+  m_blank_texture.set_image(
+    image2_rgba(m_blank_texture.get_size(), pixel_rgba(color::white())));
+  for(auto& sb : m_buffers)
+  {
+    reserve_buffer(sb, std::max<size_t>(1u, vertex_capacity));
+  }
+}
+
+
+
+void sprite_batch::add_quad(const texture2& tex, const vec2f& size,
+  const color& col, const trans2f& trn)
+{
+  begin_run(tex, 6u);
+  add_vertex(vec2f(0.f, 0.f), vec2f(0.f, 0.f), col, trn);
+  add_vertex(vec2f(0.f, size.y()), vec2f(0.f, 1.f), col, trn);
+  add_vertex(vec2f(size.x(), size.y()), vec2f(1.f, 1.f), col, trn);
+  add_vertex(vec2f(0.f, 0.f), vec2f(0.f, 0.f), col, trn);
+  add_vertex(vec2f(size.x(), size.y()), vec2f(1.f, 1.f), col, trn);
+  add_vertex(vec2f(size.x(), 0.f), vec2f(1.f, 0.f), col, trn);
+}
+
+
+
+void sprite_batch::add_quad(const texture2& tex, const rectf& tex_rect,
+  const color& col, const trans2f& trn)
+{
+  vec2f tex_size = static_cast<vec2f>(tex.get_size());
+  float w = tex_rect.w();
+  float h = tex_rect.h();
+  float tl = tex_rect.l() / tex_size.x();
+  float tt = tex_rect.t() / tex_size.y();
+  float tr = tex_rect.r() / tex_size.x();
+  float tb = tex_rect.b() / tex_size.y();
+
+  begin_run(tex, 6u);
+  add_vertex(vec2f(0.f, 0.f), vec2f(tl, tt), col, trn);
+  add_vertex(vec2f(0.f, h), vec2f(tl, tb), col, trn);
+  add_vertex(vec2f(w, h), vec2f(tr, tb), col, trn);
+  add_vertex(vec2f(0.f, 0.f), vec2f(tl, tt), col, trn);
+  add_vertex(vec2f(w, h), vec2f(tr, tb), col, trn);
+  add_vertex(vec2f(w, 0.f), vec2f(tr, tt), col, trn);
+}
+
+
+
+void sprite_batch::add_quad(
+  const vec2f& size, const color& col, const trans2f& trn)
+{
+  add_quad(m_blank_texture, size, col, trn);
+}
+
+
+
+void sprite_batch::add_triangles(const texture2& tex,
+  const span<const vertex2>& vertices, const color& col, const trans2f& trn)
+{
+  HOU_PRECOND(vertices.size() % 3u == 0u);
+  if(vertices.size() == 0u)
+  {
+    return;
+  }
+
+  begin_run(tex, vertices.size());
+  for(const auto& v : vertices)
+  {
+    add_vertex(v.get_position(), v.get_texture_coordinates(),
+      modulate(v.get_color(), col), trn);
+  }
+}
+
+
+
+void sprite_batch::add_triangles(
+  const span<const vertex2>& vertices, const color& col, const trans2f& trn)
+{
+  add_triangles(m_blank_texture, vertices, col, trn);
+}
+
+
+
+void sprite_batch::draw(render_surface& target)
+{
+  if(m_vertices.empty())
+  {
+    return;
+  }
+
+  if(m_sorting_by_texture)
+  {
+    sort_runs();
+  }
+
+  stream_buffer& sb = m_buffers[m_current_buffer];
+  m_current_buffer = (m_current_buffer + 1u) % m_buffers.size();
+  reserve_buffer(sb, m_vertices.size());
+  sb.vbo->set_sub_data(0u, m_vertices);
+
+  static constexpr uint tex_unit = 0u;
+  render_surface::set_current_render_target(target);
+  gl::set_program_uniform_i(get_handle(), m_uni_texture, tex_unit);
+  bind(*this);
+  vertex_array::bind(sb.vao);
+  gl::set_polygon_mode(
+    GL_FRONT_AND_BACK, static_cast<GLenum>(mesh_fill_mode::fill));
+  for(const auto& r : m_runs)
+  {
+    texture::bind(*r.tex, tex_unit);
+    gl::draw_arrays(static_cast<GLenum>(mesh_draw_mode::triangles),
+      narrow_cast<GLint>(r.first), narrow_cast<GLsizei>(r.count));
+  }
+
+  clear();
+}
+
+
+
+void sprite_batch::clear()
+{
+  m_vertices.clear();
+  m_runs.clear();
+}
+
+
+
+void sprite_batch::set_sorting_by_texture(bool value) noexcept
+{
+  m_sorting_by_texture = value;
+}
+
+
+
+bool sprite_batch::is_sorting_by_texture() const noexcept
+{
+  return m_sorting_by_texture;
+}
+
+
+
+size_t sprite_batch::get_vertex_count() const noexcept
+{
+  return m_vertices.size();
+}
+
+
+
+size_t sprite_batch::get_vertex_capacity() const noexcept
+{
+  return m_buffers[m_current_buffer].vbo->get_size();
+}
+
+
+
+size_t sprite_batch::get_buffer_count() const noexcept
+{
+  return m_buffers.size();
+}
+
+
+
+size_t sprite_batch::get_draw_call_count() const
+{
+  if(!m_sorting_by_texture)
+  {
+    return m_runs.size();
+  }
+
+  std::vector<const texture2*> textures;
+  textures.reserve(m_runs.size());
+  for(const auto& r : m_runs)
+  {
+    textures.push_back(r.tex);
+  }
+  std::sort(textures.begin(), textures.end(), std::less<const texture2*>());
+  return std::distance(textures.begin(),
+    std::unique(textures.begin(), textures.end()));
+}
+
+
+
+void sprite_batch::add_vertex(const vec2f& pos, const vec2f& tex_coords,
+  const color& col, const trans2f& trn)
+{
+  m_vertices.push_back(vertex2(trn.transform_point(pos), tex_coords, col));
+}
+
+
+
+void sprite_batch::begin_run(const texture2& tex, size_t vertex_count)
+{
+  if(m_runs.empty() || m_runs.back().tex != &tex)
+  {
+    m_runs.push_back(run{&tex, m_vertices.size(), 0u});
+  }
+  m_runs.back().count += vertex_count;
+}
+
+
+
+void sprite_batch::sort_runs()
+{
+  // The sort is stable, so that sprites with the same texture keep their
+  // relative order. Runs with the same texture are then merged.
+  std::stable_sort(m_runs.begin(), m_runs.end(),
+    [](const run& lhs, const run& rhs) {
+      return std::less<const texture2*>()(lhs.tex, rhs.tex);
+    });
+
+  m_sorted_vertices.clear();
+  m_sorted_vertices.reserve(m_vertices.size());
+  std::vector<run>::iterator merged = m_runs.begin();
+  for(auto it = m_runs.begin(); it != m_runs.end(); ++it)
+  {
+    run r = *it;
+    auto src = m_vertices.begin() + r.first;
+    r.first = m_sorted_vertices.size();
+    m_sorted_vertices.insert(m_sorted_vertices.end(), src, src + r.count);
+    if(it != m_runs.begin() && merged->tex == r.tex)
+    {
+      merged->count += r.count;
+    }
+    else
+    {
+      if(it != m_runs.begin())
+      {
+        ++merged;
+      }
+      *merged = r;
+    }
+  }
+  m_runs.erase(merged + 1, m_runs.end());
+  std::swap(m_vertices, m_sorted_vertices);
+}
+
+
+
+void sprite_batch::reserve_buffer(stream_buffer& sb, size_t vertex_count)
+{
+  // Buffers grow geometrically and never shrink, so that a stable number of
+  // sprites causes no reallocations.
+  if(sb.vbo != nullptr && sb.vbo->get_size() >= vertex_count)
+  {
+    return;
+  }
+  size_t new_size = sb.vbo == nullptr
+    ? vertex_count
+    : std::max(vertex_count, 2u * sb.vbo->get_size());
+  sb.vbo = std::make_unique<dynamic_vertex_buffer<vertex2>>(new_size);
+  sb.vao.set_vertex_data(*sb.vbo, 0u, vertex2::get_vertex_format());
+}
+
+}  // namespace hou
@@ -0,0 +1,231 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gfx/text_batch.hpp"
+
+#include "hou/gfx/formatted_text.hpp"
+#include "hou/gfx/mesh_draw_mode.hpp"
+#include "hou/gfx/mesh_fill_mode.hpp"
+#include "hou/gfx/render_surface.hpp"
+#include "hou/gfx/shader.hpp"
+#include "hou/gfx/texture.hpp"
+#include "hou/gfx/vertex_format.hpp"
+
+#include "hou/gl/gl_functions.hpp"
+
+#include "hou/cor/narrow_cast.hpp"
+
+#include <algorithm>
+
+#define UNI_TEXTURE "textureUni"
+
+
+
+namespace hou
+{
+
+namespace
+{
+
+std::string get_gl_vertex_shader_source();
+std::string get_gl_fragment_shader_source();
+
+
+
+// clang-format off
+std::string get_gl_vertex_shader_source()
+{
+  return
+    "#version 330 core\n"
+    "layout (location = 0) in vec2 posIn;\n"
+    "layout (location = 1) in vec3 texIn;\n"
+    "layout (location = 2) in vec4 colorIn;\n"
+    "out vec3 texVs;\n"
+    "out vec4 colorVs;\n"
+    "void main()\n"
+    "{\n"
+      "texVs = texIn;\n"
+      "colorVs = colorIn;\n"
+      "gl_Position = vec4(posIn, 0.f, 1.f);\n"
+    "}\n";
+}
+// clang-format on
+
+
+
+// clang-format off
+std::string get_gl_fragment_shader_source()
+{
+  return
+    "#version 330 core\n"
+    "in vec3 texVs;\n"
+    "in vec4 colorVs;\n"
+    "out vec4 color;\n"
+    "uniform sampler2DArray " UNI_TEXTURE
+    ";\n"
+    "void main()\n"
+    "{\n"
+      "color = colorVs * texture(" UNI_TEXTURE ", texVs);\n"
+    "}\n";
+}
+// clang-format on
+
+}  // namespace
+
+
+
+text_batch::text_batch(size_t vertex_capacity)
+  : shader_program(vertex_shader(get_gl_vertex_shader_source()),
+      fragment_shader(get_gl_fragment_shader_source()))
+  , m_vertices()
+  , m_indices()
+  , m_runs()
+  , m_vbo(nullptr)
+  , m_ibo(nullptr)
+  , m_vao()
+  , m_uni_texture(get_uniform_location(UNI_TEXTURE))
+{
+  reserve_buffers(std::max<size_t>(1u, vertex_capacity),
+    std::max<size_t>(1u, vertex_capacity * 3u / 2u));
+}
+
+
+
+void text_batch::add(
+  const formatted_text& text, const color& col, const trans2f& trn)
+{
+  const formatted_text::VertexContainer& text_vertices = text.get_vertices();
+  const formatted_text::IndexContainer& text_indices = text.get_indices();
+  if(text_indices.empty())
+  {
+    return;
+  }
+
+  const texture2_array* atlas = &text.get_atlas();
+  if(m_runs.empty() || m_runs.back().atlas != atlas)
+  {
+    m_runs.push_back(run{atlas, m_indices.size(), 0u});
+  }
+  m_runs.back().count += text_indices.size();
+
+  uint32_t base = narrow_cast<uint32_t>(m_vertices.size());
+  for(auto i : text_indices)
+  {
+    m_indices.push_back(base + i);
+  }
+
+  const GLfloat r = col.get_red_f();
+  const GLfloat g = col.get_green_f();
+  const GLfloat b = col.get_blue_f();
+  const GLfloat a = col.get_alpha_f();
+  for(const auto& tv : text_vertices)
+  {
+    vec2f pos = trn.transform_point(tv.get_position());
+    vec3f tex = tv.get_texture_coordinates();
+    m_vertices.push_back(vertex{{pos.x(), pos.y()},
+      {tex.x(), tex.y(), tex.z()}, {r, g, b, a}});
+  }
+}
+
+
+
+void text_batch::draw(render_surface& target)
+{
+  if(m_vertices.empty())
+  {
+    return;
+  }
+
+  static constexpr uint tex_unit = 0u;
+  reserve_buffers(m_vertices.size(), m_indices.size());
+  m_vbo->set_sub_data(0u, m_vertices);
+  m_ibo->set_sub_data(0u, m_indices);
+
+  render_surface::set_current_render_target(target);
+  gl::set_program_uniform_i(get_handle(), m_uni_texture, tex_unit);
+  bind(*this);
+  vertex_array::bind(m_vao);
+  gl::set_polygon_mode(
+    GL_FRONT_AND_BACK, static_cast<GLenum>(mesh_fill_mode::fill));
+  for(const auto& r : m_runs)
+  {
+    texture::bind(*r.atlas, tex_unit);
+    gl::draw_elements(static_cast<GLenum>(mesh_draw_mode::triangles),
+      narrow_cast<GLsizei>(r.count), GL_UNSIGNED_INT,
+      narrow_cast<GLintptr>(r.first * sizeof(uint32_t)));
+  }
+
+  clear();
+}
+
+
+
+void text_batch::clear()
+{
+  m_vertices.clear();
+  m_indices.clear();
+  m_runs.clear();
+}
+
+
+
+size_t text_batch::get_vertex_count() const noexcept
+{
+  return m_vertices.size();
+}
+
+
+
+size_t text_batch::get_vertex_capacity() const noexcept
+{
+  return m_vbo->get_size();
+}
+
+
+
+size_t text_batch::get_draw_call_count() const noexcept
+{
+  return m_runs.size();
+}
+
+
+
+const vertex_format& text_batch::get_vertex_format()
+{
+  static constexpr bool must_be_normalized = true;
+  static const vertex_format vf(0, sizeof(vertex),
+    {vertex_attrib_format(gl_type::float_decimal, 2u,
+       offsetof(vertex, position), !must_be_normalized),
+      vertex_attrib_format(gl_type::float_decimal, 3u,
+        offsetof(vertex, tex_coords), !must_be_normalized),
+      vertex_attrib_format(gl_type::float_decimal, 4u, offsetof(vertex, color),
+        !must_be_normalized)});
+  return vf;
+}
+
+
+
+void text_batch::reserve_buffers(size_t vertex_count, size_t index_count)
+{
+  // The buffers grow geometrically and never shrink, so that a stable
+  // number of texts causes no reallocations.
+  if(m_vbo == nullptr || m_vbo->get_size() < vertex_count)
+  {
+    size_t new_size = m_vbo == nullptr
+      ? vertex_count
+      : std::max(vertex_count, 2u * m_vbo->get_size());
+    m_vbo = std::make_unique<dynamic_vertex_buffer<vertex>>(new_size);
+    m_vao.set_vertex_data(*m_vbo, 0u, get_vertex_format());
+  }
+  if(m_ibo == nullptr || m_ibo->get_size() < index_count)
+  {
+    size_t new_size = m_ibo == nullptr
+      ? index_count
+      : std::max(index_count, 2u * m_ibo->get_size());
+    m_ibo = std::make_unique<dynamic_vertex_buffer<uint32_t>>(new_size);
+    m_vao.set_element_data(*m_ibo);
+  }
+}
+
+}  // namespace hou
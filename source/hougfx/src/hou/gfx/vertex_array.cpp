@@ -59,8 +59,9 @@ bool vertex_array::is_bound() const
 
 #if defined(HOU_GL_ES)
 
-void vertex_array::set_vertex_data(
-  const vertex_buffer& vb, uint binding_index, const vertex_format& vf)
+void vertex_array::set_vertex_data(const vertex_buffer& vb,
+  uint binding_index, const vertex_format& vf, uint first_attrib_index,
+  uint divisor)
 {
   HOU_PRECOND(binding_index <= get_max_binding_index());
 
@@ -71,7 +72,8 @@ void vertex_array::set_vertex_data(
     = vf.get_vertex_attrib_formats();
   for(GLuint i = 0; i < vafs.size(); ++i)
   {
-    gl::set_vertex_attrib_pointer(i,
+    GLuint attrib_index = narrow_cast<GLuint>(first_attrib_index + i);
+    gl::set_vertex_attrib_pointer(attrib_index,
       narrow_cast<GLint>(vafs[i].get_element_count()),
       static_cast<GLenum>(vafs[i].get_type()),
       vafs[i].must_be_normalized() ? GL_TRUE : GL_FALSE,
@@ -80,7 +82,9 @@ void vertex_array::set_vertex_data(
       reinterpret_cast<GLvoid*>(
         (vf.get_byte_offset() + vafs[i].get_byte_offset())
         * get_gl_type_byte_size(vafs[i].get_type())));
-    gl::enable_vertex_array_attrib(i);
+    gl::set_vertex_attrib_divisor(
+      attrib_index, narrow_cast<GLuint>(divisor));
+    gl::enable_vertex_array_attrib(attrib_index);
   }
 }
 
@@ -94,8 +98,9 @@ void vertex_array::set_element_data(const vertex_buffer& eb)
 
 #else
 
-void vertex_array::set_vertex_data(
-  const vertex_buffer& vb, uint binding_index, const vertex_format& vf)
+void vertex_array::set_vertex_data(const vertex_buffer& vb,
+  uint binding_index, const vertex_format& vf, uint first_attrib_index,
+  uint divisor)
 {
   HOU_PRECOND(binding_index <= get_max_binding_index());
 
@@ -103,19 +108,22 @@ void vertex_array::set_vertex_data(
     narrow_cast<GLuint>(binding_index), vb.get_handle(),
     narrow_cast<GLintptr>(vf.get_byte_offset()),
     narrow_cast<GLsizei>(vf.get_stride()));
+  gl::set_vertex_array_binding_divisor(m_handle,
+    narrow_cast<GLuint>(binding_index), narrow_cast<GLuint>(divisor));
 
   const std::vector<vertex_attrib_format>& vafs
     = vf.get_vertex_attrib_formats();
   for(GLuint i = 0; i < vafs.size(); ++i)
   {
-    gl::set_vertex_array_attrib_format(m_handle, i,
+    GLuint attrib_index = narrow_cast<GLuint>(first_attrib_index + i);
+    gl::set_vertex_array_attrib_format(m_handle, attrib_index,
       narrow_cast<GLint>(vafs[i].get_element_count()),
       static_cast<GLenum>(vafs[i].get_type()),
       vafs[i].must_be_normalized() ? GL_TRUE : GL_FALSE,
       narrow_cast<GLuint>(vafs[i].get_byte_offset()));
     gl::set_vertex_array_attrib_binding(
-      m_handle, narrow_cast<GLuint>(i), narrow_cast<GLuint>(binding_index));
-    gl::enable_vertex_array_attrib(m_handle, i);
+      m_handle, attrib_index, narrow_cast<GLuint>(binding_index));
+    gl::enable_vertex_array_attrib(m_handle, attrib_index);
   }
 }
 
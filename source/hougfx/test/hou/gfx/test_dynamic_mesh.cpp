@@ -0,0 +1,214 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gfx/test_gfx_base.hpp"
+#include "hou/test.hpp"
+
+#include "hou/cor/std_vector.hpp"
+
+#include "hou/gfx/mesh2.hpp"
+
+#include "hou/sys/color.hpp"
+
+using namespace hou;
+
+
+
+namespace
+{
+
+class test_dynamic_mesh : public test_gfx_base
+{};
+
+class test_dynamic_mesh_death_test : public test_dynamic_mesh
+{};
+
+std::vector<vertex2> generate_vertices(size_t count, float offset = 0.f);
+
+
+
+std::vector<vertex2> generate_vertices(size_t count, float offset)
+{
+  std::vector<vertex2> vertices;
+  for(size_t i = 0; i < count; ++i)
+  {
+    float value = offset + static_cast<float>(i);
+    vertices.push_back(
+      vertex2(vec2f(value, value), vec2f(value, 0.f), color::white()));
+  }
+  return vertices;
+}
+
+}  // namespace
+
+
+
+TEST_F(test_dynamic_mesh, constructor)
+{
+  std::vector<vertex2> vertices_ref = generate_vertices(3u);
+  dynamic_mesh2 m(
+    mesh_draw_mode::triangles, mesh_fill_mode::line, vertices_ref);
+
+  EXPECT_EQ(mesh_draw_mode::triangles, m.get_draw_mode());
+  EXPECT_EQ(mesh_fill_mode::line, m.get_fill_mode());
+  EXPECT_EQ(3u, m.get_vertex_count());
+  EXPECT_EQ(3u, m.get_vertex_capacity());
+  EXPECT_EQ(vertices_ref, m.get_vertices());
+  EXPECT_FALSE(m.is_indexed());
+  EXPECT_EQ(0u, m.get_draw_first());
+  EXPECT_EQ(3u, m.get_draw_count());
+}
+
+
+
+TEST_F(test_dynamic_mesh, empty_constructor)
+{
+  dynamic_mesh2 m(mesh_draw_mode::triangles, mesh_fill_mode::fill,
+    std::vector<vertex2>());
+
+  EXPECT_EQ(0u, m.get_vertex_count());
+  EXPECT_EQ(1u, m.get_vertex_capacity());
+  EXPECT_TRUE(m.get_vertices().empty());
+}
+
+
+
+TEST_F(test_dynamic_mesh, indexed_constructor)
+{
+  std::vector<vertex2> vertices_ref = generate_vertices(3u);
+  std::vector<uint16_t> indices{0u, 1u, 2u, 2u, 1u, 0u};
+  dynamic_mesh2 m(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices_ref, indices);
+
+  EXPECT_EQ(vertices_ref, m.get_vertices());
+  EXPECT_TRUE(m.is_indexed());
+  EXPECT_EQ(6u, m.get_index_count());
+  EXPECT_EQ(0u, m.get_draw_first());
+  EXPECT_EQ(6u, m.get_draw_count());
+}
+
+
+
+TEST_F(test_dynamic_mesh_death_test, indexed_constructor_error_index_overflow)
+{
+  std::vector<vertex2> vertices = generate_vertices(3u);
+  std::vector<uint16_t> indices_16{0u, 1u, 3u};
+  std::vector<uint32_t> indices_32{0u, 1u, 3u};
+
+  EXPECT_PRECOND_ERROR(dynamic_mesh2(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices, indices_16));
+  EXPECT_PRECOND_ERROR(dynamic_mesh2(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices, indices_32));
+}
+
+
+
+TEST_F(test_dynamic_mesh, set_vertices_grow)
+{
+  dynamic_mesh2 m(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, generate_vertices(3u));
+
+  std::vector<vertex2> vertices_ref = generate_vertices(4u, 1.f);
+  m.set_vertices(vertices_ref);
+  EXPECT_EQ(4u, m.get_vertex_count());
+  EXPECT_EQ(6u, m.get_vertex_capacity());
+  EXPECT_EQ(vertices_ref, m.get_vertices());
+  EXPECT_EQ(4u, m.get_draw_count());
+
+  vertices_ref = generate_vertices(9u, 2.f);
+  m.set_vertices(vertices_ref);
+  EXPECT_EQ(9u, m.get_vertex_count());
+  EXPECT_EQ(12u, m.get_vertex_capacity());
+  EXPECT_EQ(vertices_ref, m.get_vertices());
+}
+
+
+
+TEST_F(test_dynamic_mesh, set_vertices_never_shrinks)
+{
+  dynamic_mesh2 m(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, generate_vertices(6u));
+
+  std::vector<vertex2> vertices_ref = generate_vertices(3u, 1.f);
+  m.set_vertices(vertices_ref);
+  EXPECT_EQ(3u, m.get_vertex_count());
+  EXPECT_EQ(6u, m.get_vertex_capacity());
+  EXPECT_EQ(vertices_ref, m.get_vertices());
+  EXPECT_EQ(3u, m.get_draw_count());
+}
+
+
+
+TEST_F(test_dynamic_mesh_death_test, set_vertices_error_indexed_vertices)
+{
+  std::vector<uint16_t> indices{0u, 1u, 3u, 3u, 1u, 0u};
+  dynamic_mesh2 m(mesh_draw_mode::triangles, mesh_fill_mode::fill,
+    generate_vertices(4u), indices);
+  m.set_vertices(generate_vertices(5u));
+  EXPECT_PRECOND_ERROR(m.set_vertices(generate_vertices(3u)));
+  EXPECT_EQ(5u, m.get_vertex_count());
+}
+
+
+
+TEST_F(test_dynamic_mesh, set_sub_vertices)
+{
+  std::vector<vertex2> vertices_ref = generate_vertices(4u);
+  dynamic_mesh2 m(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices_ref);
+
+  std::vector<vertex2> sub_vertices = generate_vertices(2u, 10.f);
+  m.set_sub_vertices(1u, sub_vertices);
+  vertices_ref[1u] = sub_vertices[0u];
+  vertices_ref[2u] = sub_vertices[1u];
+  EXPECT_EQ(vertices_ref, m.get_vertices());
+  EXPECT_EQ(4u, m.get_vertex_capacity());
+}
+
+
+
+TEST_F(test_dynamic_mesh_death_test, set_sub_vertices_error_overflow)
+{
+  dynamic_mesh2 m(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, generate_vertices(6u));
+  m.set_vertices(generate_vertices(3u));
+  EXPECT_PRECOND_ERROR(m.set_sub_vertices(2u, generate_vertices(2u)));
+}
+
+
+
+TEST_F(test_dynamic_mesh, set_draw_range)
+{
+  dynamic_mesh2 m(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, generate_vertices(6u));
+  m.set_draw_range(3u, 3u);
+  EXPECT_EQ(3u, m.get_draw_first());
+  EXPECT_EQ(3u, m.get_draw_count());
+  m.reset_draw_range();
+  EXPECT_EQ(0u, m.get_draw_first());
+  EXPECT_EQ(6u, m.get_draw_count());
+}
+
+
+
+TEST_F(test_dynamic_mesh_death_test, set_draw_range_error_overflow)
+{
+  dynamic_mesh2 m(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, generate_vertices(6u));
+  EXPECT_PRECOND_ERROR(m.set_draw_range(4u, 3u));
+}
+
+
+
+TEST_F(test_dynamic_mesh, comparison)
+{
+  std::vector<vertex2> vertices = generate_vertices(3u);
+  dynamic_mesh2 m1(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices);
+  dynamic_mesh2 m2(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, generate_vertices(6u));
+  EXPECT_FALSE(m1 == m2);
+  m2.set_vertices(vertices);
+  EXPECT_TRUE(m1 == m2);
+  EXPECT_TRUE(close(m1, m2));
+}
@@ -0,0 +1,186 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gfx/test_data.hpp"
+#include "hou/gfx/test_gfx_base.hpp"
+
+#include "hou/gfx/font.hpp"
+#include "hou/gfx/formatted_text.hpp"
+#include "hou/gfx/glyph.hpp"
+#include "hou/gfx/glyph_atlas.hpp"
+
+#include "hou/cor/cor_exceptions.hpp"
+
+#include "hou/sys/binary_file_in.hpp"
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_glyph_atlas : public test_gfx_base
+{};
+
+class test_glyph_atlas_death_test : public test_glyph_atlas
+{};
+
+const std::string font_name = get_data_dir() + u8"NotoSans-Regular.ttf";
+
+}  // namespace
+
+
+
+TEST_F(test_glyph_atlas, size_constructor)
+{
+  vec3u size_ref(64u, 32u, 2u);
+  glyph_atlas ga(size_ref);
+  EXPECT_EQ(size_ref, ga.get_texture().get_size());
+  EXPECT_EQ(texture_format::r, ga.get_texture().get_format());
+  EXPECT_EQ(0u, ga.get_entry_count());
+}
+
+
+
+TEST_F(test_glyph_atlas, get_entry)
+{
+  font f = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(64u, 64u, 1u));
+
+  EXPECT_FALSE(ga.contains(f, 'A'));
+  const glyph_atlas::entry& e = ga.get_entry(f, 'A');
+  EXPECT_TRUE(ga.contains(f, 'A'));
+  EXPECT_EQ(1u, ga.get_entry_count());
+
+  glyph g = f.get_glyph('A');
+  EXPECT_EQ(g.get_metrics(), e.get_metrics());
+  EXPECT_EQ(g.get_image().get_size(), e.get_size());
+  EXPECT_EQ(vec3u::zero(), e.get_position());
+  image3_r sub_image = ga.get_texture().get_sub_image<pixel_format::r>(
+    e.get_position(), vec3u(e.get_size().x(), e.get_size().y(), 1u));
+  EXPECT_EQ(g.get_image().get_pixels(), sub_image.get_pixels());
+}
+
+
+
+TEST_F(test_glyph_atlas, get_entry_reuses_glyphs)
+{
+  font f = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(64u, 64u, 1u));
+
+  const glyph_atlas::entry& e1 = ga.get_entry(f, 'A');
+  const glyph_atlas::entry& e2 = ga.get_entry(f, 'A');
+  EXPECT_EQ(&e1, &e2);
+  EXPECT_EQ(1u, ga.get_entry_count());
+
+  ga.get_entry(f, 'B');
+  EXPECT_EQ(2u, ga.get_entry_count());
+}
+
+
+
+TEST_F(test_glyph_atlas, get_entry_font_properties)
+{
+  font f1 = font(binary_file_in(font_name));
+  font f2 = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(128u, 128u, 1u));
+
+  ga.get_entry(f1, 'A');
+  EXPECT_FALSE(ga.contains(f2, 'A'));
+  ga.get_entry(f2, 'A');
+  EXPECT_EQ(2u, ga.get_entry_count());
+
+  f1.set_pixel_height(20u);
+  EXPECT_FALSE(ga.contains(f1, 'A'));
+  const glyph_atlas::entry& e = ga.get_entry(f1, 'A');
+  EXPECT_EQ(f1.get_glyph('A').get_image().get_size(), e.get_size());
+  EXPECT_EQ(3u, ga.get_entry_count());
+}
+
+
+
+TEST_F(test_glyph_atlas, entries_are_separated)
+{
+  font f = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(32u, 32u, 4u));
+
+  std::u32string characters = U"ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  ga.reserve(f, characters);
+  EXPECT_EQ(characters.size(), ga.get_entry_count());
+
+  for(size_t i = 0; i < characters.size(); ++i)
+  {
+    const glyph_atlas::entry& ei = ga.get_entry(f, characters[i]);
+    for(size_t j = i + 1; j < characters.size(); ++j)
+    {
+      const glyph_atlas::entry& ej = ga.get_entry(f, characters[j]);
+      // There is at least a 1 texel gutter between entries.
+      bool separate = ei.get_position().z() != ej.get_position().z()
+        || ei.get_position().x() + ei.get_size().x() < ej.get_position().x()
+        || ej.get_position().x() + ej.get_size().x() < ei.get_position().x()
+        || ei.get_position().y() + ei.get_size().y() < ej.get_position().y()
+        || ej.get_position().y() + ej.get_size().y() < ei.get_position().y();
+      EXPECT_TRUE(separate);
+    }
+  }
+}
+
+
+
+TEST_F(test_glyph_atlas, clear)
+{
+  font f = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(64u, 64u, 1u));
+  ga.get_entry(f, 'A');
+  ga.clear();
+  EXPECT_EQ(0u, ga.get_entry_count());
+  EXPECT_FALSE(ga.contains(f, 'A'));
+  EXPECT_EQ(vec3u::zero(), ga.get_entry(f, 'B').get_position());
+}
+
+
+
+TEST_F(test_glyph_atlas, shared_by_formatted_text)
+{
+  font f = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(128u, 128u, 1u));
+
+  formatted_text ft1(u8"Hello", f, ga);
+  size_t count = ga.get_entry_count();
+  EXPECT_EQ(4u, count);
+
+  formatted_text ft2(u8"Hello hello", f, ga);
+  EXPECT_EQ(count + 2u, ga.get_entry_count());
+
+  EXPECT_EQ(&ga, &ft1.get_glyph_atlas());
+  EXPECT_EQ(&ga.get_texture(), &ft1.get_atlas());
+  EXPECT_EQ(&ft1.get_atlas(), &ft2.get_atlas());
+}
+
+
+
+TEST_F(test_glyph_atlas, owned_by_formatted_text)
+{
+  // These glyphs all have the largest bitmap width in the text, so each row
+  // of the owned atlas is filled up to its last cell.
+  font f = font(binary_file_in(font_name));
+  formatted_text ft(u8"HKNRU", f);
+  EXPECT_EQ(5u, ft.get_glyph_atlas().get_entry_count());
+
+  uint cell_width
+    = f.get_glyph('H').get_image().get_size().x() + glyph_atlas::get_gutter();
+  EXPECT_EQ(5u * cell_width, ft.get_atlas().get_size().x());
+}
+
+
+
+TEST_F(test_glyph_atlas_death_test, overflow)
+{
+  font f = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(8u, 8u, 1u));
+  std::u32string characters = U"ABCDEFGH";
+  EXPECT_ERROR_0(ga.reserve(f, characters), overflow_error);
+}
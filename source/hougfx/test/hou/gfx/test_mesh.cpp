@@ -24,6 +24,9 @@ namespace
 class test_mesh : public test_gfx_base
 {};
 
+class test_mesh_death_test : public test_mesh
+{};
+
 class vertex_type
 {
 public:
@@ -117,6 +120,65 @@ TEST_F(test_mesh, constructor)
   EXPECT_EQ(mesh_fill_mode::line, m.get_fill_mode());
   EXPECT_EQ(vertices_ref.size(), m.get_vertex_count());
   EXPECT_EQ(vertices_ref, m.get_vertices());
+  EXPECT_FALSE(m.is_indexed());
+  EXPECT_EQ(0u, m.get_index_count());
+  EXPECT_EQ(nullptr, m.get_index_buffer());
+  EXPECT_TRUE(m.get_indices().empty());
+}
+
+
+
+TEST_F(test_mesh, indexed_constructor_16)
+{
+  MeshType::vertex_collection vertices_ref{
+    vertex_type(1.f), vertex_type(1.3f), vertex_type(3.5f)};
+  std::vector<uint16_t> indices{0u, 1u, 2u, 2u, 1u, 0u};
+
+  MeshType m(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices_ref,
+    indices);
+
+  EXPECT_EQ(vertices_ref.size(), m.get_vertex_count());
+  EXPECT_EQ(vertices_ref, m.get_vertices());
+  EXPECT_TRUE(m.is_indexed());
+  EXPECT_EQ(indices.size(), m.get_index_count());
+  EXPECT_EQ(gl_type::unsigned_short_integer, m.get_index_type());
+  EXPECT_NE(nullptr, m.get_index_buffer());
+  EXPECT_EQ(std::vector<uint32_t>(indices.begin(), indices.end()),
+    m.get_indices());
+}
+
+
+
+TEST_F(test_mesh, indexed_constructor_32)
+{
+  MeshType::vertex_collection vertices_ref{
+    vertex_type(1.f), vertex_type(1.3f), vertex_type(3.5f)};
+  std::vector<uint32_t> indices{0u, 1u, 2u, 2u, 1u, 0u};
+
+  MeshType m(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices_ref,
+    indices);
+
+  EXPECT_EQ(vertices_ref.size(), m.get_vertex_count());
+  EXPECT_EQ(vertices_ref, m.get_vertices());
+  EXPECT_TRUE(m.is_indexed());
+  EXPECT_EQ(indices.size(), m.get_index_count());
+  EXPECT_EQ(gl_type::unsigned_integer, m.get_index_type());
+  EXPECT_EQ(indices, m.get_indices());
+}
+
+
+
+TEST_F(test_mesh_death_test, indexed_constructor_error_index_overflow)
+{
+  MeshType::vertex_collection vertices{
+    vertex_type(1.f), vertex_type(1.3f), vertex_type(3.5f)};
+  std::vector<uint16_t> indices_16{0u, 1u, 3u};
+  std::vector<uint32_t> indices_32{0u, 1u, 3u};
+
+  EXPECT_PRECOND_ERROR(MeshType(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices, indices_16));
+  EXPECT_PRECOND_ERROR(MeshType(
+    mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices, indices_32));
 }
 
 
@@ -163,6 +225,32 @@ TEST_F(test_mesh, comparison)
 
 
 
+TEST_F(test_mesh, indexed_comparison)
+{
+  MeshType::vertex_collection vertices{
+    vertex_type(1.f), vertex_type(2.f), vertex_type(3.f)};
+  std::vector<uint16_t> indices1{0u, 1u, 2u};
+  std::vector<uint16_t> indices2{2u, 1u, 0u};
+  std::vector<uint32_t> indices3{0u, 1u, 2u};
+
+  MeshType m1(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices,
+    indices1);
+  MeshType m2(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices,
+    indices1);
+  MeshType m3(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices,
+    indices2);
+  MeshType m4(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices,
+    indices3);
+  MeshType m5(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices);
+
+  EXPECT_TRUE(m1 == m2);
+  EXPECT_FALSE(m1 == m3);
+  EXPECT_TRUE(m1 == m4);
+  EXPECT_FALSE(m1 == m5);
+}
+
+
+
 TEST_F(test_mesh, close_comparison)
 {
   MeshType::vertex_collection vertices1{vertex_type(1.1234f), vertex_type(2.f)};
@@ -201,3 +289,17 @@ TEST_F(test_mesh, output_stream_operator)
     = "{draw_mode = triangle_strip, fill_mode = fill, vertices = {{1}, {2}}}";
   EXPECT_OUTPUT(out_ref, m);
 }
+
+
+
+TEST_F(test_mesh, indexed_output_stream_operator)
+{
+  MeshType::vertex_collection vertices{vertex_type(1.f), vertex_type(2.f)};
+  std::vector<uint16_t> indices{0u, 1u, 0u};
+  MeshType m(
+    mesh_draw_mode::triangle_strip, mesh_fill_mode::fill, vertices, indices);
+
+  const char out_ref[] = "{draw_mode = triangle_strip, fill_mode = fill, "
+                         "vertices = {{1}, {2}}, indices = {0, 1, 0}}";
+  EXPECT_OUTPUT(out_ref, m);
+}
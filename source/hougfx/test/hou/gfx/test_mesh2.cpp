@@ -46,7 +46,10 @@ TEST_F(test_mesh2, rectangle_outline)
 
   EXPECT_EQ(mesh_draw_mode::triangle_strip, m.get_draw_mode());
   EXPECT_EQ(mesh_fill_mode::fill, m.get_fill_mode());
-  EXPECT_EQ(10u, m.get_vertex_count());
+  EXPECT_EQ(8u, m.get_vertex_count());
+  EXPECT_TRUE(m.is_indexed());
+  EXPECT_EQ(10u, m.get_index_count());
+  EXPECT_EQ(gl_type::unsigned_short_integer, m.get_index_type());
 
   std::vector<vertex2> vertices_ref{
     vertex2(vec2f(0.f, 0.f), vec2f::zero(), color::white()),
@@ -56,10 +59,11 @@ TEST_F(test_mesh2, rectangle_outline)
     vertex2(vec2f(6.f, 8.f), vec2f::zero(), color::white()),
     vertex2(vec2f(4.f, 6.f), vec2f::zero(), color::white()),
     vertex2(vec2f(6.f, 0.f), vec2f::zero(), color::white()),
-    vertex2(vec2f(4.f, 2.f), vec2f::zero(), color::white()),
-    vertex2(vec2f(0.f, 0.f), vec2f::zero(), color::white()),
-    vertex2(vec2f(2.f, 2.f), vec2f::zero(), color::white())};
+    vertex2(vec2f(4.f, 2.f), vec2f::zero(), color::white())};
   EXPECT_EQ(vertices_ref, m.get_vertices());
+
+  std::vector<uint32_t> indices_ref{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 0u, 1u};
+  EXPECT_EQ(indices_ref, m.get_indices());
 }
 
 
@@ -70,7 +74,9 @@ TEST_F(test_mesh2, ellipse)
 
   EXPECT_EQ(mesh_draw_mode::triangle_fan, m.get_draw_mode());
   EXPECT_EQ(mesh_fill_mode::fill, m.get_fill_mode());
-  EXPECT_EQ(10u, m.get_vertex_count());
+  EXPECT_EQ(9u, m.get_vertex_count());
+  EXPECT_TRUE(m.is_indexed());
+  EXPECT_EQ(10u, m.get_index_count());
 
   std::vector<vertex2> vertices_ref{
     vertex2(vec2f(0.5f, 1.f), vec2f::zero(), color::white()),
@@ -81,9 +87,11 @@ TEST_F(test_mesh2, ellipse)
     vertex2(vec2f(0.f, 1.f), vec2f::zero(), color::white()),
     vertex2(vec2f(0.146447f, 0.292893f), vec2f::zero(), color::white()),
     vertex2(vec2f(0.5f, 0.f), vec2f::zero(), color::white()),
-    vertex2(vec2f(0.853553f, 0.292893f), vec2f::zero(), color::white()),
-    vertex2(vec2f(1.f, 1.f), vec2f::zero(), color::white())};
+    vertex2(vec2f(0.853553f, 0.292893f), vec2f::zero(), color::white())};
   EXPECT_CLOSE(vertices_ref, m.get_vertices(), 1e-5f);
+
+  std::vector<uint32_t> indices_ref{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 1u};
+  EXPECT_EQ(indices_ref, m.get_indices());
 }
 
 
@@ -94,7 +102,9 @@ TEST_F(test_mesh2, ellipse_outline)
 
   EXPECT_EQ(mesh_draw_mode::triangle_strip, m.get_draw_mode());
   EXPECT_EQ(mesh_fill_mode::fill, m.get_fill_mode());
-  EXPECT_EQ(18u, m.get_vertex_count());
+  EXPECT_EQ(16u, m.get_vertex_count());
+  EXPECT_TRUE(m.is_indexed());
+  EXPECT_EQ(18u, m.get_index_count());
 
   std::vector<vertex2> vertices_ref{
     vertex2(vec2f(1.f, 1.f), vec2f::zero(), color::white()),
@@ -112,10 +122,12 @@ TEST_F(test_mesh2, ellipse_outline)
     vertex2(vec2f(0.5f, 0.f), vec2f::zero(), color::white()),
     vertex2(vec2f(0.5f, 0.25f), vec2f::zero(), color::white()),
     vertex2(vec2f(0.853553f, 0.292893f), vec2f::zero(), color::white()),
-    vertex2(vec2f(0.676777f, 0.46967f), vec2f::zero(), color::white()),
-    vertex2(vec2f(1.f, 1.f), vec2f::zero(), color::white()),
-    vertex2(vec2f(0.75f, 1.f), vec2f::zero(), color::white())};
+    vertex2(vec2f(0.676777f, 0.46967f), vec2f::zero(), color::white())};
   EXPECT_CLOSE(vertices_ref, m.get_vertices(), 1e-5f);
+
+  std::vector<uint32_t> indices_ref{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u,
+    10u, 11u, 12u, 13u, 14u, 15u, 0u, 1u};
+  EXPECT_EQ(indices_ref, m.get_indices());
 }
 
 
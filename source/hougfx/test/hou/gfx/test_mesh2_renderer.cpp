@@ -134,3 +134,115 @@ TEST_F(test_mesh2_renderer, draw_textured_rectangle)
     = generate_result_image(size, recti(1, 2, 3, 4), color::transparent(), col);
   EXPECT_EQ(im_ref, rt.to_texture().get_image<pixel_format::rgba>());
 }
+
+
+
+TEST_F(test_mesh2_renderer, instance_data)
+{
+  mesh2_renderer::instance_data id_default;
+  EXPECT_EQ(color::white(), id_default.get_color());
+
+  color col(20u, 30u, 40u, 255u);
+  mesh2_renderer::instance_data id(trans2f::identity(), col);
+  EXPECT_EQ(col, id.get_color());
+  id.set_color(color::red());
+  EXPECT_EQ(color::red(), id.get_color());
+}
+
+
+
+TEST_F(test_mesh2_renderer, draw_instanced_rectangles)
+{
+  mesh2_renderer mr;
+  vec2u size(8u, 10u);
+  render_surface rt(size);
+  mesh2 rect = rectangle_mesh2(vec2f(2.f, 3.f));
+  trans2f proj
+    = trans2f::orthographic_projection(rectf(0.f, 0.f, size.x(), size.y()));
+  color col1(20u, 30u, 40u, 255u);
+  color col2(200u, 100u, 50u, 255u);
+  std::vector<mesh2_renderer::instance_data> instances{
+    mesh2_renderer::instance_data(
+      proj * trans2f::translation(vec2f(1.f, 2.f)), col1),
+    mesh2_renderer::instance_data(
+      proj * trans2f::translation(vec2f(4.f, 6.f)), col2),
+  };
+
+  mr.draw_instanced(rt, rect, instances);
+  EXPECT_LE(instances.size(), mr.get_instance_capacity());
+
+  image2_rgba im_ref = generate_result_image(
+    size, recti(1, 2, 2, 3), color::transparent(), col1);
+  for(uint y = 6u; y < 9u; ++y)
+  {
+    for(uint x = 4u; x < 6u; ++x)
+    {
+      im_ref.set_pixel(vec2u(x, y), image2_rgba::pixel_type(col2));
+    }
+  }
+  EXPECT_EQ(im_ref, rt.to_texture().get_image<pixel_format::rgba>());
+}
+
+
+
+TEST_F(test_mesh2_renderer, draw_instanced_matches_draw)
+{
+  mesh2_renderer mr;
+  vec2u size(16u, 16u);
+  mesh2 ellipse = ellipse_mesh2(vec2f(6.f, 4.f), 16u);
+  trans2f proj
+    = trans2f::orthographic_projection(rectf(0.f, 0.f, size.x(), size.y()));
+  std::vector<trans2f> transforms{
+    proj * trans2f::translation(vec2f(1.f, 1.f)),
+    proj * trans2f::translation(vec2f(8.f, 9.f)),
+  };
+  color col(20u, 30u, 40u, 255u);
+
+  render_surface rt_ref(size);
+  std::vector<mesh2_renderer::instance_data> instances;
+  for(const auto& t : transforms)
+  {
+    mr.draw(rt_ref, ellipse, col, t);
+    instances.push_back(mesh2_renderer::instance_data(t, col));
+  }
+
+  render_surface rt(size);
+  mr.draw_instanced(rt, ellipse, instances);
+
+  EXPECT_EQ(rt_ref.to_texture().get_image<pixel_format::rgba>(),
+    rt.to_texture().get_image<pixel_format::rgba>());
+}
+
+
+
+TEST_F(test_mesh2_renderer, draw_dynamic_mesh_range)
+{
+  mesh2_renderer mr;
+  vec2u size(8u, 6u);
+  render_surface rt(size);
+  color col(20u, 30u, 40u, 255u);
+  trans2f t
+    = trans2f::orthographic_projection(rectf(0.f, 0.f, size.x(), size.y()));
+
+  std::vector<vertex2> vertices;
+  for(float x : {1.f, 5.f})
+  {
+    vertices.push_back(vertex2(vec2f(x, 2.f), vec2f::zero(), color::white()));
+    vertices.push_back(vertex2(vec2f(x, 5.f), vec2f::zero(), color::white()));
+    vertices.push_back(
+      vertex2(vec2f(x + 2.f, 5.f), vec2f::zero(), color::white()));
+    vertices.push_back(vertex2(vec2f(x, 2.f), vec2f::zero(), color::white()));
+    vertices.push_back(
+      vertex2(vec2f(x + 2.f, 5.f), vec2f::zero(), color::white()));
+    vertices.push_back(
+      vertex2(vec2f(x + 2.f, 2.f), vec2f::zero(), color::white()));
+  }
+  dynamic_mesh2 m(mesh_draw_mode::triangles, mesh_fill_mode::fill, vertices);
+  m.set_draw_range(6u, 6u);
+
+  mr.draw(rt, m, col, t);
+
+  image2_rgba im_ref
+    = generate_result_image(size, recti(5, 2, 2, 3), color::transparent(), col);
+  EXPECT_EQ(im_ref, rt.to_texture().get_image<pixel_format::rgba>());
+}
@@ -0,0 +1,219 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gfx/test_gfx_base.hpp"
+#include "hou/test.hpp"
+
+#include "hou/gfx/render_surface.hpp"
+#include "hou/gfx/sprite_batch.hpp"
+
+#include "hou/mth/transform2.hpp"
+
+#include "hou/sys/color.hpp"
+
+using namespace hou;
+
+
+
+namespace
+{
+
+class test_sprite_batch : public test_gfx_base
+{};
+
+class test_sprite_batch_death_test : public test_sprite_batch
+{};
+
+image2_rgba generate_result_image(const vec2u& dst_size, const recti& dst_rect,
+  const color& dst_color, const color& src_color);
+
+
+
+image2_rgba generate_result_image(const vec2u& dst_size, const recti& dst_rect,
+  const color& dst_color, const color& src_color)
+{
+  image2_rgba im_ref(dst_size);
+  im_ref.clear(image2_rgba::pixel_type(dst_color));
+
+  uint x_max = std::min(static_cast<uint>(dst_rect.r()), dst_size.x());
+  uint y_max = std::min(static_cast<uint>(dst_rect.b()), dst_size.y());
+  for(uint y = dst_rect.t(); y < y_max; ++y)
+  {
+    for(uint x = dst_rect.l(); x < x_max; ++x)
+    {
+      im_ref.set_pixel(vec2u(x, y), image2_rgba::pixel_type(src_color));
+    }
+  }
+  return im_ref;
+}
+
+}  // namespace
+
+
+
+TEST_F(test_sprite_batch, creation)
+{
+  sprite_batch sb(12u, 2u);
+  EXPECT_EQ(0u, sb.get_vertex_count());
+  EXPECT_EQ(12u, sb.get_vertex_capacity());
+  EXPECT_EQ(2u, sb.get_buffer_count());
+  EXPECT_EQ(0u, sb.get_draw_call_count());
+  EXPECT_FALSE(sb.is_sorting_by_texture());
+}
+
+
+
+TEST_F(test_sprite_batch_death_test, creation_error_no_buffers)
+{
+  EXPECT_PRECOND_ERROR(sprite_batch(12u, 0u));
+}
+
+
+
+TEST_F(test_sprite_batch, add_quad)
+{
+  texture2 tex(vec2u(4u, 4u));
+  sprite_batch sb;
+  sb.add_quad(tex, vec2f(2.f, 3.f));
+  EXPECT_EQ(6u, sb.get_vertex_count());
+  EXPECT_EQ(1u, sb.get_draw_call_count());
+  sb.add_quad(tex, rectf(1.f, 1.f, 2.f, 2.f));
+  EXPECT_EQ(12u, sb.get_vertex_count());
+  EXPECT_EQ(1u, sb.get_draw_call_count());
+  sb.add_quad(vec2f(2.f, 3.f));
+  EXPECT_EQ(18u, sb.get_vertex_count());
+  EXPECT_EQ(2u, sb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_sprite_batch, add_triangles)
+{
+  std::vector<vertex2> vertices{
+    vertex2(vec2f(0.f, 0.f), vec2f(0.f, 0.f), color::white()),
+    vertex2(vec2f(0.f, 1.f), vec2f(0.f, 1.f), color::white()),
+    vertex2(vec2f(1.f, 1.f), vec2f(1.f, 1.f), color::white()),
+  };
+  sprite_batch sb;
+  sb.add_triangles(vertices);
+  EXPECT_EQ(3u, sb.get_vertex_count());
+  EXPECT_EQ(1u, sb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_sprite_batch_death_test, add_triangles_error_vertex_count)
+{
+  std::vector<vertex2> vertices{
+    vertex2(vec2f(0.f, 0.f), vec2f(0.f, 0.f), color::white()),
+    vertex2(vec2f(0.f, 1.f), vec2f(0.f, 1.f), color::white()),
+  };
+  sprite_batch sb;
+  EXPECT_PRECOND_ERROR(sb.add_triangles(vertices));
+}
+
+
+
+TEST_F(test_sprite_batch, sorting_by_texture)
+{
+  texture2 tex1(vec2u(4u, 4u));
+  texture2 tex2(vec2u(4u, 4u));
+  sprite_batch sb;
+  sb.add_quad(tex1, vec2f(1.f, 1.f));
+  sb.add_quad(tex2, vec2f(1.f, 1.f));
+  sb.add_quad(tex1, vec2f(1.f, 1.f));
+  sb.add_quad(tex2, vec2f(1.f, 1.f));
+  EXPECT_EQ(4u, sb.get_draw_call_count());
+  sb.set_sorting_by_texture(true);
+  EXPECT_TRUE(sb.is_sorting_by_texture());
+  EXPECT_EQ(2u, sb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_sprite_batch, clear)
+{
+  sprite_batch sb;
+  sb.add_quad(vec2f(1.f, 1.f));
+  sb.clear();
+  EXPECT_EQ(0u, sb.get_vertex_count());
+  EXPECT_EQ(0u, sb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_sprite_batch, draw_rectangle)
+{
+  vec2u size(4u, 6u);
+  render_surface rt(size);
+  color col(20u, 30u, 40u, 255u);
+  trans2f t
+    = trans2f::orthographic_projection(rectf(0.f, 0.f, size.x(), size.y()))
+    * trans2f::translation(vec2f(1.f, 2.f));
+
+  sprite_batch sb;
+  sb.add_quad(vec2f(2.f, 3.f), col, t);
+  sb.draw(rt);
+  EXPECT_EQ(0u, sb.get_vertex_count());
+
+  image2_rgba im_ref
+    = generate_result_image(size, recti(1, 2, 2, 3), color::transparent(), col);
+  EXPECT_EQ(im_ref, rt.to_texture().get_image<pixel_format::rgba>());
+}
+
+
+
+TEST_F(test_sprite_batch, draw_textured_rectangles_sorted)
+{
+  vec2u size(8u, 10u);
+  render_surface rt(size);
+  trans2f proj
+    = trans2f::orthographic_projection(rectf(0.f, 0.f, size.x(), size.y()));
+  color col1(20u, 30u, 40u, 255u);
+  color col2(200u, 100u, 50u, 255u);
+  image2_rgba im(vec2u(3u, 4u));
+  im.clear(image2_rgba::pixel_type(col1));
+  texture2 tex1(im);
+  im.clear(image2_rgba::pixel_type(col2));
+  texture2 tex2(im);
+
+  sprite_batch sb(1u);
+  sb.set_sorting_by_texture(true);
+  sb.add_quad(tex1, vec2f(3.f, 4.f), color::white(),
+    proj * trans2f::translation(vec2f(1.f, 2.f)));
+  sb.add_quad(tex2, vec2f(3.f, 4.f), color::white(),
+    proj * trans2f::translation(vec2f(4.f, 6.f)));
+  sb.add_quad(tex1, vec2f(1.f, 1.f), color::white(),
+    proj * trans2f::translation(vec2f(7.f, 0.f)));
+  EXPECT_EQ(2u, sb.get_draw_call_count());
+  sb.draw(rt);
+
+  image2_rgba im_ref
+    = generate_result_image(size, recti(1, 2, 3, 4), color::transparent(), col1);
+  im_ref.set_pixel(vec2u(7u, 0u), image2_rgba::pixel_type(col1));
+  for(uint y = 6u; y < 10u; ++y)
+  {
+    for(uint x = 4u; x < 7u; ++x)
+    {
+      im_ref.set_pixel(vec2u(x, y), image2_rgba::pixel_type(col2));
+    }
+  }
+  EXPECT_EQ(im_ref, rt.to_texture().get_image<pixel_format::rgba>());
+}
+
+
+
+TEST_F(test_sprite_batch, draw_uses_buffer_ring)
+{
+  vec2u size(4u, 4u);
+  render_surface rt(size);
+  sprite_batch sb(6u, 2u);
+  for(uint i = 0; i < 4u; ++i)
+  {
+    sb.add_quad(vec2f(1.f, 1.f));
+    sb.add_quad(vec2f(1.f, 1.f));
+    sb.draw(rt);
+  }
+  EXPECT_EQ(12u, sb.get_vertex_capacity());
+}
@@ -0,0 +1,139 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gfx/test_data.hpp"
+#include "hou/gfx/test_gfx_base.hpp"
+#include "hou/test.hpp"
+
+#include "hou/gfx/font.hpp"
+#include "hou/gfx/formatted_text.hpp"
+#include "hou/gfx/glyph_atlas.hpp"
+#include "hou/gfx/render_surface.hpp"
+#include "hou/gfx/text_batch.hpp"
+#include "hou/gfx/text_mesh_renderer.hpp"
+
+#include "hou/mth/transform2.hpp"
+
+#include "hou/sys/binary_file_in.hpp"
+#include "hou/sys/color.hpp"
+
+using namespace hou;
+
+
+
+namespace
+{
+
+class test_text_batch : public test_gfx_base
+{};
+
+const std::string font_name = get_data_dir() + u8"NotoSans-Regular.ttf";
+
+}  // namespace
+
+
+
+TEST_F(test_text_batch, creation)
+{
+  text_batch tb(12u);
+  EXPECT_EQ(0u, tb.get_vertex_count());
+  EXPECT_EQ(12u, tb.get_vertex_capacity());
+  EXPECT_EQ(0u, tb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_text_batch, add)
+{
+  font f = font(binary_file_in(font_name));
+  formatted_text ft(u8"Hello", f);
+  text_batch tb;
+  tb.add(ft);
+  EXPECT_EQ(ft.get_vertices().size(), tb.get_vertex_count());
+  EXPECT_EQ(1u, tb.get_draw_call_count());
+  tb.add(ft, color::red(), trans2f::translation(vec2f(1.f, 2.f)));
+  EXPECT_EQ(2u * ft.get_vertices().size(), tb.get_vertex_count());
+  EXPECT_EQ(1u, tb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_text_batch, add_shared_atlas)
+{
+  font f = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(128u, 128u, 1u));
+  formatted_text ft1(u8"Hello", f, ga);
+  formatted_text ft2(u8"World", f, ga);
+  formatted_text ft3(u8"World", f);
+
+  text_batch tb;
+  tb.add(ft1);
+  tb.add(ft2);
+  EXPECT_EQ(1u, tb.get_draw_call_count());
+  tb.add(ft3);
+  EXPECT_EQ(2u, tb.get_draw_call_count());
+  tb.add(ft1);
+  EXPECT_EQ(3u, tb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_text_batch, clear)
+{
+  font f = font(binary_file_in(font_name));
+  formatted_text ft(u8"Hello", f);
+  text_batch tb;
+  tb.add(ft);
+  tb.clear();
+  EXPECT_EQ(0u, tb.get_vertex_count());
+  EXPECT_EQ(0u, tb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_text_batch, draw_grows_buffer)
+{
+  font f = font(binary_file_in(font_name));
+  formatted_text ft(u8"Hello", f);
+  vec2u size(32u, 32u);
+  render_surface rs(size);
+  text_batch tb(1u);
+  tb.add(ft);
+  tb.add(ft);
+  tb.draw(rs);
+  EXPECT_LE(2u * ft.get_vertices().size(), tb.get_vertex_capacity());
+  EXPECT_EQ(0u, tb.get_vertex_count());
+  EXPECT_EQ(0u, tb.get_draw_call_count());
+}
+
+
+
+TEST_F(test_text_batch, draw_matches_text_mesh_renderer)
+{
+  font f = font(binary_file_in(font_name));
+  glyph_atlas ga(vec3u(128u, 128u, 1u));
+  formatted_text ft1(u8"Hi", f, ga);
+  formatted_text ft2(u8"you", f, ga);
+  vec2u size(32u, 32u);
+  trans2f proj
+    = trans2f::orthographic_projection(rectf(0.f, 0.f, size.x(), size.y()));
+  trans2f t1 = proj * trans2f::translation(vec2f(2.f, 12.f));
+  trans2f t2 = proj * trans2f::translation(vec2f(4.f, 26.f));
+  color c1(20u, 30u, 40u, 255u);
+  color c2(200u, 100u, 50u, 255u);
+
+  render_surface rs_ref(size);
+  text_mesh_renderer tmr;
+  tmr.draw(rs_ref, ft1, c1, t1);
+  tmr.draw(rs_ref, ft2, c2, t2);
+
+  render_surface rs(size);
+  text_batch tb;
+  tb.add(ft1, c1, t1);
+  tb.add(ft2, c2, t2);
+  tb.draw(rs);
+
+  EXPECT_EQ(rs_ref.to_texture().get_image<pixel_format::rgba>(),
+    rs.to_texture().get_image<pixel_format::rgba>());
+}
@@ -125,6 +125,23 @@ TEST_F(test_vertex_array, set_vertex_data_max_attrib_formats)
 
 
 
+TEST_F(test_vertex_array, set_vertex_data_attrib_offset_and_divisor)
+{
+  vertex_array va;
+  float_buffer vb1(std::vector<float>{1, 2, 3, 4, 5, 6});
+  float_buffer vb2(std::vector<float>{1, 2, 3, 4});
+  vertex_format vf1(0, 3,
+    {vertex_attrib_format(gl_type::float_decimal, 2, 0, false),
+      vertex_attrib_format(gl_type::float_decimal, 1, 2, true)});
+  vertex_format vf2(
+    0, 2, {vertex_attrib_format(gl_type::float_decimal, 2, 0, false)});
+  va.set_vertex_data(vb1, 0u, vf1);
+  va.set_vertex_data(vb2, 1u, vf2, 2u, 1u);
+  SUCCEED();
+}
+
+
+
 TEST_F(test_vertex_array, set_element_data)
 {
   // Currently fails on Emscripten because of the fact that buffers are always
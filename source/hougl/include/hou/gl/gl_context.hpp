@@ -8,6 +8,7 @@
 #include "hou/cor/non_copyable.hpp"
 
 #include "hou/gl/gl_context_settings.hpp"
+#include "hou/gl/gl_error_report_mode.hpp"
 #include "hou/gl/open_gl.hpp"
 
 #include "hou/gl/gl_config.hpp"
@@ -18,6 +19,9 @@
 
 #include "hou/sys/window.hpp"
 
+#include <array>
+#include <atomic>
+#include <thread>
 #include <vector>
 
 namespace hou {
@@ -90,6 +94,8 @@ public:
    *
    * \param the window to make current.
    *
+   * \throws hou::precondition_violation if ctx is current in another thread.
+   *
    * \throws hou::gl::context_switch_error in case setting the context failed.
    */
   static void set_current(context &ctx, window &wnd);
@@ -107,6 +113,10 @@ public:
   /**
    * Gets the current context in the current thread.
    *
+   * The current context is cached per thread by set_current and
+   * unset_current, so this function does not perform any locking.
+   * For this reason, contexts must only be made current through this class.
+   *
    * \return a pointer to the current context, or nullptr if there is no
    * current context.
    */
@@ -159,12 +169,18 @@ public:
   /**
    * Move constructor.
    *
+   * other must not be current in another thread, since the cached current
+   * context of that thread could not be updated.
+   *
    * \param other the othe context.
    */
   context(context &&other) noexcept;
 
   /**
    * Destructor.
+   *
+   * The context must not be current in another thread, since the cached
+   * current context of that thread could not be updated.
    */
   ~context();
 
@@ -211,6 +227,43 @@ public:
    */
   const context_settings& get_settings() const noexcept;
 
+  /**
+   * Gets how OpenGL errors are detected for this context.
+   *
+   * Contexts created with debug mode enabled report errors through a
+   * KHR_debug message callback if the driver supports it, and fall back to
+   * checking for errors once per frame otherwise.
+   * Other contexts check for errors after every OpenGL call.
+   * Errors are only checked if the library was built with
+   * HOU_ENABLE_GL_ERROR_CHECKS.
+   *
+   * \return the error report mode.
+   */
+  error_report_mode get_error_report_mode() const noexcept;
+
+  /**
+   * Gets the number of tracked state changes which were issued to the driver.
+   *
+   * Tracked state changes are changes to blending, multisampling, viewport,
+   * and uniform values.
+   *
+   * \return the number of issued state changes since the last reset.
+   */
+  size_t get_issued_state_change_count() const noexcept;
+
+  /**
+   * Gets the number of tracked state changes which were skipped because they
+   * would not have modified the state.
+   *
+   * \return the number of skipped state changes since the last reset.
+   */
+  size_t get_skipped_state_change_count() const noexcept;
+
+  /**
+   * Resets the issued and skipped state change counters.
+   */
+  void reset_state_change_counts() noexcept;
+
 private:
   class tracking_data {
   public:
@@ -254,6 +307,34 @@ private:
 
     void set_current_viewport(const recti &viewport) noexcept;
 
+    static bool is_capability_tracked(GLenum cap) noexcept;
+
+    bool is_capability_enabled(GLenum cap) const noexcept;
+
+    void set_capability_enabled(GLenum cap, bool value) noexcept;
+
+    GLenum get_blend_src_factor() const noexcept;
+
+    GLenum get_blend_dst_factor() const noexcept;
+
+    void set_blend_factors(GLenum src, GLenum dst) noexcept;
+
+    GLenum get_blend_equation() const noexcept;
+
+    void set_blend_equation(GLenum mode) noexcept;
+
+    const std::array<GLfloat, 4u> &get_blend_color() const noexcept;
+
+    void set_blend_color(const std::array<GLfloat, 4u> &color) noexcept;
+
+    size_t get_issued_state_change_count() const noexcept;
+
+    size_t get_skipped_state_change_count() const noexcept;
+
+    void record_state_change(bool issued) noexcept;
+
+    void reset_state_change_counts() noexcept;
+
   private:
     uint32_t m_bound_array_buffer;
     uint32_t m_bound_element_array_buffer;
@@ -265,6 +346,14 @@ private:
     std::vector<uint32_t> m_bound_textures;
     std::vector<GLenum> m_bound_texture_targets;
     recti m_current_viewport;
+    bool m_blending_enabled;
+    bool m_multisampling_enabled;
+    GLenum m_blend_src_factor;
+    GLenum m_blend_dst_factor;
+    GLenum m_blend_equation;
+    std::array<GLfloat, 4u> m_blend_color;
+    size_t m_issued_state_change_count;
+    size_t m_skipped_state_change_count;
   };
 
 private:
@@ -277,8 +366,21 @@ private:
   uid_type m_sharing_group_uid;
   tracking_data m_tracking_data;
   context_settings m_settings;
+  error_report_mode m_error_report_mode;
+  std::atomic<std::thread::id> m_current_thread_id;
 
 private:
+  friend HOU_GL_API GLboolean is_enabled(GLenum val);
+  friend HOU_GL_API void enable(GLenum val);
+  friend HOU_GL_API void disable(GLenum val);
+  friend HOU_GL_API void set_blend_func(GLenum sfactor, GLenum dfactor);
+  friend HOU_GL_API GLenum get_blend_src_factor();
+  friend HOU_GL_API GLenum get_blend_dst_factor();
+  friend HOU_GL_API void set_blend_equation(GLenum mode);
+  friend HOU_GL_API GLenum get_blend_equation();
+  friend HOU_GL_API void set_blend_color(GLfloat r, GLfloat g, GLfloat b,
+                                         GLfloat a);
+  friend HOU_GL_API void get_blend_color(GLfloat *color);
   friend HOU_GL_API void bind_buffer(const buffer_handle &buffer,
                                      GLenum target);
   friend HOU_GL_API void unbind_buffer(GLenum target);
@@ -318,6 +420,45 @@ private:
   is_vertex_array_bound(const vertex_array_handle &vertexArray);
   friend HOU_GL_API bool is_vertex_array_bound();
   friend HOU_GL_API void set_viewport(GLint x, GLint y, GLsizei w, GLsizei h);
+  friend HOU_GL_API void set_program_uniform_i(const program_handle &program,
+                                               GLint location, GLint v0);
+  friend HOU_GL_API void set_program_uniform_i(const program_handle &program,
+                                               GLint location, GLint v0,
+                                               GLint v1);
+  friend HOU_GL_API void set_program_uniform_i(const program_handle &program,
+                                               GLint location, GLint v0,
+                                               GLint v1, GLint v2);
+  friend HOU_GL_API void set_program_uniform_i(const program_handle &program,
+                                               GLint location, GLint v0,
+                                               GLint v1, GLint v2, GLint v3);
+  friend HOU_GL_API void set_program_uniform_u(const program_handle &program,
+                                               GLuint location, GLuint v0);
+  friend HOU_GL_API void set_program_uniform_u(const program_handle &program,
+                                               GLuint location, GLuint v0,
+                                               GLuint v1);
+  friend HOU_GL_API void set_program_uniform_u(const program_handle &program,
+                                               GLuint location, GLuint v0,
+                                               GLuint v1, GLuint v2);
+  friend HOU_GL_API void set_program_uniform_u(const program_handle &program,
+                                               GLuint location, GLuint v0,
+                                               GLuint v1, GLuint v2,
+                                               GLuint v3);
+  friend HOU_GL_API void set_program_uniform_f(const program_handle &program,
+                                               GLint location, GLfloat v0);
+  friend HOU_GL_API void set_program_uniform_f(const program_handle &program,
+                                               GLint location, GLfloat v0,
+                                               GLfloat v1);
+  friend HOU_GL_API void set_program_uniform_f(const program_handle &program,
+                                               GLint location, GLfloat v0,
+                                               GLfloat v1, GLfloat v2);
+  friend HOU_GL_API void set_program_uniform_f(const program_handle &program,
+                                               GLint location, GLfloat v0,
+                                               GLfloat v1, GLfloat v2,
+                                               GLfloat v3);
+  friend HOU_GL_API void
+  set_program_uniform_mat4x4f(const program_handle &program, GLint location,
+                              GLsizei count, GLboolean transpose,
+                              const GLfloat *values);
 };
 
 } // namespace gl
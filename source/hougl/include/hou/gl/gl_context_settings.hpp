@@ -251,6 +251,11 @@ public:
   /**
    * Sets if OpenGL debug mode is required.
    *
+   * Debug contexts report OpenGL errors through a KHR_debug message callback
+   * instead of calling glGetError after every call. If the driver does not
+   * support KHR_debug, errors are checked once per frame instead.
+   * See context::get_error_report_mode.
+   *
    * \param value the value.
    */
   void set_debug_mode(bool value) noexcept;
@@ -0,0 +1,57 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_GL_GL_ERROR_REPORT_MODE_HPP
+#define HOU_GL_GL_ERROR_REPORT_MODE_HPP
+
+#include "hou/gl/gl_config.hpp"
+
+#include <iostream>
+
+
+
+namespace hou
+{
+
+namespace gl
+{
+
+/**
+ * Represents how OpenGL errors are detected when GL error checks are enabled.
+ */
+enum class error_report_mode
+{
+  /**
+   * glGetError is called after every OpenGL call.
+   */
+  per_call,
+
+  /**
+   * Errors are reported by a KHR_debug message callback and raised by the
+   * next error check after the failing call.
+   */
+  debug_callback,
+
+  /**
+   * glGetError is called once per frame.
+   */
+  per_frame,
+};
+
+/**
+ * Writes a error_report_mode enum into a stream.
+ *
+ * \param os the stream.
+ *
+ * \param erm the error_report_mode enum.
+ *
+ * \return a reference to the stream.
+ */
+HOU_GL_API std::ostream& operator<<(std::ostream& os, error_report_mode erm);
+
+}  // namespace gl
+
+}  // namespace hou
+
+#endif
@@ -126,9 +126,27 @@ public:
    * \throws std::bad_alloc.
    */
   call_error(const std::string& path, uint line, GLenum ec);
+
+  /** Constructor.
+   *
+   * \param path the path to the source file where the error happened.
+   *
+   * \param line the line where the error happened.
+   *
+   * \param message the error message reported by the OpenGL debug output.
+   *
+   * \throws std::bad_alloc.
+   */
+  call_error(const std::string& path, uint line, const std::string& message);
 };
 
 /** Checks if an OpenGL call has failed and throws an exception in case.
+ *
+ * The check depends on the error report mode of the current context.
+ * In per_call mode glGetError is called.
+ * In debug_callback mode the errors reported by the debug message callback
+ * since the last check are raised, without querying the driver.
+ * In per_frame mode nothing is checked.
  *
  * \param path the source file path to be written in the exception in case of
  * an error.
@@ -140,6 +158,45 @@ public:
  */
 void HOU_GL_API check_error(const std::string& path, uint line);
 
+/** Checks if an OpenGL call in the current frame has failed and throws an
+ * exception in case.
+ *
+ * This function should be called once per frame.
+ * In per_frame mode glGetError is called.
+ * In debug_callback mode the errors reported by the debug message callback
+ * since the last check are raised.
+ * In per_call mode nothing is checked, since errors have already been checked
+ * after each call.
+ *
+ * \param path the source file path to be written in the exception in case of
+ * an error.
+ *
+ * \param line the source file line to be written in the exception in case of
+ * an error.
+ *
+ * \throws hou::gl::call_error if an OpenGL call has failed in the current
+ * frame.
+ */
+void HOU_GL_API check_frame_error(const std::string& path, uint line);
+
+/** Checks if the current OpenGL context supports reporting errors through a
+ * debug message callback (OpenGL 4.3 or KHR_debug).
+ *
+ * \return true if the debug message callback is supported.
+ */
+bool HOU_GL_API is_error_callback_supported();
+
+/** Installs a debug message callback recording the errors of the current
+ * OpenGL context.
+ *
+ * Debug output is made synchronous, so that errors are recorded in the thread
+ * and during the call that caused them, and all messages except errors are
+ * disabled.
+ * The recorded errors are raised by check_error and check_frame_error.
+ * The current context must support the debug message callback.
+ */
+void HOU_GL_API install_error_callback();
+
 }  // namespace gl
 
 }  // namespace hou
@@ -148,8 +205,11 @@ void HOU_GL_API check_error(const std::string& path, uint line);
 
 #ifdef HOU_ENABLE_GL_ERROR_CHECKS
 #define HOU_GL_CHECK_ERROR() ::hou::gl::check_error(__FILE__, __LINE__)
+#define HOU_GL_CHECK_FRAME_ERROR()                                             \
+  ::hou::gl::check_frame_error(__FILE__, __LINE__)
 #else
 #define HOU_GL_CHECK_ERROR()
+#define HOU_GL_CHECK_FRAME_ERROR()
 #endif
 
 #endif
@@ -0,0 +1,165 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_GL_GL_FRAME_STATS_HPP
+#define HOU_GL_GL_FRAME_STATS_HPP
+
+#include "hou/gl/gl_config.hpp"
+
+
+
+namespace hou
+{
+
+namespace gl
+{
+
+/**
+ * Collects counters about the GL work performed in a frame.
+ *
+ * The counters are updated by the hougl functions issuing draw calls, binding
+ * objects, and uploading buffer and texture data.
+ * They are only updated if the library was built with
+ * HOU_ENABLE_GL_FRAME_STATS. Otherwise the instrumentation compiles to
+ * nothing and all counters stay at 0.
+ *
+ * Each thread has its own counters for the current frame.
+ * end_frame_stats must be called at the end of every frame, which is done
+ * automatically by render_surface::display.
+ */
+class HOU_GL_API frame_stats
+{
+public:
+  /**
+   * Creates a frame_stats object with all counters set to 0.
+   */
+  frame_stats() noexcept;
+
+  /**
+   * Gets the number of draw calls.
+   *
+   * \return the number of draw calls.
+   */
+  size_t get_draw_call_count() const noexcept;
+
+  /**
+   * Gets the number of bind operations which were issued to the driver.
+   *
+   * \return the number of issued bind operations.
+   */
+  size_t get_issued_bind_count() const noexcept;
+
+  /**
+   * Gets the number of bind operations which were skipped because the object
+   * was already bound.
+   *
+   * \return the number of skipped bind operations.
+   */
+  size_t get_skipped_bind_count() const noexcept;
+
+  /**
+   * Gets the number of buffer data uploads.
+   *
+   * \return the number of buffer data uploads.
+   */
+  size_t get_buffer_upload_count() const noexcept;
+
+  /**
+   * Gets the number of bytes uploaded into buffers.
+   *
+   * \return the number of bytes uploaded into buffers.
+   */
+  size_t get_buffer_upload_byte_count() const noexcept;
+
+  /**
+   * Gets the number of texture data uploads.
+   *
+   * \return the number of texture data uploads.
+   */
+  size_t get_texture_upload_count() const noexcept;
+
+  /**
+   * Gets the number of bytes uploaded into textures.
+   *
+   * \return the number of bytes uploaded into textures.
+   */
+  size_t get_texture_upload_byte_count() const noexcept;
+
+  /**
+   * Records a draw call.
+   */
+  void record_draw_call() noexcept;
+
+  /**
+   * Records a bind operation.
+   *
+   * \param issued true if the operation was issued to the driver, false if it
+   * was skipped.
+   */
+  void record_bind(bool issued) noexcept;
+
+  /**
+   * Records a buffer data upload.
+   *
+   * \param byte_count the number of uploaded bytes.
+   */
+  void record_buffer_upload(size_t byte_count) noexcept;
+
+  /**
+   * Records a texture data upload.
+   *
+   * \param byte_count the number of uploaded bytes.
+   */
+  void record_texture_upload(size_t byte_count) noexcept;
+
+  /**
+   * Sets all counters to 0.
+   */
+  void reset() noexcept;
+
+private:
+  size_t m_draw_call_count;
+  size_t m_issued_bind_count;
+  size_t m_skipped_bind_count;
+  size_t m_buffer_upload_count;
+  size_t m_buffer_upload_byte_count;
+  size_t m_texture_upload_count;
+  size_t m_texture_upload_byte_count;
+};
+
+/**
+ * Gets the counters of the frame currently being rendered in this thread.
+ *
+ * \return the counters of the current frame.
+ */
+HOU_GL_API frame_stats& get_frame_stats() noexcept;
+
+/**
+ * Gets the counters of the last frame completed in this thread.
+ *
+ * \return the counters of the last completed frame.
+ */
+HOU_GL_API const frame_stats& get_last_frame_stats() noexcept;
+
+/**
+ * Ends the current frame in this thread.
+ *
+ * The counters of the current frame become the counters of the last frame,
+ * and the counters of the current frame are reset.
+ */
+HOU_GL_API void end_frame_stats() noexcept;
+
+}  // namespace gl
+
+}  // namespace hou
+
+
+
+#ifdef HOU_ENABLE_GL_FRAME_STATS
+#define HOU_GL_RECORD_FRAME_STAT(call) ::hou::gl::get_frame_stats().call
+#else
+#define HOU_GL_RECORD_FRAME_STAT(call)
+#endif
+
+#endif
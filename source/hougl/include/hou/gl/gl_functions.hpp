@@ -37,12 +37,22 @@ HOU_GL_API void set_clear_stencil(GLint stencil);
 HOU_GL_API void clear(GLenum mask);
 
 HOU_GL_API void set_blend_func(GLenum sfactor, GLenum dfactor);
+HOU_GL_API GLenum get_blend_src_factor();
+HOU_GL_API GLenum get_blend_dst_factor();
 HOU_GL_API void set_blend_equation(GLenum mode);
+HOU_GL_API GLenum get_blend_equation();
 HOU_GL_API void set_blend_color(GLfloat r, GLfloat g, GLfloat b, GLfloat a);
+HOU_GL_API void get_blend_color(GLfloat* color);
 
 HOU_GL_API void set_viewport(GLint x, GLint y, GLsizei w, GLsizei h);
 HOU_GL_API void set_polygon_mode(GLenum polygon_face, GLenum polygon_mode);
 HOU_GL_API void draw_arrays(GLenum draw_mode, GLint first, GLsizei count);
+HOU_GL_API void draw_arrays_instanced(
+  GLenum draw_mode, GLint first, GLsizei count, GLsizei instance_count);
+HOU_GL_API void draw_elements(
+  GLenum draw_mode, GLsizei count, GLenum index_type, GLintptr byte_offset);
+HOU_GL_API void draw_elements_instanced(GLenum draw_mode, GLsizei count,
+  GLenum index_type, GLintptr byte_offset, GLsizei instance_count);
 
 }  // namespace gl
 
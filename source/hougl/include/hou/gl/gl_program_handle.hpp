@@ -9,6 +9,9 @@
 
 #include "hou/gl/gl_config.hpp"
 
+#include <unordered_map>
+#include <vector>
+
 
 
 namespace hou
@@ -29,8 +32,83 @@ public:
 
   virtual ~program_handle();
 
+  /**
+   * Checks if a uniform value is equal to the value previously recorded.
+   *
+   * Used by the set_program_uniform functions to skip redundant uploads.
+   * This function only queries the cache, the callers record whether the
+   * upload was skipped in the context state change counts.
+   * The cache is stored in the program, like the uniform values themselves,
+   * so it is valid for all contexts sharing the program.
+   * The cache is not synchronized: the uniforms of a program must not be set
+   * concurrently from multiple threads.
+   *
+   * \param location the uniform location.
+   *
+   * \param type the uniform type.
+   *
+   * \param transpose the transposition flag, for matrix uniforms.
+   *
+   * \param data a pointer to the uniform value.
+   *
+   * \param byte_count the size of the uniform value in bytes.
+   *
+   * \return true if the value is cached and the upload can be skipped.
+   */
+  bool is_uniform_cached(GLint location, GLenum type, GLboolean transpose,
+    const void* data, size_t byte_count) const;
+
+  /**
+   * Records the value of a uniform.
+   *
+   * Must be called only after the value has been successfully uploaded, so
+   * that a failed upload is not skipped the next time.
+   *
+   * \param location the uniform location.
+   *
+   * \param type the uniform type.
+   *
+   * \param transpose the transposition flag, for matrix uniforms.
+   *
+   * \param data a pointer to the uniform value.
+   *
+   * \param byte_count the size of the uniform value in bytes.
+   */
+  void cache_uniform(GLint location, GLenum type, GLboolean transpose,
+    const void* data, size_t byte_count) const;
+
+  /**
+   * Removes the recorded values of a range of uniform locations.
+   *
+   * Must be called before uploading an uniform array, since array values are
+   * not recorded and the upload changes the values of all the elements.
+   *
+   * \param location the first uniform location.
+   *
+   * \param count the number of uniform locations.
+   */
+  void uncache_uniforms(GLint location, GLsizei count) const;
+
+  /**
+   * Clears the recorded uniform values.
+   *
+   * Must be called when the uniforms are reset, for example after linking.
+   */
+  void clear_uniform_cache() const noexcept;
+
+private:
+  struct uniform_value
+  {
+    GLenum type;
+    GLboolean transpose;
+    std::vector<uint8_t> data;
+  };
+
 private:
   program_handle(GLuint name);
+
+private:
+  mutable std::unordered_map<GLint, uniform_value> m_uniform_cache;
 };
 
 HOU_GL_API void bind_program(const program_handle& program);
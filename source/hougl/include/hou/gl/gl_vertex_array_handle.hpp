@@ -51,6 +51,7 @@ HOU_GL_API GLint get_max_vertex_attrib_bindings();
 HOU_GL_API void enable_vertex_array_attrib(GLuint index);
 HOU_GL_API void set_vertex_attrib_pointer(GLuint index, GLint size, GLenum type,
   GLboolean normalized, GLsizei stride, GLvoid* offset);
+HOU_GL_API void set_vertex_attrib_divisor(GLuint index, GLuint divisor);
 
 #else
 
@@ -66,6 +67,10 @@ HOU_GL_API void set_vertex_array_attrib_binding(
   const vertex_array_handle& vertex_array, GLuint attrib_index,
   GLuint binding_index);
 
+HOU_GL_API void set_vertex_array_binding_divisor(
+  const vertex_array_handle& vertex_array, GLuint binding_index,
+  GLuint divisor);
+
 HOU_GL_API void enable_vertex_array_attrib(
   const vertex_array_handle& vertex_array, GLuint index);
 
@@ -6,6 +6,7 @@
 
 #include "hou/gl/gl_context.hpp"
 #include "hou/gl/gl_exceptions.hpp"
+#include "hou/gl/gl_frame_stats.hpp"
 #include "hou/gl/gl_functions.hpp"
 #include "hou/gl/gl_invalid_context_error.hpp"
 #include "hou/gl/gl_missing_context_error.hpp"
@@ -120,6 +121,11 @@ void bind_buffer(const buffer_handle& buffer, GLenum target)
     HOU_GL_CHECK_ERROR();
     context::get_current()->m_tracking_data.set_bound_buffer(
       buffer.get_uid(), target);
+    HOU_GL_RECORD_FRAME_STAT(record_bind(true));
+  }
+  else
+  {
+    HOU_GL_RECORD_FRAME_STAT(record_bind(false));
   }
 }
 
@@ -178,6 +184,10 @@ void set_buffer_storage(const buffer_handle& buffer, GLsizei size,
   glNamedBufferStorage(buffer.get_name(), size, data, flags);
   HOU_GL_CHECK_ERROR();
 #endif
+  if(data != nullptr)
+  {
+    HOU_GL_RECORD_FRAME_STAT(record_buffer_upload(size));
+  }
 }
 
 
@@ -197,6 +207,7 @@ void set_buffer_sub_data(const buffer_handle& buffer, GLintptr offset,
   glNamedBufferSubData(buffer.get_name(), offset, size, data);
   HOU_GL_CHECK_ERROR();
 #endif
+  HOU_GL_RECORD_FRAME_STAT(record_buffer_upload(size));
 }
 
 
@@ -5,6 +5,7 @@
 #include "hou/gl/gl_context.hpp"
 
 #include "hou/gl/gl_context_exceptions.hpp"
+#include "hou/gl/gl_exceptions.hpp"
 #include "hou/gl/gl_vsync_mode.hpp"
 
 #include "hou/cor/assertions.hpp"
@@ -13,6 +14,7 @@
 
 #include <map>
 #include <mutex>
+#include <thread>
 
 #include "SDL_syswm.h"
 #include "SDL_video.h"
@@ -60,15 +62,20 @@ private:
 
 uint32_t generate_uid();
 
-SDL_GLContext create_context(const context_settings& cs, const SDL_Window* wnd);
+SDL_GLContext create_context(
+  const context_settings& cs, const SDL_Window* wnd, error_report_mode& erm);
 
 SDL_GLContext create_context_ext(const context_settings& cs,
-  const SDL_Window* wnd, const void* sharing_ctx);
+  const SDL_Window* wnd, const void* sharing_ctx, error_report_mode& erm);
 
 std::map<const context::impl_type*, context*>& get_context_registry();
 
 std::mutex& get_context_registry_mutex();
 
+context*& get_current_context_cache();
+
+error_report_mode select_error_report_mode(const context_settings& cs);
+
 
 
 current_context_guard::current_context_guard()
@@ -284,7 +291,8 @@ uint32_t generate_uid()
 
 
 
-SDL_GLContext create_context(const context_settings& cs, const SDL_Window* wnd)
+SDL_GLContext create_context(
+  const context_settings& cs, const SDL_Window* wnd, error_report_mode& erm)
 {
   // Note: contexts must alwasy be created with the share list parameter.
   // This enable contexts created in the future to share lists with them.
@@ -299,6 +307,11 @@ SDL_GLContext create_context(const context_settings& cs, const SDL_Window* wnd)
     context_creation_error, SDL_GetError());
   HOU_CHECK_N(SDL_GL_SetSwapInterval(0) == 0, context_creation_error,
     "Could not initialize vsync mode.");
+  erm = select_error_report_mode(cs);
+  if(erm == error_report_mode::debug_callback)
+  {
+    install_error_callback();
+  }
 
   return ctx;
 }
@@ -306,7 +319,7 @@ SDL_GLContext create_context(const context_settings& cs, const SDL_Window* wnd)
 
 
 SDL_GLContext create_context_ext(const context_settings& cs,
-  const SDL_Window* wnd, const void* sharing_ctx)
+  const SDL_Window* wnd, const void* sharing_ctx, error_report_mode& erm)
 {
   // The current context will be changed while constructing the new context.
   // Make sure that after the constructor has been called, the originally
@@ -322,8 +335,9 @@ SDL_GLContext create_context_ext(const context_settings& cs,
     // creating the new context.
     // If a sharing ctx has been specified, the extensions have already been
     // initialized for it.
-    sharing_ctx
-      = create_context(context_settings::get_basic(), tmp_wnd.get_impl());
+    error_report_mode tmp_erm;
+    sharing_ctx = create_context(
+      context_settings::get_basic(), tmp_wnd.get_impl(), tmp_erm);
   }
   // Make sharing_ctx current, so that the newly created context will share lists
   // with it.
@@ -336,7 +350,7 @@ SDL_GLContext create_context_ext(const context_settings& cs,
   HOU_ASSERT(sharing_ctx == SDL_GL_GetCurrentContext());
 
   // Create the actual context.
-  return create_context(cs, wnd);
+  return create_context(cs, wnd, erm);
 }
 
 
@@ -355,6 +369,35 @@ std::mutex& get_context_registry_mutex()
   return context_registry_mutex;
 }
 
+
+
+context*& get_current_context_cache()
+{
+  // The current context is cached per thread, so that retrieving it, which
+  // happens several times per draw call, does not require locking the
+  // registry mutex.
+  // The cache is kept up to date by set_current, unset_current, the move
+  // constructor, and the destructor. Each context records the thread it is
+  // current in, so that it is never moved or destroyed while it is still
+  // cached by another thread.
+  static thread_local context* current_context = nullptr;
+  return current_context;
+}
+
+
+
+error_report_mode select_error_report_mode(const context_settings& cs)
+{
+  // Must be called right after loading the functions for the context, since
+  // the availability of the debug functions depends on the loaded context.
+  if(!cs.debug_mode())
+  {
+    return error_report_mode::per_call;
+  }
+  return is_error_callback_supported() ? error_report_mode::debug_callback
+                                       : error_report_mode::per_frame;
+}
+
 }  // namespace
 
 
@@ -371,10 +414,19 @@ context& context::get_from_impl(not_null<const impl_type*> impl)
 
 void context::set_current(context& ctx, window& wnd)
 {
+  HOU_PRECOND(ctx.m_current_thread_id == std::thread::id()
+    || ctx.m_current_thread_id == std::this_thread::get_id());
   if(!ctx.is_current() || &wnd != get_current_window())
   {
     HOU_CHECK_N(SDL_GL_MakeCurrent(wnd.get_impl(), ctx.get_impl()) == 0,
       context_switch_error, SDL_GetError());
+    context*& current_ctx = get_current_context_cache();
+    if(current_ctx != nullptr)
+    {
+      current_ctx->m_current_thread_id = std::thread::id();
+    }
+    current_ctx = &ctx;
+    ctx.m_current_thread_id = std::this_thread::get_id();
   }
 }
 
@@ -386,6 +438,9 @@ void context::unset_current()
   {
     HOU_CHECK_N(SDL_GL_MakeCurrent(nullptr, nullptr) == 0, context_switch_error,
       SDL_GetError());
+    context*& current_ctx = get_current_context_cache();
+    current_ctx->m_current_thread_id = std::thread::id();
+    current_ctx = nullptr;
   }
 }
 
@@ -393,8 +448,9 @@ void context::unset_current()
 
 context* context::get_current()
 {
-  impl_type* ctx_impl = SDL_GL_GetCurrentContext();
-  return ctx_impl == nullptr ? nullptr : &get_from_impl(ctx_impl);
+  HOU_DEV_ASSERT(get_current_context_cache() == nullptr
+    || get_current_context_cache()->m_impl == SDL_GL_GetCurrentContext());
+  return get_current_context_cache();
 }
 
 
@@ -423,14 +479,21 @@ context::context(
 context::context(
   const context_settings& cs, const window& wnd, const context* sharing_ctx)
   : non_copyable()
-  , m_impl(create_context_ext(cs, wnd.get_impl(),
-      sharing_ctx == nullptr ? nullptr : sharing_ctx->get_impl()))
+  , m_impl(nullptr)
   , m_uid(generate_uid())
   , m_sharing_group_uid(
       sharing_ctx == nullptr ? m_uid : sharing_ctx->m_sharing_group_uid)
   , m_tracking_data()
   , m_settings(cs)
+  , m_error_report_mode(error_report_mode::per_call)
+  , m_current_thread_id()
 {
+  // The error report mode can only be selected while the functions of the new
+  // context are loaded, so it is set when creating the context.
+  m_impl = create_context_ext(cs, wnd.get_impl(),
+    sharing_ctx == nullptr ? nullptr : sharing_ctx->get_impl(),
+    m_error_report_mode);
+
   std::lock_guard<std::mutex> lock(get_context_registry_mutex());
   get_context_registry().insert(std::make_pair(m_impl, this));
 }
@@ -444,9 +507,21 @@ context::context(context&& other) noexcept
   , m_sharing_group_uid(std::move(other.m_sharing_group_uid))
   , m_tracking_data(std::move(other.m_tracking_data))
   , m_settings(std::move(other.m_settings))
+  , m_error_report_mode(other.m_error_report_mode)
+  , m_current_thread_id(other.m_current_thread_id.load())
 {
+  // Only the cache of the current thread can be updated.
+  HOU_ASSERT(m_current_thread_id == std::thread::id()
+    || m_current_thread_id == std::this_thread::get_id());
+
   other.m_impl = nullptr;
   other.m_uid = 0u;
+  other.m_current_thread_id = std::thread::id();
+
+  if(get_current_context_cache() == &other)
+  {
+    get_current_context_cache() = this;
+  }
 
   std::lock_guard<std::mutex> lock(get_context_registry_mutex());
   get_context_registry().at(m_impl) = this;
@@ -456,6 +531,14 @@ context::context(context&& other) noexcept
 
 context::~context()
 {
+  // Only the cache of the current thread can be updated.
+  HOU_ASSERT(m_current_thread_id == std::thread::id()
+    || m_current_thread_id == std::this_thread::get_id());
+  if(get_current_context_cache() == this)
+  {
+    // Deleting the current context makes no context current.
+    get_current_context_cache() = nullptr;
+  }
   if(m_impl != nullptr)
   {
     SDL_GL_DeleteContext(m_impl);
@@ -496,7 +579,7 @@ context::uid_type context::get_sharing_group_uid() const noexcept
 
 bool context::is_current() const
 {
-  return m_impl == SDL_GL_GetCurrentContext();
+  return this == get_current_context_cache();
 }
 
 
@@ -508,6 +591,34 @@ const context_settings& context::get_settings() const noexcept
 
 
 
+error_report_mode context::get_error_report_mode() const noexcept
+{
+  return m_error_report_mode;
+}
+
+
+
+size_t context::get_issued_state_change_count() const noexcept
+{
+  return m_tracking_data.get_issued_state_change_count();
+}
+
+
+
+size_t context::get_skipped_state_change_count() const noexcept
+{
+  return m_tracking_data.get_skipped_state_change_count();
+}
+
+
+
+void context::reset_state_change_counts() noexcept
+{
+  m_tracking_data.reset_state_change_counts();
+}
+
+
+
 context::tracking_data::tracking_data() noexcept
   : m_bound_array_buffer(0u)
   , m_bound_element_array_buffer(0u)
@@ -519,6 +630,14 @@ context::tracking_data::tracking_data() noexcept
   , m_bound_textures(1u, 0u)
   , m_bound_texture_targets(1u, 0)
   , m_current_viewport(0, 0, 0, 0)
+  , m_blending_enabled(false)
+  , m_multisampling_enabled(true)
+  , m_blend_src_factor(GL_ONE)
+  , m_blend_dst_factor(GL_ZERO)
+  , m_blend_equation(GL_FUNC_ADD)
+  , m_blend_color{{0.f, 0.f, 0.f, 0.f}}
+  , m_issued_state_change_count(0u)
+  , m_skipped_state_change_count(0u)
 {}
 
 
@@ -721,6 +840,125 @@ void context::tracking_data::set_current_viewport(
   m_current_viewport = viewport;
 }
 
+
+
+bool context::tracking_data::is_capability_tracked(GLenum cap) noexcept
+{
+  return cap == GL_BLEND || cap == GL_MULTISAMPLE;
+}
+
+
+
+bool context::tracking_data::is_capability_enabled(GLenum cap) const noexcept
+{
+  HOU_DEV_ASSERT(is_capability_tracked(cap));
+  return cap == GL_BLEND ? m_blending_enabled : m_multisampling_enabled;
+}
+
+
+
+void context::tracking_data::set_capability_enabled(
+  GLenum cap, bool value) noexcept
+{
+  HOU_DEV_ASSERT(is_capability_tracked(cap));
+  if(cap == GL_BLEND)
+  {
+    m_blending_enabled = value;
+  }
+  else
+  {
+    m_multisampling_enabled = value;
+  }
+}
+
+
+
+GLenum context::tracking_data::get_blend_src_factor() const noexcept
+{
+  return m_blend_src_factor;
+}
+
+
+
+GLenum context::tracking_data::get_blend_dst_factor() const noexcept
+{
+  return m_blend_dst_factor;
+}
+
+
+
+void context::tracking_data::set_blend_factors(GLenum src, GLenum dst) noexcept
+{
+  m_blend_src_factor = src;
+  m_blend_dst_factor = dst;
+}
+
+
+
+GLenum context::tracking_data::get_blend_equation() const noexcept
+{
+  return m_blend_equation;
+}
+
+
+
+void context::tracking_data::set_blend_equation(GLenum mode) noexcept
+{
+  m_blend_equation = mode;
+}
+
+
+
+const std::array<GLfloat, 4u>& context::tracking_data::get_blend_color() const
+  noexcept
+{
+  return m_blend_color;
+}
+
+
+
+void context::tracking_data::set_blend_color(
+  const std::array<GLfloat, 4u>& color) noexcept
+{
+  m_blend_color = color;
+}
+
+
+
+size_t context::tracking_data::get_issued_state_change_count() const noexcept
+{
+  return m_issued_state_change_count;
+}
+
+
+
+size_t context::tracking_data::get_skipped_state_change_count() const noexcept
+{
+  return m_skipped_state_change_count;
+}
+
+
+
+void context::tracking_data::record_state_change(bool issued) noexcept
+{
+  if(issued)
+  {
+    ++m_issued_state_change_count;
+  }
+  else
+  {
+    ++m_skipped_state_change_count;
+  }
+}
+
+
+
+void context::tracking_data::reset_state_change_counts() noexcept
+{
+  m_issued_state_change_count = 0u;
+  m_skipped_state_change_count = 0u;
+}
+
 }  // namespace gl
 
 }  // namespace hou
@@ -0,0 +1,34 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gl/gl_error_report_mode.hpp"
+
+#include "hou/cor/core_functions.hpp"
+
+#define ERROR_REPORT_MODE_CASE(erm, os)                                        \
+  case error_report_mode::erm:                                                 \
+    return (os) << #erm
+
+
+
+namespace hou
+{
+
+namespace gl
+{
+
+std::ostream& operator<<(std::ostream& os, error_report_mode erm)
+{
+  switch(erm)
+  {
+    ERROR_REPORT_MODE_CASE(per_call, os);
+    ERROR_REPORT_MODE_CASE(debug_callback, os);
+    ERROR_REPORT_MODE_CASE(per_frame, os);
+  }
+  return STREAM_VALUE(os, error_report_mode, erm);
+}
+
+}  // namespace gl
+
+}  // namespace hou
@@ -4,6 +4,8 @@
 
 #include "hou/gl/gl_exceptions.hpp"
 
+#include "hou/gl/gl_context.hpp"
+
 
 
 namespace hou
@@ -19,6 +21,18 @@ std::string get_error_message(GLenum err);
 
 std::string get_shader_type_name(GLenum shader_type);
 
+std::string& get_pending_debug_error();
+
+error_report_mode get_current_error_report_mode();
+
+void raise_error_codes(const std::string& path, uint line);
+
+void raise_pending_debug_error(const std::string& path, uint line);
+
+void APIENTRY debug_message_callback(GLenum source, GLenum type, GLuint id,
+  GLenum severity, GLsizei length, const GLchar* message,
+  const void* user_param);
+
 std::string get_error_message(GLenum err)
 {
   switch(err)
@@ -65,6 +79,63 @@ std::string get_shader_type_name(GLenum shader_type)
   }
 }
 
+
+
+std::string& get_pending_debug_error()
+{
+  // Synchronous debug output calls the callback in the thread performing the
+  // failing call, so the pending error is stored per thread.
+  static thread_local std::string pending_error;
+  return pending_error;
+}
+
+
+
+error_report_mode get_current_error_report_mode()
+{
+  const context* ctx = context::get_current();
+  return ctx == nullptr ? error_report_mode::per_call
+                        : ctx->get_error_report_mode();
+}
+
+
+
+void raise_error_codes(const std::string& path, uint line)
+{
+  for(GLenum err; (err = glGetError()) != GL_NO_ERROR;)
+  {
+    HOU_ERROR_STD_N(call_error, path, line, err);
+  }
+}
+
+
+
+void raise_pending_debug_error(const std::string& path, uint line)
+{
+  std::string& pending_error = get_pending_debug_error();
+  if(!pending_error.empty())
+  {
+    std::string message;
+    std::swap(message, pending_error);
+    HOU_ERROR_STD_N(call_error, path, line, message);
+  }
+}
+
+
+
+void APIENTRY debug_message_callback(GLenum, GLenum type, GLuint, GLenum,
+  GLsizei length, const GLchar* message, const void*)
+{
+  // Exceptions must not be thrown through the driver, the error is raised by
+  // the next check instead. Only the first error since the last check is kept.
+  std::string& pending_error = get_pending_debug_error();
+  if(type == GL_DEBUG_TYPE_ERROR && pending_error.empty())
+  {
+    pending_error = length < 0 ? std::string(message)
+                               : std::string(message, length);
+  }
+}
+
 }  // namespace
 
 
@@ -113,14 +184,67 @@ call_error::call_error(const std::string& path, uint line, GLenum ec)
 
 
 
+call_error::call_error(
+  const std::string& path, uint line, const std::string& message)
+  : exception(path, line, format_string(u8"OpenGL error: %s", message.c_str()))
+{}
+
+
+
 void check_error(const std::string& path, uint line)
 {
-  for(GLenum err; (err = glGetError()) != GL_NO_ERROR;)
+  switch(get_current_error_report_mode())
   {
-    HOU_ERROR_STD_N(call_error, path, line, err);
+    case error_report_mode::per_call:
+      raise_error_codes(path, line);
+      break;
+    case error_report_mode::debug_callback:
+      raise_pending_debug_error(path, line);
+      break;
+    case error_report_mode::per_frame:
+      break;
   }
 }
 
+
+
+void check_frame_error(const std::string& path, uint line)
+{
+  switch(get_current_error_report_mode())
+  {
+    case error_report_mode::per_call:
+      break;
+    case error_report_mode::debug_callback:
+      raise_pending_debug_error(path, line);
+      break;
+    case error_report_mode::per_frame:
+      raise_error_codes(path, line);
+      break;
+  }
+}
+
+
+
+bool is_error_callback_supported()
+{
+  return (GLAD_GL_VERSION_4_3 || GLAD_GL_ES_VERSION_3_2 || GLAD_GL_KHR_debug)
+    && glDebugMessageCallback != nullptr;
+}
+
+
+
+void install_error_callback()
+{
+  HOU_PRECOND(is_error_callback_supported());
+  glEnable(GL_DEBUG_OUTPUT);
+  glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+  glDebugMessageControl(
+    GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, nullptr, GL_FALSE);
+  glDebugMessageControl(
+    GL_DONT_CARE, GL_DEBUG_TYPE_ERROR, GL_DONT_CARE, 0, nullptr, GL_TRUE);
+  glDebugMessageCallback(debug_message_callback, nullptr);
+}
+
 }  // namespace gl
 
 }  // namespace hou
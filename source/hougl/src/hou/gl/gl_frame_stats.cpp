@@ -0,0 +1,160 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/gl/gl_frame_stats.hpp"
+
+
+
+namespace hou
+{
+
+namespace gl
+{
+
+namespace
+{
+
+frame_stats& get_last_frame_stats_internal() noexcept;
+
+
+
+frame_stats& get_last_frame_stats_internal() noexcept
+{
+  static thread_local frame_stats stats;
+  return stats;
+}
+
+}  // namespace
+
+
+
+frame_stats::frame_stats() noexcept
+  : m_draw_call_count(0u)
+  , m_issued_bind_count(0u)
+  , m_skipped_bind_count(0u)
+  , m_buffer_upload_count(0u)
+  , m_buffer_upload_byte_count(0u)
+  , m_texture_upload_count(0u)
+  , m_texture_upload_byte_count(0u)
+{}
+
+
+
+size_t frame_stats::get_draw_call_count() const noexcept
+{
+  return m_draw_call_count;
+}
+
+
+
+size_t frame_stats::get_issued_bind_count() const noexcept
+{
+  return m_issued_bind_count;
+}
+
+
+
+size_t frame_stats::get_skipped_bind_count() const noexcept
+{
+  return m_skipped_bind_count;
+}
+
+
+
+size_t frame_stats::get_buffer_upload_count() const noexcept
+{
+  return m_buffer_upload_count;
+}
+
+
+
+size_t frame_stats::get_buffer_upload_byte_count() const noexcept
+{
+  return m_buffer_upload_byte_count;
+}
+
+
+
+size_t frame_stats::get_texture_upload_count() const noexcept
+{
+  return m_texture_upload_count;
+}
+
+
+
+size_t frame_stats::get_texture_upload_byte_count() const noexcept
+{
+  return m_texture_upload_byte_count;
+}
+
+
+
+void frame_stats::record_draw_call() noexcept
+{
+  ++m_draw_call_count;
+}
+
+
+
+void frame_stats::record_bind(bool issued) noexcept
+{
+  if(issued)
+  {
+    ++m_issued_bind_count;
+  }
+  else
+  {
+    ++m_skipped_bind_count;
+  }
+}
+
+
+
+void frame_stats::record_buffer_upload(size_t byte_count) noexcept
+{
+  ++m_buffer_upload_count;
+  m_buffer_upload_byte_count += byte_count;
+}
+
+
+
+void frame_stats::record_texture_upload(size_t byte_count) noexcept
+{
+  ++m_texture_upload_count;
+  m_texture_upload_byte_count += byte_count;
+}
+
+
+
+void frame_stats::reset() noexcept
+{
+  *this = frame_stats();
+}
+
+
+
+frame_stats& get_frame_stats() noexcept
+{
+  static thread_local frame_stats stats;
+  return stats;
+}
+
+
+
+const frame_stats& get_last_frame_stats() noexcept
+{
+  return get_last_frame_stats_internal();
+}
+
+
+
+void end_frame_stats() noexcept
+{
+  get_last_frame_stats_internal() = get_frame_stats();
+  get_frame_stats().reset();
+}
+
+}  // namespace gl
+
+}  // namespace hou
@@ -7,12 +7,16 @@
 #include "hou/gl/gl_context.hpp"
 #include "hou/gl/gl_context_settings.hpp"
 #include "hou/gl/gl_exceptions.hpp"
+#include "hou/gl/gl_frame_stats.hpp"
 #include "hou/gl/gl_missing_context_error.hpp"
 
 #include "hou/cor/narrow_cast.hpp"
 
 #include "hou/mth/rectangle.hpp"
 
+#include <algorithm>
+#include <array>
+
 
 
 namespace hou
@@ -34,6 +38,11 @@ const GLubyte* get_gl_version_string()
 GLboolean is_enabled(GLenum val)
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  const context::tracking_data& td = context::get_current()->m_tracking_data;
+  if(context::tracking_data::is_capability_tracked(val))
+  {
+    return td.is_capability_enabled(val) ? GL_TRUE : GL_FALSE;
+  }
   GLboolean retval = glIsEnabled(val);
   HOU_GL_CHECK_ERROR();
   return retval;
@@ -44,8 +53,20 @@ GLboolean is_enabled(GLenum val)
 void enable(GLenum val)
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  context::tracking_data& td = context::get_current()->m_tracking_data;
+  bool tracked = context::tracking_data::is_capability_tracked(val);
+  if(tracked && td.is_capability_enabled(val))
+  {
+    td.record_state_change(false);
+    return;
+  }
   glEnable(val);
   HOU_GL_CHECK_ERROR();
+  if(tracked)
+  {
+    td.set_capability_enabled(val, true);
+    td.record_state_change(true);
+  }
 }
 
 
@@ -53,8 +74,20 @@ void enable(GLenum val)
 void disable(GLenum val)
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  context::tracking_data& td = context::get_current()->m_tracking_data;
+  bool tracked = context::tracking_data::is_capability_tracked(val);
+  if(tracked && !td.is_capability_enabled(val))
+  {
+    td.record_state_change(false);
+    return;
+  }
   glDisable(val);
   HOU_GL_CHECK_ERROR();
+  if(tracked)
+  {
+    td.set_capability_enabled(val, false);
+    td.record_state_change(true);
+  }
 }
 
 
@@ -125,18 +158,56 @@ void clear(GLenum mask)
 void set_blend_func(GLenum sfactor, GLenum dfactor)
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
-  glBlendFunc(sfactor, dfactor);
-  HOU_GL_CHECK_ERROR();
+  context::tracking_data& td = context::get_current()->m_tracking_data;
+  bool changed = sfactor != td.get_blend_src_factor()
+    || dfactor != td.get_blend_dst_factor();
+  if(changed)
+  {
+    glBlendFunc(sfactor, dfactor);
+    HOU_GL_CHECK_ERROR();
+    td.set_blend_factors(sfactor, dfactor);
+  }
+  td.record_state_change(changed);
+}
+
+
+
+GLenum get_blend_src_factor()
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  return context::get_current()->m_tracking_data.get_blend_src_factor();
 }
 
 
 
+GLenum get_blend_dst_factor()
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  return context::get_current()->m_tracking_data.get_blend_dst_factor();
+}
+
+
 
 void set_blend_equation(GLenum mode)
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
-  glBlendEquation(mode);
-  HOU_GL_CHECK_ERROR();
+  context::tracking_data& td = context::get_current()->m_tracking_data;
+  bool changed = mode != td.get_blend_equation();
+  if(changed)
+  {
+    glBlendEquation(mode);
+    HOU_GL_CHECK_ERROR();
+    td.set_blend_equation(mode);
+  }
+  td.record_state_change(changed);
+}
+
+
+
+GLenum get_blend_equation()
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  return context::get_current()->m_tracking_data.get_blend_equation();
 }
 
 
@@ -144,8 +215,26 @@ void set_blend_equation(GLenum mode)
 void set_blend_color(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
-  glBlendColor(r, g, b, a);
-  HOU_GL_CHECK_ERROR();
+  context::tracking_data& td = context::get_current()->m_tracking_data;
+  std::array<GLfloat, 4u> color{{r, g, b, a}};
+  bool changed = color != td.get_blend_color();
+  if(changed)
+  {
+    glBlendColor(r, g, b, a);
+    HOU_GL_CHECK_ERROR();
+    td.set_blend_color(color);
+  }
+  td.record_state_change(changed);
+}
+
+
+
+void get_blend_color(GLfloat* color)
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  const std::array<GLfloat, 4u>& tracked_color
+    = context::get_current()->m_tracking_data.get_blend_color();
+  std::copy(tracked_color.begin(), tracked_color.end(), color);
 }
 
 
@@ -153,13 +242,17 @@ void set_blend_color(GLfloat r, GLfloat g, GLfloat b, GLfloat a)
 void set_viewport(GLint x, GLint y, GLsizei w, GLsizei h)
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
-  const recti& currVp
-    = context::get_current()->m_tracking_data.get_current_viewport();
-  if(x != currVp.x() || y != currVp.y() || w != currVp.w() || h != currVp.h())
+  context::tracking_data& td = context::get_current()->m_tracking_data;
+  const recti& currVp = td.get_current_viewport();
+  bool changed
+    = x != currVp.x() || y != currVp.y() || w != currVp.w() || h != currVp.h();
+  if(changed)
   {
     glViewport(x, y, w, h);
     HOU_GL_CHECK_ERROR();
+    td.set_current_viewport(recti(x, y, w, h));
   }
+  td.record_state_change(changed);
 }
 
 
@@ -178,6 +271,42 @@ void draw_arrays(GLenum draw_mode, GLint first, GLsizei count)
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   glDrawArrays(draw_mode, first, count);
   HOU_GL_CHECK_ERROR();
+  HOU_GL_RECORD_FRAME_STAT(record_draw_call());
+}
+
+
+
+void draw_arrays_instanced(
+  GLenum draw_mode, GLint first, GLsizei count, GLsizei instance_count)
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  glDrawArraysInstanced(draw_mode, first, count, instance_count);
+  HOU_GL_CHECK_ERROR();
+  HOU_GL_RECORD_FRAME_STAT(record_draw_call());
+}
+
+
+
+void draw_elements(
+  GLenum draw_mode, GLsizei count, GLenum index_type, GLintptr byte_offset)
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  glDrawElements(draw_mode, count, index_type,
+    reinterpret_cast<const GLvoid*>(byte_offset));
+  HOU_GL_CHECK_ERROR();
+  HOU_GL_RECORD_FRAME_STAT(record_draw_call());
+}
+
+
+
+void draw_elements_instanced(GLenum draw_mode, GLsizei count,
+  GLenum index_type, GLintptr byte_offset, GLsizei instance_count)
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  glDrawElementsInstanced(draw_mode, count, index_type,
+    reinterpret_cast<const GLvoid*>(byte_offset), instance_count);
+  HOU_GL_CHECK_ERROR();
+  HOU_GL_RECORD_FRAME_STAT(record_draw_call());
 }
 
 }  // namespace gl
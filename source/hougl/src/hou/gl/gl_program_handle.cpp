@@ -12,6 +12,9 @@
 
 #include "hou/cor/assertions.hpp"
 #include "hou/cor/character_encodings.hpp"
+#include "hou/cor/narrow_cast.hpp"
+
+#include <algorithm>
 
 
 
@@ -41,8 +44,51 @@ program_handle::~program_handle()
 
 
 
+bool program_handle::is_uniform_cached(GLint location, GLenum type,
+  GLboolean transpose, const void* data, size_t byte_count) const
+{
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  auto it = m_uniform_cache.find(location);
+  return it != m_uniform_cache.end() && it->second.type == type
+    && it->second.transpose == transpose
+    && it->second.data.size() == byte_count
+    && std::equal(bytes, bytes + byte_count, it->second.data.begin());
+}
+
+
+
+void program_handle::cache_uniform(GLint location, GLenum type,
+  GLboolean transpose, const void* data, size_t byte_count) const
+{
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+  uniform_value& value = m_uniform_cache[location];
+  value.type = type;
+  value.transpose = transpose;
+  value.data.assign(bytes, bytes + byte_count);
+}
+
+
+
+void program_handle::uncache_uniforms(GLint location, GLsizei count) const
+{
+  for(GLsizei i = 0; i < count; ++i)
+  {
+    m_uniform_cache.erase(location + i);
+  }
+}
+
+
+
+void program_handle::clear_uniform_cache() const noexcept
+{
+  m_uniform_cache.clear();
+}
+
+
+
 program_handle::program_handle(GLuint name)
   : shared_object_handle(name)
+  , m_uniform_cache()
 {}
 
 
@@ -122,6 +168,9 @@ void link_program(const program_handle& program)
   glLinkProgram(program.get_name());
   HOU_GL_CHECK_ERROR();
 
+  // Linking resets all uniforms to their default values.
+  program.clear_uniform_cache();
+
   GLint success = 0;
   glGetProgramiv(program.get_name(), GL_LINK_STATUS, &success);
   HOU_GL_CHECK_ERROR();
@@ -155,8 +204,16 @@ void set_program_uniform_i(
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform1i(program.get_name(), location, v0);
-  HOU_GL_CHECK_ERROR();
+  GLint values[] = {v0};
+  bool changed = !program.is_uniform_cached(
+    location, GL_INT, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform1i(program.get_name(), location, v0);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(location, GL_INT, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -166,8 +223,17 @@ void set_program_uniform_i(
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform2i(program.get_name(), location, v0, v1);
-  HOU_GL_CHECK_ERROR();
+  GLint values[] = {v0, v1};
+  bool changed = !program.is_uniform_cached(
+    location, GL_INT_VEC2, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform2i(program.get_name(), location, v0, v1);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      location, GL_INT_VEC2, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -177,8 +243,17 @@ void set_program_uniform_i(
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform3i(program.get_name(), location, v0, v1, v2);
-  HOU_GL_CHECK_ERROR();
+  GLint values[] = {v0, v1, v2};
+  bool changed = !program.is_uniform_cached(
+    location, GL_INT_VEC3, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform3i(program.get_name(), location, v0, v1, v2);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      location, GL_INT_VEC3, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -188,8 +263,17 @@ void set_program_uniform_i(const program_handle& program, GLint location,
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform4i(program.get_name(), location, v0, v1, v2, v3);
-  HOU_GL_CHECK_ERROR();
+  GLint values[] = {v0, v1, v2, v3};
+  bool changed = !program.is_uniform_cached(
+    location, GL_INT_VEC4, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform4i(program.get_name(), location, v0, v1, v2, v3);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      location, GL_INT_VEC4, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -199,8 +283,18 @@ void set_program_uniform_u(
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform1ui(program.get_name(), location, v0);
-  HOU_GL_CHECK_ERROR();
+  GLuint values[] = {v0};
+  GLint loc = narrow_cast<GLint>(location);
+  bool changed = !program.is_uniform_cached(
+    loc, GL_UNSIGNED_INT, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform1ui(program.get_name(), location, v0);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      loc, GL_UNSIGNED_INT, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -210,8 +304,18 @@ void set_program_uniform_u(
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform2ui(program.get_name(), location, v0, v1);
-  HOU_GL_CHECK_ERROR();
+  GLuint values[] = {v0, v1};
+  GLint loc = narrow_cast<GLint>(location);
+  bool changed = !program.is_uniform_cached(
+    loc, GL_UNSIGNED_INT_VEC2, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform2ui(program.get_name(), location, v0, v1);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      loc, GL_UNSIGNED_INT_VEC2, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -221,8 +325,18 @@ void set_program_uniform_u(const program_handle& program, GLuint location,
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform3ui(program.get_name(), location, v0, v1, v2);
-  HOU_GL_CHECK_ERROR();
+  GLuint values[] = {v0, v1, v2};
+  GLint loc = narrow_cast<GLint>(location);
+  bool changed = !program.is_uniform_cached(
+    loc, GL_UNSIGNED_INT_VEC3, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform3ui(program.get_name(), location, v0, v1, v2);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      loc, GL_UNSIGNED_INT_VEC3, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -232,8 +346,18 @@ void set_program_uniform_u(const program_handle& program, GLuint location,
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform4ui(program.get_name(), location, v0, v1, v2, v3);
-  HOU_GL_CHECK_ERROR();
+  GLuint values[] = {v0, v1, v2, v3};
+  GLint loc = narrow_cast<GLint>(location);
+  bool changed = !program.is_uniform_cached(
+    loc, GL_UNSIGNED_INT_VEC4, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform4ui(program.get_name(), location, v0, v1, v2, v3);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      loc, GL_UNSIGNED_INT_VEC4, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -243,8 +367,16 @@ void set_program_uniform_f(
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform1f(program.get_name(), location, v0);
-  HOU_GL_CHECK_ERROR();
+  GLfloat values[] = {v0};
+  bool changed = !program.is_uniform_cached(
+    location, GL_FLOAT, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform1f(program.get_name(), location, v0);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(location, GL_FLOAT, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -254,8 +386,17 @@ void set_program_uniform_f(
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform2f(program.get_name(), location, v0, v1);
-  HOU_GL_CHECK_ERROR();
+  GLfloat values[] = {v0, v1};
+  bool changed = !program.is_uniform_cached(
+    location, GL_FLOAT_VEC2, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform2f(program.get_name(), location, v0, v1);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      location, GL_FLOAT_VEC2, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -265,8 +406,17 @@ void set_program_uniform_f(const program_handle& program, GLint location,
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform3f(program.get_name(), location, v0, v1, v2);
-  HOU_GL_CHECK_ERROR();
+  GLfloat values[] = {v0, v1, v2};
+  bool changed = !program.is_uniform_cached(
+    location, GL_FLOAT_VEC3, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform3f(program.get_name(), location, v0, v1, v2);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      location, GL_FLOAT_VEC3, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -276,8 +426,17 @@ void set_program_uniform_f(const program_handle& program, GLint location,
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniform4f(program.get_name(), location, v0, v1, v2, v3);
-  HOU_GL_CHECK_ERROR();
+  GLfloat values[] = {v0, v1, v2, v3};
+  bool changed = !program.is_uniform_cached(
+    location, GL_FLOAT_VEC4, GL_FALSE, values, sizeof(values));
+  if(changed)
+  {
+    glProgramUniform4f(program.get_name(), location, v0, v1, v2, v3);
+    HOU_GL_CHECK_ERROR();
+    program.cache_uniform(
+      location, GL_FLOAT_VEC4, GL_FALSE, values, sizeof(values));
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 
@@ -287,9 +446,24 @@ void set_program_uniform_mat4x4f(const program_handle& program, GLint location,
 {
   HOU_GL_CHECK_CONTEXT_EXISTENCE();
   HOU_GL_CHECK_CONTEXT_OWNERSHIP(program);
-  glProgramUniformMatrix4fv(
-    program.get_name(), location, count, transpose, values);
-  HOU_GL_CHECK_ERROR();
+  // Arrays are not cached: their elements can also be set one by one through
+  // the following locations, which would leave the cached array stale.
+  bool changed = count != 1
+    || !program.is_uniform_cached(
+         location, GL_FLOAT_MAT4, transpose, values, 16u * sizeof(GLfloat));
+  if(changed)
+  {
+    program.uncache_uniforms(location, count);
+    glProgramUniformMatrix4fv(
+      program.get_name(), location, count, transpose, values);
+    HOU_GL_CHECK_ERROR();
+    if(count == 1)
+    {
+      program.cache_uniform(
+        location, GL_FLOAT_MAT4, transpose, values, 16u * sizeof(GLfloat));
+    }
+  }
+  context::get_current()->m_tracking_data.record_state_change(changed);
 }
 
 }  // namespace gl
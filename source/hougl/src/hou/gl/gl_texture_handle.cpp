@@ -6,6 +6,7 @@
 
 #include "hou/gl/gl_context.hpp"
 #include "hou/gl/gl_exceptions.hpp"
+#include "hou/gl/gl_frame_stats.hpp"
 #include "hou/gl/gl_functions.hpp"
 #include "hou/gl/gl_invalid_context_error.hpp"
 #include "hou/gl/gl_missing_context_error.hpp"
@@ -57,6 +58,8 @@ GLenum internal_format_to_type(GLenum internal_format);
 
 GLenum internal_format_to_byte_count(GLenum internal_format);
 
+size_t pixel_format_and_type_to_byte_count(GLenum format, GLenum type);
+
 void get_texture_parameter_iv(
   const texture_handle& tex, GLenum param, GLint* value);
 
@@ -207,6 +210,54 @@ GLenum internal_format_to_byte_count(GLenum internal_format)
 
 
 
+size_t pixel_format_and_type_to_byte_count(GLenum format, GLenum type)
+{
+  size_t component_count = 0u;
+  switch(format)
+  {
+    case GL_RED:
+    case GL_DEPTH_COMPONENT:
+      component_count = 1u;
+      break;
+    case GL_RG:
+      component_count = 2u;
+      break;
+    case GL_RGB:
+      component_count = 3u;
+      break;
+    case GL_RGBA:
+      component_count = 4u;
+      break;
+    case GL_DEPTH_STENCIL:
+      // Depth stencil data always uses a packed type.
+      component_count = 1u;
+      break;
+    default:
+      HOU_ERROR_N(invalid_enum, narrow_cast<int>(format));
+      return 0u;
+  }
+
+  switch(type)
+  {
+    case GL_UNSIGNED_BYTE:
+    case GL_BYTE:
+      return component_count;
+    case GL_UNSIGNED_SHORT:
+    case GL_SHORT:
+    case GL_HALF_FLOAT:
+      return component_count * 2u;
+    case GL_UNSIGNED_INT:
+    case GL_INT:
+    case GL_FLOAT:
+    case GL_UNSIGNED_INT_24_8:
+      return component_count * 4u;
+  }
+  HOU_ERROR_N(invalid_enum, narrow_cast<int>(type));
+  return 0u;
+}
+
+
+
 void get_texture_parameter_iv(
   const texture_handle& tex, GLenum param, GLint* value)
 {
@@ -339,6 +390,11 @@ void bind_texture(const texture_handle& tex)
     HOU_GL_CHECK_ERROR();
     context::get_current()->m_tracking_data.set_bound_texture(
       tex.get_uid(), tex.get_target());
+    HOU_GL_RECORD_FRAME_STAT(record_bind(true));
+  }
+  else
+  {
+    HOU_GL_RECORD_FRAME_STAT(record_bind(false));
   }
 }
 
@@ -375,6 +431,11 @@ void bind_texture(const texture_handle& tex, GLuint unit)
     HOU_GL_CHECK_ERROR();
     context::get_current()->m_tracking_data.set_bound_texture(
       tex.get_uid(), unit, tex.get_target());
+    HOU_GL_RECORD_FRAME_STAT(record_bind(true));
+  }
+  else
+  {
+    HOU_GL_RECORD_FRAME_STAT(record_bind(false));
   }
 }
 
@@ -614,6 +675,8 @@ void set_texture_sub_image_2d(const texture_handle& tex, GLint level,
     format, type, pixels);
   HOU_GL_CHECK_ERROR();
 #endif
+  HOU_GL_RECORD_FRAME_STAT(record_texture_upload(
+    pixel_format_and_type_to_byte_count(format, type) * width * height));
 }
 
 
@@ -636,6 +699,9 @@ void set_texture_sub_image_3d(const texture_handle& tex, GLint level,
     height, depth, format, type, pixels);
   HOU_GL_CHECK_ERROR();
 #endif
+  HOU_GL_RECORD_FRAME_STAT(record_texture_upload(
+    pixel_format_and_type_to_byte_count(format, type) * width * height
+    * depth));
 }
 
 
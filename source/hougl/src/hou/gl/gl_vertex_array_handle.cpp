@@ -150,9 +150,10 @@ GLint get_max_vertex_attribs()
 GLint get_max_vertex_attrib_bindings()
 {
 #if defined(HOU_GL_ES)
-  // The binding index can't really be specified, so it makes sense to
-  // specify 1 as the maximum.
-  return 1;
+  // The binding index can't really be specified. Each attribute reads from
+  // the buffer bound when its pointer was set, so any number of buffers up
+  // to the number of attributes can be used.
+  return get_max_vertex_attribs();
 #else
   return get_integer(GL_MAX_VERTEX_ATTRIB_BINDINGS);
 #endif
@@ -179,6 +180,15 @@ void set_vertex_attrib_pointer(GLuint index, GLint size, GLenum type,
   HOU_GL_CHECK_ERROR();
 }
 
+
+
+void set_vertex_attrib_divisor(GLuint index, GLuint divisor)
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  glVertexAttribDivisor(index, divisor);
+  HOU_GL_CHECK_ERROR();
+}
+
 #else
 
 void set_vertex_array_vertex_buffer(const vertex_array_handle& vertex_array,
@@ -220,6 +230,17 @@ void set_vertex_array_attrib_binding(const vertex_array_handle& vertex_array,
 
 
 
+void set_vertex_array_binding_divisor(const vertex_array_handle& vertex_array,
+  GLuint binding_index, GLuint divisor)
+{
+  HOU_GL_CHECK_CONTEXT_EXISTENCE();
+  HOU_GL_CHECK_CONTEXT_OWNERSHIP(vertex_array);
+  glVertexArrayBindingDivisor(vertex_array.get_name(), binding_index, divisor);
+  HOU_GL_CHECK_ERROR();
+}
+
+
+
 void enable_vertex_array_attrib(
   const vertex_array_handle& vertex_array, GLuint index)
 {
@@ -48,6 +48,20 @@ TEST_F(test_gl_context, constructor)
 
 
 
+TEST_F(test_gl_context, error_report_mode)
+{
+  window w("Test", vec2u(10u, 10u));
+  gl::context ctx(get_test_default_context_settings(), w);
+  EXPECT_EQ(gl::error_report_mode::per_call, ctx.get_error_report_mode());
+
+  gl::context_settings cs = get_test_default_context_settings();
+  cs.set_debug_mode(true);
+  gl::context debug_ctx(cs, w);
+  EXPECT_NE(gl::error_report_mode::per_call, debug_ctx.get_error_report_mode());
+}
+
+
+
 TEST_F(test_gl_context, shared_constructor)
 {
   window w1("Test", vec2u(1u, 1u));
@@ -4,6 +4,7 @@
 
 #include "hou/gl/test_gl_single_context.hpp"
 
+#include "hou/gl/gl_context.hpp"
 #include "hou/gl/gl_exceptions.hpp"
 
 using namespace hou;
@@ -132,6 +133,14 @@ TEST_F(test_gl_exceptions, call_error)
 
 
 
+TEST_F(test_gl_exceptions, call_error_debug_message)
+{
+  gl::call_error ex("foo.cpp", 42u, std::string("Invalid value."));
+  EXPECT_STREQ("foo.cpp:42 - OpenGL error: Invalid value.", ex.what());
+}
+
+
+
 TEST_F(test_gl_exceptions, gl_check_error_function_success)
 {
   glClear(GL_COLOR_BUFFER_BIT);
@@ -165,3 +174,43 @@ TEST_F(test_gl_exceptions_death_test, gl_check_error_macro_failure)
   EXPECT_NO_ERROR(HOU_GL_CHECK_ERROR());
 #endif
 }
+
+
+
+TEST_F(test_gl_exceptions, gl_check_frame_error_function_per_call_mode)
+{
+  ASSERT_EQ(gl::error_report_mode::per_call,
+    gl::context::get_current()->get_error_report_mode());
+  glClear(GL_COLOR);
+  EXPECT_NO_ERROR(gl::check_frame_error("", 0));
+  EXPECT_ERROR_N(gl::check_error("", 0), gl::call_error, GL_INVALID_VALUE);
+}
+
+
+
+TEST_F(test_gl_exceptions_death_test, gl_check_error_function_debug_callback)
+{
+  window w("Test", vec2u(1u, 1u));
+  gl::context_settings cs = get_test_default_context_settings();
+  cs.set_debug_mode(true);
+  gl::context ctx(cs, w);
+  if(ctx.get_error_report_mode() != gl::error_report_mode::debug_callback)
+  {
+    SKIP("KHR_debug is not supported.");
+  }
+  gl::context::set_current(ctx, w);
+
+  glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_ERROR, 0u,
+    GL_DEBUG_SEVERITY_HIGH, -1, "Test error.");
+  EXPECT_ERROR_N(
+    gl::check_error("", 0), gl::call_error, std::string("Test error."));
+  EXPECT_NO_ERROR(gl::check_error("", 0));
+
+  glDebugMessageInsert(GL_DEBUG_SOURCE_APPLICATION, GL_DEBUG_TYPE_ERROR, 0u,
+    GL_DEBUG_SEVERITY_HIGH, -1, "Test error.");
+  EXPECT_ERROR_N(
+    gl::check_frame_error("", 0), gl::call_error, std::string("Test error."));
+  EXPECT_NO_ERROR(gl::check_frame_error("", 0));
+
+  set_context_current();
+}
@@ -0,0 +1,142 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/test.hpp"
+#include "hou/gl/test_gl_single_context.hpp"
+
+#include "hou/gl/gl_buffer_handle.hpp"
+#include "hou/gl/gl_frame_stats.hpp"
+#include "hou/gl/gl_texture_handle.hpp"
+
+#include <array>
+
+using namespace hou;
+
+
+
+namespace
+{
+
+class test_gl_frame_stats : public test_gl_single_context
+{
+public:
+  test_gl_frame_stats();
+};
+
+
+
+test_gl_frame_stats::test_gl_frame_stats()
+  : test_gl_single_context()
+{
+  gl::end_frame_stats();
+  gl::end_frame_stats();
+}
+
+}  // namespace
+
+
+
+TEST_F(test_gl_frame_stats, default_constructor)
+{
+  gl::frame_stats fs;
+  EXPECT_EQ(0u, fs.get_draw_call_count());
+  EXPECT_EQ(0u, fs.get_issued_bind_count());
+  EXPECT_EQ(0u, fs.get_skipped_bind_count());
+  EXPECT_EQ(0u, fs.get_buffer_upload_count());
+  EXPECT_EQ(0u, fs.get_buffer_upload_byte_count());
+  EXPECT_EQ(0u, fs.get_texture_upload_count());
+  EXPECT_EQ(0u, fs.get_texture_upload_byte_count());
+}
+
+
+
+TEST_F(test_gl_frame_stats, record_and_reset)
+{
+  gl::frame_stats fs;
+  fs.record_draw_call();
+  fs.record_draw_call();
+  fs.record_bind(true);
+  fs.record_bind(false);
+  fs.record_bind(false);
+  fs.record_buffer_upload(16u);
+  fs.record_buffer_upload(8u);
+  fs.record_texture_upload(64u);
+
+  EXPECT_EQ(2u, fs.get_draw_call_count());
+  EXPECT_EQ(1u, fs.get_issued_bind_count());
+  EXPECT_EQ(2u, fs.get_skipped_bind_count());
+  EXPECT_EQ(2u, fs.get_buffer_upload_count());
+  EXPECT_EQ(24u, fs.get_buffer_upload_byte_count());
+  EXPECT_EQ(1u, fs.get_texture_upload_count());
+  EXPECT_EQ(64u, fs.get_texture_upload_byte_count());
+
+  fs.reset();
+  EXPECT_EQ(0u, fs.get_draw_call_count());
+  EXPECT_EQ(0u, fs.get_issued_bind_count());
+  EXPECT_EQ(0u, fs.get_skipped_bind_count());
+  EXPECT_EQ(0u, fs.get_buffer_upload_count());
+  EXPECT_EQ(0u, fs.get_buffer_upload_byte_count());
+  EXPECT_EQ(0u, fs.get_texture_upload_count());
+  EXPECT_EQ(0u, fs.get_texture_upload_byte_count());
+}
+
+
+
+TEST_F(test_gl_frame_stats, end_frame)
+{
+  gl::get_frame_stats().record_draw_call();
+  EXPECT_EQ(1u, gl::get_frame_stats().get_draw_call_count());
+  EXPECT_EQ(0u, gl::get_last_frame_stats().get_draw_call_count());
+
+  gl::end_frame_stats();
+  EXPECT_EQ(0u, gl::get_frame_stats().get_draw_call_count());
+  EXPECT_EQ(1u, gl::get_last_frame_stats().get_draw_call_count());
+
+  gl::end_frame_stats();
+  EXPECT_EQ(0u, gl::get_frame_stats().get_draw_call_count());
+  EXPECT_EQ(0u, gl::get_last_frame_stats().get_draw_call_count());
+}
+
+
+
+TEST_F(test_gl_frame_stats, buffer_instrumentation)
+{
+#if !defined(HOU_ENABLE_GL_FRAME_STATS)
+  SKIP("GL frame stats are disabled in this build.");
+#endif
+  std::array<uint8_t, 16u> data{};
+  gl::buffer_handle bh = gl::buffer_handle::create();
+  gl::set_buffer_storage(bh, 16u, data.data(), GL_DYNAMIC_STORAGE_BIT);
+  gl::set_buffer_sub_data(bh, 4, 8, data.data());
+  gl::bind_buffer(bh, GL_ARRAY_BUFFER);
+  gl::bind_buffer(bh, GL_ARRAY_BUFFER);
+
+  const gl::frame_stats& fs = gl::get_frame_stats();
+  EXPECT_EQ(1u, fs.get_issued_bind_count());
+  EXPECT_EQ(1u, fs.get_skipped_bind_count());
+  EXPECT_EQ(2u, fs.get_buffer_upload_count());
+  EXPECT_EQ(24u, fs.get_buffer_upload_byte_count());
+}
+
+
+
+TEST_F(test_gl_frame_stats, texture_instrumentation)
+{
+#if !defined(HOU_ENABLE_GL_FRAME_STATS)
+  SKIP("GL frame stats are disabled in this build.");
+#endif
+  std::array<uint8_t, 4u * 3u * 2u> data{};
+  gl::texture_handle th = gl::texture_handle::create(GL_TEXTURE_2D);
+  gl::set_texture_storage_2d(th, 1, GL_RGBA8, 3, 2);
+  gl::set_texture_sub_image_2d(
+    th, 0, 0, 0, 3, 2, GL_RGBA, GL_UNSIGNED_BYTE, data.data());
+  gl::bind_texture(th);
+  gl::bind_texture(th);
+
+  const gl::frame_stats& fs = gl::get_frame_stats();
+  EXPECT_EQ(1u, fs.get_issued_bind_count());
+  EXPECT_EQ(1u, fs.get_skipped_bind_count());
+  EXPECT_EQ(1u, fs.get_texture_upload_count());
+  EXPECT_EQ(24u, fs.get_texture_upload_byte_count());
+}
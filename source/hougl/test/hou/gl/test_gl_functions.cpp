@@ -23,3 +23,65 @@ class test_gl_functions : public test_gl_single_context
 using test_gl_functions_death_test = test_gl_functions;
 
 }  // namespace
+
+
+
+TEST_F(test_gl_functions, blending_state_tracking)
+{
+  gl::set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  EXPECT_EQ(static_cast<GLenum>(GL_SRC_ALPHA), gl::get_blend_src_factor());
+  EXPECT_EQ(
+    static_cast<GLenum>(GL_ONE_MINUS_SRC_ALPHA), gl::get_blend_dst_factor());
+  EXPECT_EQ(GL_SRC_ALPHA, gl::get_integer(GL_BLEND_SRC_ALPHA));
+  EXPECT_EQ(GL_ONE_MINUS_SRC_ALPHA, gl::get_integer(GL_BLEND_DST_ALPHA));
+
+  gl::set_blend_equation(GL_FUNC_SUBTRACT);
+  EXPECT_EQ(static_cast<GLenum>(GL_FUNC_SUBTRACT), gl::get_blend_equation());
+  EXPECT_EQ(GL_FUNC_SUBTRACT, gl::get_integer(GL_BLEND_EQUATION_ALPHA));
+
+  gl::set_blend_color(0.25f, 0.5f, 0.75f, 1.f);
+  GLfloat color[4];
+  gl::get_blend_color(color);
+  EXPECT_FLOAT_EQ(0.25f, color[0]);
+  EXPECT_FLOAT_EQ(0.5f, color[1]);
+  EXPECT_FLOAT_EQ(0.75f, color[2]);
+  EXPECT_FLOAT_EQ(1.f, color[3]);
+}
+
+
+
+TEST_F(test_gl_functions, capability_tracking)
+{
+  gl::enable(GL_BLEND);
+  EXPECT_EQ(GL_TRUE, gl::is_enabled(GL_BLEND));
+  EXPECT_EQ(GL_TRUE, glIsEnabled(GL_BLEND));
+  gl::disable(GL_BLEND);
+  EXPECT_EQ(GL_FALSE, gl::is_enabled(GL_BLEND));
+  EXPECT_EQ(GL_FALSE, glIsEnabled(GL_BLEND));
+}
+
+
+
+TEST_F(test_gl_functions, redundant_state_changes_are_skipped)
+{
+  gl::set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  gl::enable(GL_BLEND);
+  gl::set_viewport(0, 0, 2, 3);
+  m_context.reset_state_change_counts();
+
+  gl::set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  gl::enable(GL_BLEND);
+  gl::set_viewport(0, 0, 2, 3);
+  EXPECT_EQ(0u, m_context.get_issued_state_change_count());
+  EXPECT_EQ(3u, m_context.get_skipped_state_change_count());
+
+  gl::set_blend_func(GL_ONE, GL_ZERO);
+  gl::disable(GL_BLEND);
+  gl::set_viewport(0, 0, 3, 2);
+  EXPECT_EQ(3u, m_context.get_issued_state_change_count());
+  EXPECT_EQ(3u, m_context.get_skipped_state_change_count());
+
+  m_context.reset_state_change_counts();
+  EXPECT_EQ(0u, m_context.get_issued_state_change_count());
+  EXPECT_EQ(0u, m_context.get_skipped_state_change_count());
+}
@@ -231,3 +231,72 @@ TEST_F(test_gl_program_handle_death_test, get_uniform_location_invalid_name)
   EXPECT_ERROR_N(gl::get_program_uniform_location(ph, "invalidName"),
     gl::invalid_uniform_error, "invalidName");
 }
+
+
+
+TEST_F(test_gl_program_handle, redundant_uniform_uploads_are_skipped)
+{
+  gl::program_handle ph = create_program();
+  GLint location = gl::get_program_uniform_location(ph, "colorUni");
+  m_context.reset_state_change_counts();
+
+  gl::set_program_uniform_f(ph, location, 1.f, 0.f, 0.f, 1.f);
+  gl::set_program_uniform_f(ph, location, 1.f, 0.f, 0.f, 1.f);
+  EXPECT_EQ(1u, m_context.get_issued_state_change_count());
+  EXPECT_EQ(1u, m_context.get_skipped_state_change_count());
+
+  gl::set_program_uniform_f(ph, location, 0.f, 1.f, 0.f, 1.f);
+  EXPECT_EQ(2u, m_context.get_issued_state_change_count());
+  EXPECT_EQ(1u, m_context.get_skipped_state_change_count());
+
+  GLfloat value[4];
+  glGetUniformfv(ph.get_name(), location, value);
+  EXPECT_FLOAT_EQ(0.f, value[0]);
+  EXPECT_FLOAT_EQ(1.f, value[1]);
+}
+
+
+
+TEST_F(test_gl_program_handle, link_program_clears_uniform_cache)
+{
+  gl::program_handle ph = create_program();
+  GLint location = gl::get_program_uniform_location(ph, "colorUni");
+  gl::set_program_uniform_f(ph, location, 1.f, 0.f, 0.f, 1.f);
+  link_program(ph);
+  m_context.reset_state_change_counts();
+
+  gl::set_program_uniform_f(ph, location, 1.f, 0.f, 0.f, 1.f);
+  EXPECT_EQ(1u, m_context.get_issued_state_change_count());
+  EXPECT_EQ(0u, m_context.get_skipped_state_change_count());
+}
+
+
+
+TEST_F(test_gl_program_handle, uniform_cache_query_records_no_state_change)
+{
+  gl::program_handle ph = create_program();
+  GLint location = gl::get_program_uniform_location(ph, "colorUni");
+  gl::set_program_uniform_f(ph, location, 1.f, 0.f, 0.f, 1.f);
+  m_context.reset_state_change_counts();
+
+  GLfloat values[] = {1.f, 0.f, 0.f, 1.f};
+  EXPECT_TRUE(ph.is_uniform_cached(
+    location, GL_FLOAT_VEC4, GL_FALSE, values, sizeof(values)));
+  EXPECT_EQ(0u, m_context.get_issued_state_change_count());
+  EXPECT_EQ(0u, m_context.get_skipped_state_change_count());
+}
+
+
+
+TEST_F(test_gl_program_handle, uncache_uniforms)
+{
+  gl::program_handle ph = create_program();
+  GLint location = gl::get_program_uniform_location(ph, "colorUni");
+  gl::set_program_uniform_f(ph, location, 1.f, 0.f, 0.f, 1.f);
+  ph.uncache_uniforms(location, 1);
+  m_context.reset_state_change_counts();
+
+  gl::set_program_uniform_f(ph, location, 1.f, 0.f, 0.f, 1.f);
+  EXPECT_EQ(1u, m_context.get_issued_state_change_count());
+  EXPECT_EQ(0u, m_context.get_skipped_state_change_count());
+}
@@ -10,6 +10,8 @@
 
 #include "hou/sys/sys_config.hpp"
 
+#include "hou/cor/assertions.hpp"
+
 
 
 namespace hou
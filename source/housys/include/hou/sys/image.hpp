@@ -7,6 +7,7 @@
 
 #include "hou/sys/image_fwd.hpp"
 #include "hou/sys/pixel.hpp"
+#include "hou/sys/pixel_conversion.hpp"
 
 #include "hou/sys/sys_config.hpp"
 
@@ -38,6 +39,11 @@ public:
   template <size_t OtherDim, pixel_format OtherPF>
   friend class image;
 
+  template <size_t OtherDim, pixel_format OtherPF>
+  friend void blit(image<OtherDim, OtherPF>& dst,
+    const vec<int, OtherDim>& dst_offset, const image<OtherDim, OtherPF>& src,
+    const vec<uint, OtherDim>& src_offset, const vec<uint, OtherDim>& src_size);
+
 public:
   /**
    * Type representing the size of the image.
@@ -203,10 +209,10 @@ public:
     // This has to be defined here, or MSVC can't figure out that this
     // constructor exists and will try to call the one taking a size vector
     // as argument.
-    for(size_t i = 0; i < m_pixels.size(); ++i)
-    {
-      m_pixels[i] = other.m_pixels[i];
-    }
+    convert_pixels(
+      span<const typename image<OtherDim, OtherPF>::pixel_type>(
+        other.m_pixels),
+      span<pixel_type>(m_pixels));
   }
 
   /**
@@ -358,6 +364,38 @@ bool operator!=(const image<Dim, PF>& lhs, const image<Dim, PF>& rhs) noexcept;
 template <size_t Dim, pixel_format PF>
 std::ostream& operator<<(std::ostream& os, const image<Dim, PF>& im);
 
+/**
+ * Copies a region of an image into another image.
+ *
+ * The region is clipped against the bounds of both images: the pixels of the
+ * region lying outside of src, or that would be copied outside of dst, are
+ * ignored.
+ * The pixels are copied by whole rows, which is much faster than copying them
+ * one by one.
+ *
+ * \tparam Dim the number of dimensions of the image.
+ *
+ * \tparam PF the pixel format.
+ *
+ * \param dst the destination image.
+ *
+ * \param dst_offset the position in dst where the region is copied. It can be
+ * negative, in which case the region is clipped.
+ *
+ * \param src the source image.
+ *
+ * \param src_offset the offset of the region in src.
+ *
+ * \param src_size the size of the region.
+ *
+ * \throws hou::precondition_violation if dst and src are the same image and
+ * the source and destination regions overlap.
+ */
+template <size_t Dim, pixel_format PF>
+void blit(image<Dim, PF>& dst, const vec<int, Dim>& dst_offset,
+  const image<Dim, PF>& src, const vec<uint, Dim>& src_offset,
+  const vec<uint, Dim>& src_size);
+
 }  // namespace hou
 
 #include "hou/sys/image.inl"
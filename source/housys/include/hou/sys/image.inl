@@ -61,6 +61,33 @@ extern template class HOU_SYS_API image<3u, pixel_format::r>;
 extern template class HOU_SYS_API image<3u, pixel_format::rg>;
 extern template class HOU_SYS_API image<3u, pixel_format::rgb>;
 extern template class HOU_SYS_API image<3u, pixel_format::rgba>;
+
+extern template HOU_SYS_API void blit<1u, pixel_format::r>(image1_r&,
+  const vec1i&, const image1_r&, const vec1u&, const vec1u&);
+extern template HOU_SYS_API void blit<1u, pixel_format::rg>(image1_rg&,
+  const vec1i&, const image1_rg&, const vec1u&, const vec1u&);
+extern template HOU_SYS_API void blit<1u, pixel_format::rgb>(image1_rgb&,
+  const vec1i&, const image1_rgb&, const vec1u&, const vec1u&);
+extern template HOU_SYS_API void blit<1u, pixel_format::rgba>(image1_rgba&,
+  const vec1i&, const image1_rgba&, const vec1u&, const vec1u&);
+
+extern template HOU_SYS_API void blit<2u, pixel_format::r>(image2_r&,
+  const vec2i&, const image2_r&, const vec2u&, const vec2u&);
+extern template HOU_SYS_API void blit<2u, pixel_format::rg>(image2_rg&,
+  const vec2i&, const image2_rg&, const vec2u&, const vec2u&);
+extern template HOU_SYS_API void blit<2u, pixel_format::rgb>(image2_rgb&,
+  const vec2i&, const image2_rgb&, const vec2u&, const vec2u&);
+extern template HOU_SYS_API void blit<2u, pixel_format::rgba>(image2_rgba&,
+  const vec2i&, const image2_rgba&, const vec2u&, const vec2u&);
+
+extern template HOU_SYS_API void blit<3u, pixel_format::r>(image3_r&,
+  const vec3i&, const image3_r&, const vec3u&, const vec3u&);
+extern template HOU_SYS_API void blit<3u, pixel_format::rg>(image3_rg&,
+  const vec3i&, const image3_rg&, const vec3u&, const vec3u&);
+extern template HOU_SYS_API void blit<3u, pixel_format::rgb>(image3_rgb&,
+  const vec3i&, const image3_rgb&, const vec3u&, const vec3u&);
+extern template HOU_SYS_API void blit<3u, pixel_format::rgba>(image3_rgba&,
+  const vec3i&, const image3_rgba&, const vec3u&, const vec3u&);
 #endif
 
 }  // namespace hou
@@ -7,12 +7,17 @@
 
 #include "hou/cor/non_instantiable.hpp"
 
+#include "hou/sys/binary_stream_in.hpp"
+#include "hou/sys/image_file_format.hpp"
 #include "hou/sys/image_fwd.hpp"
 
 #include "hou/sys/sys_config.hpp"
 
+#include "hou/cor/span.hpp"
 #include "hou/cor/std_string.hpp"
 
+#include "hou/mth/matrix.hpp"
+
 
 
 namespace hou
@@ -27,6 +32,8 @@ public:
   /**
    * Checks if a file is a BMP file.
    *
+   * Only the signature at the beginning of the file is read.
+   *
    * \param path the path to the file.
    *
    * \throws hou::file_open_error if the file could not be opened.
@@ -51,6 +58,41 @@ public:
   template <pixel_format PF>
   HOU_SYS_API static image2<PF> read(const std::string& path);
 
+  /**
+   * Creates an image object from a binary stream containing BMP data.
+   *
+   * The whole content of the stream is read, then decoded. The encoded data
+   * is released before the image is created.
+   *
+   * \tparam PF the output image format.
+   *
+   * \param bs the binary stream.
+   *
+   * \throws hou::read_error if the stream could not be read.
+   *
+   * \throws hou::invalid_image_data if the image data was not valid.
+   *
+   * \return an image built from the information contained in the stream.
+   */
+  template <pixel_format PF>
+  static image2<PF> read(binary_stream_in& bs);
+
+  /**
+   * Creates an image object from BMP data in memory.
+   *
+   * The data is decoded without being copied.
+   *
+   * \tparam PF the output image format.
+   *
+   * \param data the encoded image data.
+   *
+   * \throws hou::invalid_image_data if the image data was not valid.
+   *
+   * \return an image built from the information contained in the data.
+   */
+  template <pixel_format PF>
+  static image2<PF> read_from_memory(const span<const uint8_t>& data);
+
   /**
    * Writes an image to disk as a BMP file.
    *
@@ -86,14 +128,42 @@ extern template HOU_SYS_API void bmp_image_file::write<pixel_format::rgba>(
 extern template HOU_SYS_API image2<pixel_format::r>
   bmp_image_file::read<pixel_format::r>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::r>
+  bmp_image_file::read<pixel_format::r>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::r>
+  bmp_image_file::read_from_memory<pixel_format::r>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rg>
   bmp_image_file::read<pixel_format::rg>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::rg>
+  bmp_image_file::read<pixel_format::rg>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rg>
+  bmp_image_file::read_from_memory<pixel_format::rg>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rgb>
   bmp_image_file::read<pixel_format::rgb>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::rgb>
+  bmp_image_file::read<pixel_format::rgb>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rgb>
+  bmp_image_file::read_from_memory<pixel_format::rgb>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rgba>
   bmp_image_file::read<pixel_format::rgba>(const std::string& path);
+
+extern template HOU_SYS_API image2<pixel_format::rgba>
+  bmp_image_file::read<pixel_format::rgba>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rgba>
+  bmp_image_file::read_from_memory<pixel_format::rgba>(
+    const span<const uint8_t>& data);
 #endif
 
 /**
@@ -105,6 +175,8 @@ public:
   /**
    * Checks if a file is a PNG file.
    *
+   * Only the signature at the beginning of the file is read.
+   *
    * Throws if the file corresponding to the given path cannot be opened.
    *
    * \param path the path to the file.
@@ -133,20 +205,83 @@ public:
    */
   template <pixel_format PF>
   static image2<PF> read(const std::string& path);
+
+  /**
+   * Creates an image object from a binary stream containing PNG data.
+   *
+   * The whole content of the stream is read, then decoded. The encoded data
+   * is released before the image is created.
+   *
+   * \tparam PF the output image format.
+   *
+   * \param bs the binary stream.
+   *
+   * \throws hou::read_error if the stream could not be read.
+   *
+   * \throws hou::invalid_image_data if the image data was not valid.
+   *
+   * \return an image built from the information contained in the stream.
+   */
+  template <pixel_format PF>
+  static image2<PF> read(binary_stream_in& bs);
+
+  /**
+   * Creates an image object from PNG data in memory.
+   *
+   * The data is decoded without being copied.
+   *
+   * \tparam PF the output image format.
+   *
+   * \param data the encoded image data.
+   *
+   * \throws hou::invalid_image_data if the image data was not valid.
+   *
+   * \return an image built from the information contained in the data.
+   */
+  template <pixel_format PF>
+  static image2<PF> read_from_memory(const span<const uint8_t>& data);
 };
 
 #ifndef HOU_DOXYGEN
 extern template HOU_SYS_API image2<pixel_format::r>
   png_image_file::read<pixel_format::r>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::r>
+  png_image_file::read<pixel_format::r>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::r>
+  png_image_file::read_from_memory<pixel_format::r>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rg>
   png_image_file::read<pixel_format::rg>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::rg>
+  png_image_file::read<pixel_format::rg>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rg>
+  png_image_file::read_from_memory<pixel_format::rg>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rgb>
   png_image_file::read<pixel_format::rgb>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::rgb>
+  png_image_file::read<pixel_format::rgb>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rgb>
+  png_image_file::read_from_memory<pixel_format::rgb>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rgba>
   png_image_file::read<pixel_format::rgba>(const std::string& path);
+
+extern template HOU_SYS_API image2<pixel_format::rgba>
+  png_image_file::read<pixel_format::rgba>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rgba>
+  png_image_file::read_from_memory<pixel_format::rgba>(
+    const span<const uint8_t>& data);
 #endif
 
 /**
@@ -158,6 +293,8 @@ public:
   /**
    * Checks if a file is a JPG file.
    *
+   * Only the signature at the beginning of the file is read.
+   *
    * Throws if the file corresponding to the given path cannot be opened.
    *
    * \param path the path to the file.
@@ -186,22 +323,121 @@ public:
    */
   template <pixel_format PF>
   static image2<PF> read(const std::string& path);
+
+  /**
+   * Creates an image object from a binary stream containing JPG data.
+   *
+   * The whole content of the stream is read, then decoded. The encoded data
+   * is released before the image is created.
+   *
+   * \tparam PF the output image format.
+   *
+   * \param bs the binary stream.
+   *
+   * \throws hou::read_error if the stream could not be read.
+   *
+   * \throws hou::invalid_image_data if the image data was not valid.
+   *
+   * \return an image built from the information contained in the stream.
+   */
+  template <pixel_format PF>
+  static image2<PF> read(binary_stream_in& bs);
+
+  /**
+   * Creates an image object from JPG data in memory.
+   *
+   * The data is decoded without being copied.
+   *
+   * \tparam PF the output image format.
+   *
+   * \param data the encoded image data.
+   *
+   * \throws hou::invalid_image_data if the image data was not valid.
+   *
+   * \return an image built from the information contained in the data.
+   */
+  template <pixel_format PF>
+  static image2<PF> read_from_memory(const span<const uint8_t>& data);
 };
 
 #ifndef HOU_DOXYGEN
 extern template HOU_SYS_API image2<pixel_format::r>
   jpg_image_file::read<pixel_format::r>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::r>
+  jpg_image_file::read<pixel_format::r>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::r>
+  jpg_image_file::read_from_memory<pixel_format::r>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rg>
   jpg_image_file::read<pixel_format::rg>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::rg>
+  jpg_image_file::read<pixel_format::rg>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rg>
+  jpg_image_file::read_from_memory<pixel_format::rg>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rgb>
   jpg_image_file::read<pixel_format::rgb>(const std::string& path);
 
+extern template HOU_SYS_API image2<pixel_format::rgb>
+  jpg_image_file::read<pixel_format::rgb>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rgb>
+  jpg_image_file::read_from_memory<pixel_format::rgb>(
+    const span<const uint8_t>& data);
+
 extern template HOU_SYS_API image2<pixel_format::rgba>
   jpg_image_file::read<pixel_format::rgba>(const std::string& path);
+
+extern template HOU_SYS_API image2<pixel_format::rgba>
+  jpg_image_file::read<pixel_format::rgba>(binary_stream_in& bs);
+
+extern template HOU_SYS_API image2<pixel_format::rgba>
+  jpg_image_file::read_from_memory<pixel_format::rgba>(
+    const span<const uint8_t>& data);
 #endif
 
+/**
+ * Information about an image file, read from the file header.
+ */
+struct image_file_info
+{
+  /** The file format. */
+  image_file_format format;
+
+  /** The size of the image in pixels. */
+  vec2u size;
+
+  /**
+   * The number of channels stored in the file.
+   *
+   * As in the decoder, PNG palette images are reported as having 4 channels
+   * if they have a transparency chunk, 3 channels otherwise.
+   */
+  uint channel_count;
+};
+
+/**
+ * Retrieves the format, size and number of channels of an image file.
+ *
+ * Only the file header is read, the image data is not decoded.
+ *
+ * \param path the path to the file.
+ *
+ * \throws hou::file_open_error if the file could not be opened.
+ *
+ * \throws hou::invalid_image_data if the file is not a BMP, PNG or JPG file,
+ * or if its header is not valid.
+ *
+ * \return the information about the image file.
+ */
+HOU_SYS_API image_file_info get_image_info(const std::string& path);
+
 }  // namespace hou
 
 #endif
@@ -0,0 +1,43 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_SYS_IMAGE_FILE_FORMAT_HPP
+#define HOU_SYS_IMAGE_FILE_FORMAT_HPP
+
+#include "hou/sys/sys_config.hpp"
+
+#include <iostream>
+
+
+
+namespace hou
+{
+
+/**
+ * Image file format.
+ */
+enum class image_file_format
+{
+  /** BMP file. */
+  bmp,
+  /** PNG file. */
+  png,
+  /** JPG file. */
+  jpg,
+};
+
+/**
+ * Writes the object into a stream.
+ *
+ * \param os the stream.
+ *
+ * \param iff the image_file_format enum.
+ *
+ * \return a reference to os.
+ */
+HOU_SYS_API std::ostream& operator<<(std::ostream& os, image_file_format iff);
+
+}  // namespace hou
+
+#endif
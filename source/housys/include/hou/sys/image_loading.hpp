@@ -0,0 +1,155 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_SYS_IMAGE_LOADING_HPP
+#define HOU_SYS_IMAGE_LOADING_HPP
+
+#include "hou/sys/image.hpp"
+
+#include "hou/sys/sys_config.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+
+namespace hou
+{
+
+/**
+ * Function called when an image of a batch has been loaded.
+ *
+ * The first argument is the index of the image path in the batch, the second
+ * argument is the image, which can be moved from.
+ *
+ * \tparam PF the image format.
+ */
+template <pixel_format PF>
+using image_loaded_callback = std::function<void(size_t, image2<PF>&)>;
+
+/**
+ * Creates an image object from a BMP, PNG or JPG file.
+ *
+ * The file format is deduced from the file header.
+ *
+ * \tparam PF the output image format.
+ *
+ * \param path the path to the file.
+ *
+ * \throws hou::file_open_error if the file could not be opened.
+ *
+ * \throws hou::invalid_image_data if the image data was not valid.
+ *
+ * \return an image built from the information contained in the file.
+ */
+template <pixel_format PF>
+image2<PF> read_image(const std::string& path);
+
+/**
+ * Loads many image files, decoding them with multiple threads.
+ *
+ * Each file is read and decoded by a worker thread as by read_image.
+ * The callback is invoked in the calling thread as soon as each image is
+ * available, while the worker threads keep decoding the remaining images.
+ * It is therefore safe to use the image with objects bound to the calling
+ * thread, for example to upload it into a texture of the current graphic
+ * context.
+ * The callback is invoked in the order in which images finish decoding, not
+ * necessarily in the order of the paths.
+ *
+ * If an image can't be loaded or the callback throws, no more images are
+ * decoded, the worker threads are joined and the exception is propagated.
+ *
+ * \tparam PF the output image format.
+ *
+ * \param paths the paths to the image files.
+ *
+ * \param thread_count the number of worker threads.
+ *
+ * \param on_image_loaded the function called for each loaded image.
+ *
+ * \throws hou::precondition_violation if thread_count is 0 or on_image_loaded
+ * is empty.
+ *
+ * \throws hou::file_open_error if a file could not be opened.
+ *
+ * \throws hou::invalid_image_data if the data of an image was not valid.
+ */
+template <pixel_format PF>
+void load_images(const std::vector<std::string>& paths, size_t thread_count,
+  const image_loaded_callback<PF>& on_image_loaded);
+
+/**
+ * Loads many image files, decoding them with multiple threads.
+ *
+ * Each file is read and decoded by a worker thread as by read_image.
+ *
+ * \tparam PF the output image format.
+ *
+ * \param paths the paths to the image files.
+ *
+ * \param thread_count the number of worker threads.
+ *
+ * \throws hou::precondition_violation if thread_count is 0.
+ *
+ * \throws hou::file_open_error if a file could not be opened.
+ *
+ * \throws hou::invalid_image_data if the data of an image was not valid.
+ *
+ * \return the images, in the same order as the paths.
+ */
+template <pixel_format PF>
+std::vector<image2<PF>> load_images(
+  const std::vector<std::string>& paths, size_t thread_count);
+
+#ifndef HOU_DOXYGEN
+extern template HOU_SYS_API image2<pixel_format::r> read_image<
+  pixel_format::r>(const std::string& path);
+
+extern template HOU_SYS_API image2<pixel_format::rg> read_image<
+  pixel_format::rg>(const std::string& path);
+
+extern template HOU_SYS_API image2<pixel_format::rgb> read_image<
+  pixel_format::rgb>(const std::string& path);
+
+extern template HOU_SYS_API image2<pixel_format::rgba> read_image<
+  pixel_format::rgba>(const std::string& path);
+
+extern template HOU_SYS_API void load_images<pixel_format::r>(
+  const std::vector<std::string>& paths, size_t thread_count,
+  const image_loaded_callback<pixel_format::r>& on_image_loaded);
+
+extern template HOU_SYS_API void load_images<pixel_format::rg>(
+  const std::vector<std::string>& paths, size_t thread_count,
+  const image_loaded_callback<pixel_format::rg>& on_image_loaded);
+
+extern template HOU_SYS_API void load_images<pixel_format::rgb>(
+  const std::vector<std::string>& paths, size_t thread_count,
+  const image_loaded_callback<pixel_format::rgb>& on_image_loaded);
+
+extern template HOU_SYS_API void load_images<pixel_format::rgba>(
+  const std::vector<std::string>& paths, size_t thread_count,
+  const image_loaded_callback<pixel_format::rgba>& on_image_loaded);
+
+extern template HOU_SYS_API std::vector<image2<pixel_format::r>>
+  load_images<pixel_format::r>(
+    const std::vector<std::string>& paths, size_t thread_count);
+
+extern template HOU_SYS_API std::vector<image2<pixel_format::rg>>
+  load_images<pixel_format::rg>(
+    const std::vector<std::string>& paths, size_t thread_count);
+
+extern template HOU_SYS_API std::vector<image2<pixel_format::rgb>>
+  load_images<pixel_format::rgb>(
+    const std::vector<std::string>& paths, size_t thread_count);
+
+extern template HOU_SYS_API std::vector<image2<pixel_format::rgba>>
+  load_images<pixel_format::rgba>(
+    const std::vector<std::string>& paths, size_t thread_count);
+#endif
+
+}  // namespace hou
+
+#endif
@@ -0,0 +1,118 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_SYS_PIXEL_CONVERSION_HPP
+#define HOU_SYS_PIXEL_CONVERSION_HPP
+
+#include "hou/sys/pixel.hpp"
+#include "hou/sys/pixel_conversion_backend.hpp"
+
+#include "hou/sys/sys_config.hpp"
+
+#include "hou/cor/span.hpp"
+
+
+
+namespace hou
+{
+
+/**
+ * Converts a sequence of pixels to a different format.
+ *
+ * Each pixel is converted according to the conversion rules of the pixel
+ * class, and the result is exactly the same as converting the pixels one by
+ * one.
+ * The most common conversions (rgba to r, rgba to rgb, and rgb to rgba) are
+ * performed with SIMD instructions, according to the current
+ * pixel_conversion_backend.
+ * The input and output sequences must not overlap.
+ *
+ * \tparam InPF the input pixel format.
+ *
+ * \tparam OutPF the output pixel format.
+ *
+ * \param in the input pixels.
+ *
+ * \param out the output pixels.
+ *
+ * \throws hou::precondition_violation if in and out have a different number of
+ * pixels.
+ */
+template <pixel_format InPF, pixel_format OutPF>
+void convert_pixels(
+  const span<const pixel<InPF>>& in, const span<pixel<OutPF>>& out);
+
+/**
+ * Checks if a pixel_conversion_backend is supported by the CPU and by the
+ * library build.
+ *
+ * The scalar backend is always supported.
+ *
+ * \param pcb the pixel_conversion_backend.
+ *
+ * \return true if the pixel_conversion_backend is supported.
+ */
+HOU_SYS_API bool is_pixel_conversion_backend_supported(
+  pixel_conversion_backend pcb);
+
+/**
+ * Gets the pixel_conversion_backend used by convert_pixels.
+ *
+ * By default, the fastest supported backend is selected when the program
+ * starts.
+ *
+ * \return the current pixel_conversion_backend.
+ */
+HOU_SYS_API pixel_conversion_backend get_pixel_conversion_backend() noexcept;
+
+/**
+ * Sets the pixel_conversion_backend used by convert_pixels.
+ *
+ * \param pcb the pixel_conversion_backend.
+ *
+ * \throws hou::precondition_violation if pcb is not supported.
+ */
+HOU_SYS_API void set_pixel_conversion_backend(pixel_conversion_backend pcb);
+
+#ifndef HOU_DOXYGEN
+extern template HOU_SYS_API void convert_pixels<pixel_format::r,
+  pixel_format::r>(const span<const pixel_r>&, const span<pixel_r>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::r,
+  pixel_format::rg>(const span<const pixel_r>&, const span<pixel_rg>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::r,
+  pixel_format::rgb>(const span<const pixel_r>&, const span<pixel_rgb>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::r,
+  pixel_format::rgba>(const span<const pixel_r>&, const span<pixel_rgba>&);
+
+extern template HOU_SYS_API void convert_pixels<pixel_format::rg,
+  pixel_format::r>(const span<const pixel_rg>&, const span<pixel_r>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rg,
+  pixel_format::rg>(const span<const pixel_rg>&, const span<pixel_rg>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rg,
+  pixel_format::rgb>(const span<const pixel_rg>&, const span<pixel_rgb>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rg,
+  pixel_format::rgba>(const span<const pixel_rg>&, const span<pixel_rgba>&);
+
+extern template HOU_SYS_API void convert_pixels<pixel_format::rgb,
+  pixel_format::r>(const span<const pixel_rgb>&, const span<pixel_r>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rgb,
+  pixel_format::rg>(const span<const pixel_rgb>&, const span<pixel_rg>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rgb,
+  pixel_format::rgb>(const span<const pixel_rgb>&, const span<pixel_rgb>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rgb,
+  pixel_format::rgba>(const span<const pixel_rgb>&, const span<pixel_rgba>&);
+
+extern template HOU_SYS_API void convert_pixels<pixel_format::rgba,
+  pixel_format::r>(const span<const pixel_rgba>&, const span<pixel_r>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rgba,
+  pixel_format::rg>(const span<const pixel_rgba>&, const span<pixel_rg>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rgba,
+  pixel_format::rgb>(const span<const pixel_rgba>&, const span<pixel_rgb>&);
+extern template HOU_SYS_API void convert_pixels<pixel_format::rgba,
+  pixel_format::rgba>(const span<const pixel_rgba>&, const span<pixel_rgba>&);
+#endif
+
+}  // namespace hou
+
+#endif
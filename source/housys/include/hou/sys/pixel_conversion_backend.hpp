@@ -0,0 +1,46 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#ifndef HOU_SYS_PIXEL_CONVERSION_BACKEND_HPP
+#define HOU_SYS_PIXEL_CONVERSION_BACKEND_HPP
+
+#include "hou/sys/sys_config.hpp"
+
+#include <iostream>
+
+
+
+namespace hou
+{
+
+/**
+ * Instruction set used to convert sequences of pixels.
+ */
+enum class pixel_conversion_backend
+{
+  /** Portable C++ code. */
+  scalar,
+  /** x86 SSE2 instructions. */
+  sse2,
+  /** x86 AVX2 instructions. */
+  avx2,
+  /** ARM NEON instructions. */
+  neon,
+};
+
+/**
+ * Writes the object into a stream.
+ *
+ * \param os the stream.
+ *
+ * \param pcb the pixel_conversion_backend enum.
+ *
+ * \return a reference to os.
+ */
+HOU_SYS_API std::ostream& operator<<(
+  std::ostream& os, pixel_conversion_backend pcb);
+
+}  // namespace hou
+
+#endif
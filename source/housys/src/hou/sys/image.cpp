@@ -5,6 +5,13 @@
 #include "hou/sys/image.hpp"
 
 #include "hou/cor/assertions.hpp"
+#include "hou/cor/narrow_cast.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
 
 
 
@@ -21,29 +28,23 @@ template <size_t Dim>
 bool element_wise_lower_or_equal(
   const vec<uint, Dim>& lhs, const vec<uint, Dim>& rhs);
 
-template <pixel_format PF>
-image1<PF> get_image_sub_image(
-  const image1<PF>& in, const vec1u& offset, const vec1u& size);
-
-template <pixel_format PF>
-image2<PF> get_image_sub_image(
-  const image2<PF>& in, const vec2u& offset, const vec2u& size);
-
-template <pixel_format PF>
-image3<PF> get_image_sub_image(
-  const image3<PF>& in, const vec3u& offset, const vec3u& size);
+template <size_t Dim>
+bool regions_overlap(const vec<uint, Dim>& lhs_offset,
+  const vec<uint, Dim>& rhs_offset, const vec<uint, Dim>& size);
 
-template <pixel_format PF>
-void set_image_sub_image(
-  image1<PF>& out, const vec1u& offset, const image1<PF>& in);
+template <size_t Dim>
+size_t compute_linear_index(
+  const vec<uint, Dim>& coordinates, const vec<uint, Dim>& size);
 
-template <pixel_format PF>
-void set_image_sub_image(
-  image2<PF>& out, const vec2u& offset, const image2<PF>& in);
+template <size_t Dim>
+bool advance_position(
+  vec<uint, Dim>& pos, const vec<uint, Dim>& size, size_t first_dim);
 
-template <pixel_format PF>
-void set_image_sub_image(
-  image3<PF>& out, const vec3u& offset, const image1<PF>& in);
+template <typename T, size_t Dim>
+void copy_region(T* dst, const vec<uint, Dim>& dst_size,
+  const vec<uint, Dim>& dst_offset, const T* src,
+  const vec<uint, Dim>& src_size, const vec<uint, Dim>& src_offset,
+  const vec<uint, Dim>& region_size);
 
 
 
@@ -72,119 +73,94 @@ bool element_wise_lower_or_equal(
 
 
 
-template <pixel_format PF>
-image1<PF> get_image_sub_image(
-  const image1<PF>& in, const vec1u& offset, const vec1u& size)
+template <size_t Dim>
+bool regions_overlap(const vec<uint, Dim>& lhs_offset,
+  const vec<uint, Dim>& rhs_offset, const vec<uint, Dim>& size)
 {
-  HOU_CHECK_0(
-    element_wise_lower_or_equal(offset + size, in.get_size()), out_of_range);
-  image1<PF> out(size);
-  for(uint x = 0; x < size.x(); ++x)
+  for(size_t i = 0; i < Dim; ++i)
   {
-    vec1u pos = vec1u(x);
-    out.set_pixel(pos, in.get_pixel(offset + pos));
+    if(lhs_offset(i) >= rhs_offset(i) + size(i)
+      || rhs_offset(i) >= lhs_offset(i) + size(i))
+    {
+      return false;
+    }
   }
-  return out;
+  return true;
 }
 
 
 
-template <pixel_format PF>
-image2<PF> get_image_sub_image(
-  const image2<PF>& in, const vec2u& offset, const vec2u& size)
+template <size_t Dim>
+size_t compute_linear_index(
+  const vec<uint, Dim>& coordinates, const vec<uint, Dim>& size)
 {
-  HOU_CHECK_0(
-    element_wise_lower_or_equal(offset + size, in.get_size()), out_of_range);
-  image2<PF> out(size);
-  for(uint x = 0; x < size.x(); ++x)
+  size_t idx = 0;
+  size_t multiplier = 1;
+  for(size_t i = 0; i < Dim; ++i)
   {
-    for(uint y = 0; y < size.y(); ++y)
-    {
-      vec2u pos = vec2u(x, y);
-      out.set_pixel(pos, in.get_pixel(offset + pos));
-    }
+    idx += coordinates(i) * multiplier;
+    multiplier *= size(i);
   }
-  return out;
+  return idx;
 }
 
 
 
-template <pixel_format PF>
-image3<PF> get_image_sub_image(
-  const image3<PF>& in, const vec3u& offset, const vec3u& size)
+template <size_t Dim>
+bool advance_position(
+  vec<uint, Dim>& pos, const vec<uint, Dim>& size, size_t first_dim)
 {
-  HOU_CHECK_0(
-    element_wise_lower_or_equal(offset + size, in.get_size()), out_of_range);
-  image3<PF> out(size);
-  for(uint x = 0; x < size.x(); ++x)
+  for(size_t i = first_dim; i < Dim; ++i)
   {
-    for(uint y = 0; y < size.y(); ++y)
+    ++pos(i);
+    if(pos(i) < size(i))
     {
-      for(uint z = 0; z < size.z(); ++z)
-      {
-        vec3u pos = vec3u(x, y, z);
-        out.set_pixel(pos, in.get_pixel(offset + pos));
-      }
+      return true;
     }
+    pos(i) = 0u;
   }
-  return out;
+  return false;
 }
 
 
 
-template <pixel_format PF>
-void set_image_sub_image(
-  image1<PF>& out, const vec1u& offset, const image1<PF>& in)
+template <typename T, size_t Dim>
+void copy_region(T* dst, const vec<uint, Dim>& dst_size,
+  const vec<uint, Dim>& dst_offset, const T* src,
+  const vec<uint, Dim>& src_size, const vec<uint, Dim>& src_offset,
+  const vec<uint, Dim>& region_size)
 {
-  HOU_CHECK_0(
-    element_wise_lower_or_equal(offset + in.get_size(), out.get_size()),
-    out_of_range);
-  for(uint x = 0; x < in.get_size().x(); ++x)
-  {
-    vec1u pos = vec1u(x);
-    out.set_pixel(offset + pos, in.get_pixel(pos));
-  }
-}
+  static_assert(std::is_trivially_copyable<T>::value,
+    "Pixels must be trivially copyable.");
 
-
-
-template <pixel_format PF>
-void set_image_sub_image(
-  image2<PF>& out, const vec2u& offset, const image2<PF>& in)
-{
-  HOU_CHECK_0(
-    element_wise_lower_or_equal(offset + in.get_size(), out.get_size()),
-    out_of_range);
-  for(uint x = 0; x < in.get_size().x(); ++x)
+  for(size_t i = 0; i < Dim; ++i)
   {
-    for(uint y = 0; y < in.get_size().y(); ++y)
+    if(region_size(i) == 0u)
     {
-      vec2u pos = vec2u(x, y);
-      out.set_pixel(offset + pos, in.get_pixel(pos));
+      return;
     }
   }
-}
-
-
 
-template <pixel_format PF>
-void set_image_sub_image(
-  image3<PF>& out, const vec3u& offset, const image3<PF>& in)
-{
-  HOU_CHECK_0(
-    element_wise_lower_or_equal(offset + in.get_size(), out.get_size()),
-    out_of_range);
-  for(uint x = 0; x < in.get_size().x(); ++x)
+  // Pixels along the first axis are adjacent in memory, so each row of the
+  // region is copied with a single memcpy. If the region spans whole rows of
+  // both images, consecutive rows are adjacent as well and are merged into a
+  // single run, and so on for the following dimensions.
+  size_t run_dim = 1u;
+  size_t run_length = region_size(0);
+  while(run_dim < Dim && region_size(run_dim - 1u) == src_size(run_dim - 1u)
+    && region_size(run_dim - 1u) == dst_size(run_dim - 1u))
   {
-    for(uint y = 0; y < in.get_size().y(); ++y)
-    {
-      for(uint z = 0; z < in.get_size().z(); ++z)
-      {
-        vec3u pos = vec3u(x, y, z);
-        out.set_pixel(offset + pos, in.get_pixel(pos));
-      }
-    }
+    run_length *= region_size(run_dim);
+    ++run_dim;
   }
+
+  size_t run_byte_count = run_length * sizeof(T);
+  vec<uint, Dim> pos = vec<uint, Dim>::zero();
+  do
+  {
+    std::memcpy(dst + compute_linear_index(dst_offset + pos, dst_size),
+      src + compute_linear_index(src_offset + pos, src_size), run_byte_count);
+  } while(advance_position(pos, region_size, run_dim));
 }
 
 }  // namespace
@@ -307,8 +283,11 @@ template <size_t Dim, pixel_format PF>
 image<Dim, PF> image<Dim, PF>::get_sub_image(
   const offset_type& offset, const size_type& size) const
 {
-  // get_image_sub_image will throw if the coordinates are not valid.
-  return get_image_sub_image(*this, offset, size);
+  HOU_CHECK_0(element_wise_lower_or_equal(offset + size, m_size), out_of_range);
+  image out(size);
+  copy_region(out.m_pixels.data(), out.m_size, offset_type::zero(),
+    m_pixels.data(), m_size, offset, size);
+  return out;
 }
 
 
@@ -316,8 +295,10 @@ image<Dim, PF> image<Dim, PF>::get_sub_image(
 template <size_t Dim, pixel_format PF>
 void image<Dim, PF>::set_sub_image(const offset_type& offset, const image& im)
 {
-  // set_image_sub_image will throw if the coordinates are not valid.
-  return set_image_sub_image(*this, offset, im);
+  HOU_CHECK_0(
+    element_wise_lower_or_equal(offset + im.m_size, m_size), out_of_range);
+  copy_region(m_pixels.data(), m_size, offset, im.m_pixels.data(), im.m_size,
+    offset_type::zero(), im.m_size);
 }
 
 
@@ -348,15 +329,46 @@ template <size_t Dim, pixel_format PF>
 size_t image<Dim, PF>::compute_pixel_index(const offset_type& coordinates) const
 {
   HOU_CHECK_0(element_wise_lower(coordinates, m_size), out_of_range);
+  return compute_linear_index(coordinates, m_size);
+}
 
-  size_t idx = 0;
-  size_t multiplier = 1;
+
+
+template <size_t Dim, pixel_format PF>
+void blit(image<Dim, PF>& dst, const vec<int, Dim>& dst_offset,
+  const image<Dim, PF>& src, const vec<uint, Dim>& src_offset,
+  const vec<uint, Dim>& src_size)
+{
+  vec<uint, Dim> clipped_dst_offset;
+  vec<uint, Dim> clipped_src_offset;
+  vec<uint, Dim> clipped_size;
   for(size_t i = 0; i < Dim; ++i)
   {
-    idx += coordinates(i) * multiplier;
-    multiplier *= m_size(i);
+    // 64 bits integers are used so that the sums can't overflow.
+    int64_t dst_begin = dst_offset(i);
+    int64_t src_begin = src_offset(i);
+    int64_t src_end = std::min<int64_t>(
+      src_begin + src_size(i), static_cast<int64_t>(src.m_size(i)));
+    if(dst_begin < 0)
+    {
+      src_begin -= dst_begin;
+      dst_begin = 0;
+    }
+    src_end = std::min<int64_t>(
+      src_end, src_begin + static_cast<int64_t>(dst.m_size(i)) - dst_begin);
+    if(src_end <= src_begin)
+    {
+      return;
+    }
+    clipped_dst_offset(i) = narrow_cast<uint>(dst_begin);
+    clipped_src_offset(i) = narrow_cast<uint>(src_begin);
+    clipped_size(i) = narrow_cast<uint>(src_end - src_begin);
   }
-  return idx;
+
+  HOU_PRECOND(&dst != &src
+    || !regions_overlap(clipped_dst_offset, clipped_src_offset, clipped_size));
+  copy_region(dst.m_pixels.data(), dst.m_size, clipped_dst_offset,
+    src.m_pixels.data(), src.m_size, clipped_src_offset, clipped_size);
 }
 
 
@@ -376,4 +388,31 @@ template class image<3u, pixel_format::rg>;
 template class image<3u, pixel_format::rgb>;
 template class image<3u, pixel_format::rgba>;
 
+template void blit<1u, pixel_format::r>(
+  image1_r&, const vec1i&, const image1_r&, const vec1u&, const vec1u&);
+template void blit<1u, pixel_format::rg>(
+  image1_rg&, const vec1i&, const image1_rg&, const vec1u&, const vec1u&);
+template void blit<1u, pixel_format::rgb>(
+  image1_rgb&, const vec1i&, const image1_rgb&, const vec1u&, const vec1u&);
+template void blit<1u, pixel_format::rgba>(
+  image1_rgba&, const vec1i&, const image1_rgba&, const vec1u&, const vec1u&);
+
+template void blit<2u, pixel_format::r>(
+  image2_r&, const vec2i&, const image2_r&, const vec2u&, const vec2u&);
+template void blit<2u, pixel_format::rg>(
+  image2_rg&, const vec2i&, const image2_rg&, const vec2u&, const vec2u&);
+template void blit<2u, pixel_format::rgb>(
+  image2_rgb&, const vec2i&, const image2_rgb&, const vec2u&, const vec2u&);
+template void blit<2u, pixel_format::rgba>(
+  image2_rgba&, const vec2i&, const image2_rgba&, const vec2u&, const vec2u&);
+
+template void blit<3u, pixel_format::r>(
+  image3_r&, const vec3i&, const image3_r&, const vec3u&, const vec3u&);
+template void blit<3u, pixel_format::rg>(
+  image3_rg&, const vec3i&, const image3_rg&, const vec3u&, const vec3u&);
+template void blit<3u, pixel_format::rgb>(
+  image3_rgb&, const vec3i&, const image3_rgb&, const vec3u&, const vec3u&);
+template void blit<3u, pixel_format::rgba>(
+  image3_rgba&, const vec3i&, const image3_rgba&, const vec3u&, const vec3u&);
+
 }  // namespace hou
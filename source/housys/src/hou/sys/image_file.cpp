@@ -14,7 +14,10 @@
 
 #include "soil/SOIL.h"
 
+#include <array>
+#include <cstring>
 #include <functional>
+#include <memory>
 
 
 
@@ -44,28 +47,84 @@ namespace hou
 namespace
 {
 
+// Number of bytes read by the stb_image test functions: the BMP test reads
+// the file header and the size of the info header, the PNG and JPG tests read
+// fewer bytes.
+constexpr size_t g_signature_byte_count = 18u;
+
+// Number of bytes containing the BMP and PNG information needed by
+// get_image_info. For BMP files, this includes the alpha channel mask of the
+// version 4 info header.
+constexpr size_t g_header_byte_count = 70u;
+
+// JPG markers.
+constexpr uchar g_jpg_marker_prefix = 0xffu;
+constexpr uchar g_jpg_marker_tem = 0x01u;
+constexpr uchar g_jpg_marker_sof0 = 0xc0u;
+constexpr uchar g_jpg_marker_sof15 = 0xcfu;
+constexpr uchar g_jpg_marker_dht = 0xc4u;
+constexpr uchar g_jpg_marker_jpg = 0xc8u;
+constexpr uchar g_jpg_marker_dac = 0xccu;
+constexpr uchar g_jpg_marker_rst0 = 0xd0u;
+constexpr uchar g_jpg_marker_soi = 0xd8u;
+constexpr uchar g_jpg_marker_eoi = 0xd9u;
+constexpr uchar g_jpg_marker_sos = 0xdau;
+
 using SoilTestFunction = std::function<int(uchar const*, int)>;
 
 using SoilLoadFunction
   = std::function<uchar*(uchar const*, int, int*, int*, int*, int)>;
 
+// Image data allocated by SOIL.
+using soil_image_data = std::unique_ptr<uchar, void (*)(uchar*)>;
+
 int pixel_format_to_soil_format(pixel_format pf);
 
 bool soil_test_memory(SoilTestFunction test_fun, uchar* buffer, size_t size);
 
 bool soil_test_file(SoilTestFunction test_fun, const std::string& path);
 
+std::vector<uchar> read_header(binary_file_in& fi, size_t byte_count);
+
+void read_header_bytes(binary_file_in& fi, uchar* buffer, size_t byte_count);
+
+uint get_u16_le(const uchar* bytes);
+
+uint get_u32_le(const uchar* bytes);
+
+uint get_u16_be(const uchar* bytes);
+
+uint get_u32_be(const uchar* bytes);
+
+image_file_info get_bmp_info(const std::vector<uchar>& header);
+
+image_file_info get_png_info(
+  const std::vector<uchar>& header, binary_file_in& fi);
+
+bool has_png_transparency(binary_file_in& fi);
+
+image_file_info get_jpg_info(binary_file_in& fi);
+
+uchar read_jpg_marker(binary_file_in& fi);
+
+bool is_jpg_standalone_marker(uchar marker);
+
+bool is_jpg_sof_marker(uchar marker);
+
+soil_image_data soil_decode(SoilLoadFunction load_fun,
+  SoilTestFunction test_fun, const span<const uint8_t>& data, int req_comp,
+  vec2u& image_size);
+
 template <pixel_format PF>
-std::tuple<image2<PF>, bool> soil_load_from_memory(SoilLoadFunction load_fun,
-  SoilTestFunction test_fun, uchar* buffer, size_t size);
+image2<PF> soil_load_from_memory(SoilLoadFunction load_fun,
+  SoilTestFunction test_fun, const span<const uint8_t>& data);
 
 template <pixel_format PF>
-std::tuple<image2<PF>, bool> soil_load_from_file(SoilLoadFunction load_fun,
-  SoilTestFunction test_fun, const std::string& path);
+image2<PF> soil_load_from_stream(
+  SoilLoadFunction load_fun, SoilTestFunction test_fun, binary_stream_in& bs);
 
 template <pixel_format PF>
-image2<PF> soil_load_from_file_with_check(SoilLoadFunction load_fun,
-  SoilTestFunction test_fun, const std::string& path);
+image2<PF> soil_make_image(soil_image_data data, const vec2u& image_size);
 
 template <pixel_format PF>
 bool soil_write_to_file(
@@ -108,64 +167,277 @@ bool soil_test_memory(SoilTestFunction test_fun, uchar* buffer, size_t size)
 bool soil_test_file(SoilTestFunction test_fun, const std::string& path)
 {
   binary_file_in fi(path);
-  std::vector<uchar> buffer(fi.get_byte_count());
-  fi.read(buffer);
-  return soil_test_memory(test_fun, buffer.data(), buffer.size());
+  std::vector<uchar> header = read_header(fi, g_signature_byte_count);
+  return soil_test_memory(test_fun, header.data(), header.size());
 }
 
 
 
-template <pixel_format PF>
-std::tuple<image2<PF>, bool> soil_load_from_memory(SoilLoadFunction load_fun,
-  SoilTestFunction test_fun, uchar* buffer, size_t size)
+std::vector<uchar> read_header(binary_file_in& fi, size_t byte_count)
 {
-  if(test_fun(buffer, narrow_cast<int>(size)) == 0)
+  // The file might be smaller than the requested header.
+  std::vector<uchar> header(byte_count);
+  fi.read(header);
+  header.resize(fi.get_read_byte_count());
+  return header;
+}
+
+
+
+void read_header_bytes(binary_file_in& fi, uchar* buffer, size_t byte_count)
+{
+  fi.read(buffer, byte_count);
+  HOU_CHECK_0(fi.get_read_byte_count() == byte_count, invalid_image_data);
+}
+
+
+
+uint get_u16_le(const uchar* bytes)
+{
+  return static_cast<uint>(bytes[0]) | static_cast<uint>(bytes[1]) << 8;
+}
+
+
+
+uint get_u32_le(const uchar* bytes)
+{
+  return get_u16_le(bytes) | get_u16_le(bytes + 2) << 16;
+}
+
+
+
+uint get_u16_be(const uchar* bytes)
+{
+  return static_cast<uint>(bytes[0]) << 8 | static_cast<uint>(bytes[1]);
+}
+
+
+
+uint get_u32_be(const uchar* bytes)
+{
+  return get_u16_be(bytes) << 16 | get_u16_be(bytes + 2);
+}
+
+
+
+image_file_info get_bmp_info(const std::vector<uchar>& header)
+{
+  // The header has already been recognized by stbi_bmp_test_memory, so it
+  // contains at least the size of the info header.
+  uint info_header_size = get_u32_le(&header[14]);
+  vec2u size;
+  if(info_header_size == 12u)
+  {
+    HOU_CHECK_0(header.size() >= 22u, invalid_image_data);
+    size = vec2u(get_u16_le(&header[18]), get_u16_le(&header[20]));
+  }
+  else
   {
-    return std::make_tuple(image2<PF>(), false);
+    HOU_CHECK_0(header.size() >= 26u, invalid_image_data);
+    // The height is negative for top-down images.
+    int32_t height = static_cast<int32_t>(get_u32_le(&header[22]));
+    size = vec2u(get_u32_le(&header[18]),
+      narrow_cast<uint>(height < 0 ? -static_cast<int64_t>(height) : height));
   }
+  HOU_CHECK_0(size.x() > 0u && size.y() > 0u, invalid_image_data);
 
-  int width;
-  int height;
-  uchar* raw_image = load_fun(buffer, narrow_cast<int>(size), &width, &height,
-    nullptr, pixel_format_to_soil_format(PF));
-  if(raw_image == nullptr)
+  // As in stb_image, only the version 4 info header can define an alpha
+  // channel.
+  bool has_alpha = info_header_size == 108u
+    && header.size() >= g_header_byte_count && get_u32_le(&header[66]) != 0u;
+  return image_file_info{image_file_format::bmp, size, has_alpha ? 4u : 3u};
+}
+
+
+
+image_file_info get_png_info(
+  const std::vector<uchar>& header, binary_file_in& fi)
+{
+  // The signature is followed by the IHDR chunk, containing the width, the
+  // height, the bit depth and the color type.
+  HOU_CHECK_0(header.size() >= 26u && std::memcmp(&header[12], "IHDR", 4u) == 0,
+    invalid_image_data);
+  vec2u size(get_u32_be(&header[16]), get_u32_be(&header[20]));
+  HOU_CHECK_0(size.x() > 0u && size.y() > 0u, invalid_image_data);
+
+  uint channel_count = 0u;
+  switch(header[25])
   {
-    return std::make_tuple(image2<PF>(), false);
+    case 0u:
+      channel_count = 1u;
+      break;
+    case 2u:
+      channel_count = 3u;
+      break;
+    case 3u:
+      // As in stb_image, palette images have an alpha channel if they have a
+      // transparency chunk.
+      channel_count = has_png_transparency(fi) ? 4u : 3u;
+      break;
+    case 4u:
+      channel_count = 2u;
+      break;
+    case 6u:
+      channel_count = 4u;
+      break;
+    default:
+      HOU_ERROR_0(invalid_image_data);
   }
+  return image_file_info{image_file_format::png, size, channel_count};
+}
 
-  vec2u image_size(narrow_cast<uint>(width), narrow_cast<uint>(height));
-  image2<PF> ret_image(image_size,
-    span<const typename image2<PF>::pixel_type>(
-      reinterpret_cast<const typename image2<PF>::pixel_type*>(raw_image),
-      width * height));
-  SOIL_free_image_data(raw_image);
-  return std::make_tuple(ret_image, true);
+
+
+bool has_png_transparency(binary_file_in& fi)
+{
+  // The chunks following the IHDR chunk are skipped until the first IDAT
+  // chunk, since the tRNS chunk must precede it. The IHDR chunk ends after
+  // the 8 bytes of the signature and the 25 bytes of the chunk itself.
+  fi.set_byte_pos(33);
+  // Chunk length, chunk type.
+  std::array<uchar, 8u> chunk;
+  read_header_bytes(fi, chunk.data(), chunk.size());
+  while(std::memcmp(&chunk[4], "IDAT", 4u) != 0
+    && std::memcmp(&chunk[4], "IEND", 4u) != 0)
+  {
+    if(std::memcmp(&chunk[4], "tRNS", 4u) == 0)
+    {
+      return true;
+    }
+    // Skip the chunk data and the CRC.
+    fi.move_byte_pos(
+      narrow_cast<binary_file_in::byte_offset>(get_u32_be(chunk.data()) + 4u));
+    read_header_bytes(fi, chunk.data(), chunk.size());
+  }
+  return false;
+}
+
+
+
+image_file_info get_jpg_info(binary_file_in& fi)
+{
+  // The segments following the start of image marker are skipped until the
+  // start of frame segment, containing the image size and the number of
+  // components.
+  fi.set_byte_pos(2);
+  uchar marker = read_jpg_marker(fi);
+  std::array<uchar, 8u> segment;
+  while(!is_jpg_sof_marker(marker))
+  {
+    HOU_CHECK_0(
+      marker != g_jpg_marker_sos && marker != g_jpg_marker_eoi,
+      invalid_image_data);
+    if(!is_jpg_standalone_marker(marker))
+    {
+      read_header_bytes(fi, segment.data(), 2u);
+      uint length = get_u16_be(segment.data());
+      HOU_CHECK_0(length >= 2u, invalid_image_data);
+      fi.move_byte_pos(narrow_cast<binary_file_in::byte_offset>(length - 2u));
+    }
+    marker = read_jpg_marker(fi);
+  }
+
+  // Segment length, sample precision, height, width, component count.
+  read_header_bytes(fi, segment.data(), segment.size());
+  vec2u size(get_u16_be(&segment[5]), get_u16_be(&segment[3]));
+  HOU_CHECK_0(size.x() > 0u && size.y() > 0u, invalid_image_data);
+  return image_file_info{image_file_format::jpg, size, segment[7]};
+}
+
+
+
+uchar read_jpg_marker(binary_file_in& fi)
+{
+  std::array<uchar, 2u> marker;
+  read_header_bytes(fi, marker.data(), marker.size());
+  HOU_CHECK_0(marker[0] == g_jpg_marker_prefix, invalid_image_data);
+
+  // Markers can be preceded by any number of fill bytes.
+  while(marker[1] == g_jpg_marker_prefix)
+  {
+    read_header_bytes(fi, &marker[1], 1u);
+  }
+  return marker[1];
+}
+
+
+
+bool is_jpg_standalone_marker(uchar marker)
+{
+  return marker == g_jpg_marker_tem || marker == g_jpg_marker_soi
+    || (marker >= g_jpg_marker_rst0 && marker < g_jpg_marker_soi);
+}
+
+
+
+bool is_jpg_sof_marker(uchar marker)
+{
+  return marker >= g_jpg_marker_sof0 && marker <= g_jpg_marker_sof15
+    && marker != g_jpg_marker_dht && marker != g_jpg_marker_jpg
+    && marker != g_jpg_marker_dac;
+}
+
+
+
+soil_image_data soil_decode(SoilLoadFunction load_fun,
+  SoilTestFunction test_fun, const span<const uint8_t>& data, int req_comp,
+  vec2u& image_size)
+{
+  int size = narrow_cast<int>(data.size());
+  HOU_CHECK_0(test_fun(data.data(), size) != 0, invalid_image_data);
+
+  int width;
+  int height;
+  soil_image_data raw_image(
+    load_fun(data.data(), size, &width, &height, nullptr, req_comp),
+    SOIL_free_image_data);
+  HOU_CHECK_0(raw_image != nullptr, invalid_image_data);
+  image_size = vec2u(narrow_cast<uint>(width), narrow_cast<uint>(height));
+  return raw_image;
 }
 
 
 
 template <pixel_format PF>
-std::tuple<image2<PF>, bool> soil_load_from_file(
-  SoilLoadFunction load_fun, SoilTestFunction test_fun, const std::string& path)
+image2<PF> soil_load_from_memory(SoilLoadFunction load_fun,
+  SoilTestFunction test_fun, const span<const uint8_t>& data)
 {
-  binary_file_in fi(path);
-  std::vector<uchar> buffer(fi.get_byte_count());
-  fi.read(buffer);
-  return soil_load_from_memory<PF>(
-    load_fun, test_fun, buffer.data(), buffer.size());
+  vec2u image_size;
+  soil_image_data raw_image = soil_decode(
+    load_fun, test_fun, data, pixel_format_to_soil_format(PF), image_size);
+  return soil_make_image<PF>(std::move(raw_image), image_size);
 }
 
 
 
 template <pixel_format PF>
-image2<PF> soil_load_from_file_with_check(
-  SoilLoadFunction load_fun, SoilTestFunction test_fun, const std::string& path)
+image2<PF> soil_load_from_stream(
+  SoilLoadFunction load_fun, SoilTestFunction test_fun, binary_stream_in& bs)
 {
-  image2<PF> im;
-  bool rv = false;
-  std::tie(im, rv) = soil_load_from_file<PF>(load_fun, test_fun, path);
-  HOU_CHECK_0(rv, invalid_image_data);
-  return im;
+  vec2u image_size;
+  soil_image_data raw_image(nullptr, SOIL_free_image_data);
+  {
+    // The encoded data is released before the decoded pixels are copied into
+    // the image, so that the two buffers are not held at the same time as the
+    // image.
+    std::vector<uint8_t> data = bs.read_all<std::vector<uint8_t>>();
+    raw_image = soil_decode(load_fun, test_fun, data,
+      pixel_format_to_soil_format(PF), image_size);
+  }
+  return soil_make_image<PF>(std::move(raw_image), image_size);
+}
+
+
+
+template <pixel_format PF>
+image2<PF> soil_make_image(soil_image_data data, const vec2u& image_size)
+{
+  // SOIL allocates the decoded pixels with malloc, the buffer can't be adopted
+  // by the image and has to be copied.
+  return image2<PF>(image_size,
+    span<const typename image2<PF>::pixel_type>(
+      reinterpret_cast<const typename image2<PF>::pixel_type*>(data.get()),
+      image_size.x() * image_size.y()));
 }
 
 
@@ -212,8 +484,27 @@ bool bmp_image_file::check(const std::string& path)
 template <pixel_format PF>
 image2<PF> bmp_image_file::read(const std::string& path)
 {
-  return soil_load_from_file_with_check<PF>(
-    stbi_bmp_load_from_memory, stbi_bmp_test_memory, path);
+  binary_file_in fi(path);
+  return read<PF>(fi);
+}
+
+
+
+template <pixel_format PF>
+image2<PF> bmp_image_file::read(binary_stream_in& bs)
+{
+  return soil_load_from_stream<PF>(
+    stbi_bmp_load_from_memory, stbi_bmp_test_memory, bs);
+}
+
+
+
+template <pixel_format PF>
+image2<PF> bmp_image_file::read_from_memory(
+  const span<const uint8_t>& data)
+{
+  return soil_load_from_memory<PF>(
+    stbi_bmp_load_from_memory, stbi_bmp_test_memory, data);
 }
 
 
@@ -236,8 +527,27 @@ bool png_image_file::check(const std::string& path)
 template <pixel_format PF>
 image2<PF> png_image_file::read(const std::string& path)
 {
-  return soil_load_from_file_with_check<PF>(
-    stbi_png_load_from_memory, stbi_png_test_memory, path);
+  binary_file_in fi(path);
+  return read<PF>(fi);
+}
+
+
+
+template <pixel_format PF>
+image2<PF> png_image_file::read(binary_stream_in& bs)
+{
+  return soil_load_from_stream<PF>(
+    stbi_png_load_from_memory, stbi_png_test_memory, bs);
+}
+
+
+
+template <pixel_format PF>
+image2<PF> png_image_file::read_from_memory(
+  const span<const uint8_t>& data)
+{
+  return soil_load_from_memory<PF>(
+    stbi_png_load_from_memory, stbi_png_test_memory, data);
 }
 
 
@@ -252,14 +562,59 @@ bool jpg_image_file::check(const std::string& path)
 template <pixel_format PF>
 image2<PF> jpg_image_file::read(const std::string& path)
 {
-  return soil_load_from_file_with_check<PF>(
-    stbi_jpeg_load_from_memory, stbi_jpeg_test_memory, path);
+  binary_file_in fi(path);
+  return read<PF>(fi);
+}
+
+
+
+template <pixel_format PF>
+image2<PF> jpg_image_file::read(binary_stream_in& bs)
+{
+  return soil_load_from_stream<PF>(
+    stbi_jpeg_load_from_memory, stbi_jpeg_test_memory, bs);
+}
+
+
+
+template <pixel_format PF>
+image2<PF> jpg_image_file::read_from_memory(
+  const span<const uint8_t>& data)
+{
+  return soil_load_from_memory<PF>(
+    stbi_jpeg_load_from_memory, stbi_jpeg_test_memory, data);
+}
+
+
+
+image_file_info get_image_info(const std::string& path)
+{
+  binary_file_in fi(path);
+  std::vector<uchar> header = read_header(fi, g_header_byte_count);
+  if(soil_test_memory(stbi_bmp_test_memory, header.data(), header.size()))
+  {
+    return get_bmp_info(header);
+  }
+  else if(soil_test_memory(stbi_png_test_memory, header.data(), header.size()))
+  {
+    return get_png_info(header, fi);
+  }
+  else if(
+    soil_test_memory(stbi_jpeg_test_memory, header.data(), header.size()))
+  {
+    return get_jpg_info(fi);
+  }
+  HOU_ERROR_0(invalid_image_data);
+  return image_file_info();
 }
 
 
 
 #define INSTANTIATE_READ_FILE_FUNCTION_FOR_PIXEL_FORMAT(image_file_class, PF)  \
-  template image2<PF> image_file_class::read<PF>(const std::string&);
+  template image2<PF> image_file_class::read<PF>(const std::string&);          \
+  template image2<PF> image_file_class::read<PF>(binary_stream_in&);           \
+  template image2<PF> image_file_class::read_from_memory<PF>(                  \
+    const span<const uint8_t>&);
 
 
 
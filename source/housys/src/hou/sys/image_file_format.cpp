@@ -0,0 +1,29 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/sys/image_file_format.hpp"
+
+#include "hou/cor/core_functions.hpp"
+
+#define IMAGE_FILE_FORMAT_CASE(iff, os)                                        \
+  case image_file_format::iff:                                                 \
+    return (os) << #iff
+
+
+
+namespace hou
+{
+
+std::ostream& operator<<(std::ostream& os, image_file_format iff)
+{
+  switch(iff)
+  {
+    IMAGE_FILE_FORMAT_CASE(bmp, os);
+    IMAGE_FILE_FORMAT_CASE(png, os);
+    IMAGE_FILE_FORMAT_CASE(jpg, os);
+  }
+  return STREAM_VALUE(os, image_file_format, iff);
+}
+
+}  // namespace hou
@@ -0,0 +1,177 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/sys/image_loading.hpp"
+
+#include "hou/sys/image_file.hpp"
+
+#include "hou/cor/assertions.hpp"
+#include "hou/cor/narrow_cast.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <mutex>
+
+
+
+namespace hou
+{
+
+namespace
+{
+
+template <pixel_format PF>
+struct loaded_image
+{
+  size_t index;
+  image2<PF> im;
+  std::exception_ptr error;
+};
+
+}  // namespace
+
+
+
+template <pixel_format PF>
+image2<PF> read_image(const std::string& path)
+{
+  image_file_format iff = get_image_info(path).format;
+  switch(iff)
+  {
+    case image_file_format::bmp:
+      return bmp_image_file::read<PF>(path);
+    case image_file_format::png:
+      return png_image_file::read<PF>(path);
+    case image_file_format::jpg:
+      return jpg_image_file::read<PF>(path);
+  }
+  HOU_ERROR_N(invalid_enum,
+    narrow_cast<int>(
+      static_cast<std::underlying_type<image_file_format>::type>(iff)));
+  return image2<PF>();
+}
+
+
+
+template <pixel_format PF>
+void load_images(const std::vector<std::string>& paths, size_t thread_count,
+  const image_loaded_callback<PF>& on_image_loaded)
+{
+  HOU_PRECOND(thread_count > 0u);
+  HOU_PRECOND(on_image_loaded != nullptr);
+
+  // The workers hand the decoded images over to the calling thread through a
+  // queue. Errors are handed over as well, so that the calling thread always
+  // knows when to stop waiting.
+  std::mutex queue_mutex;
+  std::condition_variable queue_cv;
+  std::vector<loaded_image<PF>> queue;
+  std::atomic<size_t> next_path(0u);
+  auto worker = [&]() {
+    for(size_t i = next_path++; i < paths.size(); i = next_path++)
+    {
+      loaded_image<PF> li{i, image2<PF>(), nullptr};
+      try
+      {
+        li.im = read_image<PF>(paths[i]);
+      }
+      catch(...)
+      {
+        li.error = std::current_exception();
+      }
+      {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        queue.push_back(std::move(li));
+      }
+      queue_cv.notify_one();
+    }
+  };
+
+  std::vector<std::future<void>> workers;
+  thread_count = std::min(thread_count, paths.size());
+  workers.reserve(thread_count);
+  for(size_t i = 0; i < thread_count; ++i)
+  {
+    workers.push_back(std::async(std::launch::async, worker));
+  }
+
+  std::exception_ptr error;
+  std::vector<loaded_image<PF>> ready;
+  for(size_t handled_count = 0u; handled_count < paths.size() && !error;)
+  {
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex);
+      queue_cv.wait(lock, [&queue]() { return !queue.empty(); });
+      ready.swap(queue);
+    }
+    for(auto& li : ready)
+    {
+      ++handled_count;
+      if(!error)
+      {
+        try
+        {
+          if(li.error)
+          {
+            std::rethrow_exception(li.error);
+          }
+          on_image_loaded(li.index, li.im);
+        }
+        catch(...)
+        {
+          error = std::current_exception();
+        }
+      }
+    }
+    ready.clear();
+  }
+
+  // All workers must be joined before returning, since they reference
+  // objects local to this function. In case of error, the remaining paths are
+  // skipped.
+  next_path = paths.size();
+  for(auto& w : workers)
+  {
+    w.wait();
+  }
+  for(auto& w : workers)
+  {
+    w.get();
+  }
+  if(error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+
+
+template <pixel_format PF>
+std::vector<image2<PF>> load_images(
+  const std::vector<std::string>& paths, size_t thread_count)
+{
+  std::vector<image2<PF>> images(paths.size());
+  load_images<PF>(paths, thread_count,
+    [&images](size_t index, image2<PF>& im) { images[index] = std::move(im); });
+  return images;
+}
+
+
+
+#define INSTANTIATE_IMAGE_LOADING_FUNCTIONS(PF)                                \
+  template image2<PF> read_image<PF>(const std::string&);                      \
+  template void load_images<PF>(const std::vector<std::string>&, size_t,       \
+    const image_loaded_callback<PF>&);                                         \
+  template std::vector<image2<PF>> load_images<PF>(                            \
+    const std::vector<std::string>&, size_t);
+
+INSTANTIATE_IMAGE_LOADING_FUNCTIONS(pixel_format::r)
+INSTANTIATE_IMAGE_LOADING_FUNCTIONS(pixel_format::rg)
+INSTANTIATE_IMAGE_LOADING_FUNCTIONS(pixel_format::rgb)
+INSTANTIATE_IMAGE_LOADING_FUNCTIONS(pixel_format::rgba)
+
+}  // namespace hou
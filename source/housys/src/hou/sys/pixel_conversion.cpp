@@ -0,0 +1,536 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/sys/pixel_conversion.hpp"
+
+#include "hou/cor/assertions.hpp"
+
+#include <atomic>
+#include <cstring>
+
+#if !defined(HOU_EMSCRIPTEN)                                                   \
+  && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__)              \
+    || defined(_M_IX86))
+  #define HOU_SYS_PIXEL_CONVERSION_X86
+  #include <immintrin.h>
+  // SDL_cpuinfo.h tests this macro without checking if it is defined.
+  #if !defined(HAVE_IMMINTRIN_H)
+    #define HAVE_IMMINTRIN_H 1
+  #endif
+  #include "SDL_cpuinfo.h"
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define HOU_SYS_PIXEL_CONVERSION_NEON
+  #include <arm_neon.h>
+#endif
+
+// Functions using instructions beyond the baseline of the target architecture
+// must be marked, so that GCC and Clang generate them without requiring the
+// whole library to be compiled for a more recent CPU.
+#if defined(HOU_COMPILER_MSVC)
+  #define HOU_SYS_TARGET(isa)
+#else
+  #define HOU_SYS_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+
+
+namespace hou
+{
+
+namespace
+{
+
+// Weights used to compute the luminance, as in the pixel conversion
+// constructors. The luminance is the weighted sum divided by 256.
+constexpr uint8_t g_r_weight = 77u;
+constexpr uint8_t g_g_weight = 150u;
+constexpr uint8_t g_b_weight = 29u;
+
+pixel_conversion_backend detect_pixel_conversion_backend();
+
+std::atomic<pixel_conversion_backend>& get_backend_variable();
+
+// The SIMD kernels convert the largest possible part of the sequence and
+// return the number of converted pixels. The remaining pixels are converted
+// one by one by the caller.
+template <pixel_format InPF, pixel_format OutPF>
+size_t convert_pixels_simd(
+  const uint8_t* in, uint8_t* out, size_t count, pixel_conversion_backend pcb);
+
+template <>
+size_t convert_pixels_simd<pixel_format::rgba, pixel_format::r>(
+  const uint8_t* in, uint8_t* out, size_t count, pixel_conversion_backend pcb);
+
+template <>
+size_t convert_pixels_simd<pixel_format::rgba, pixel_format::rgb>(
+  const uint8_t* in, uint8_t* out, size_t count, pixel_conversion_backend pcb);
+
+template <>
+size_t convert_pixels_simd<pixel_format::rgb, pixel_format::rgba>(
+  const uint8_t* in, uint8_t* out, size_t count, pixel_conversion_backend pcb);
+
+#if defined(HOU_SYS_PIXEL_CONVERSION_X86)
+HOU_SYS_TARGET("sse2")
+__m128i compute_luminance_sse2(__m128i px);
+
+HOU_SYS_TARGET("sse2")
+size_t convert_rgba_to_r_sse2(const uint8_t* in, uint8_t* out, size_t count);
+
+HOU_SYS_TARGET("avx2")
+__m256i compute_luminance_avx2(__m256i px);
+
+HOU_SYS_TARGET("avx2")
+__m256i load_two_lanes_avx2(const uint8_t* lo, const uint8_t* hi);
+
+HOU_SYS_TARGET("avx2")
+size_t convert_rgba_to_r_avx2(const uint8_t* in, uint8_t* out, size_t count);
+
+HOU_SYS_TARGET("avx2")
+size_t convert_rgba_to_rgb_avx2(
+  const uint8_t* in, uint8_t* out, size_t count);
+
+HOU_SYS_TARGET("avx2")
+size_t convert_rgb_to_rgba_avx2(
+  const uint8_t* in, uint8_t* out, size_t count);
+#endif
+
+#if defined(HOU_SYS_PIXEL_CONVERSION_NEON)
+uint8x8_t compute_luminance_neon(uint8x8_t r, uint8x8_t g, uint8x8_t b);
+
+size_t convert_rgba_to_r_neon(const uint8_t* in, uint8_t* out, size_t count);
+
+size_t convert_rgba_to_rgb_neon(
+  const uint8_t* in, uint8_t* out, size_t count);
+
+size_t convert_rgb_to_rgba_neon(
+  const uint8_t* in, uint8_t* out, size_t count);
+#endif
+
+
+
+pixel_conversion_backend detect_pixel_conversion_backend()
+{
+  for(auto pcb : {pixel_conversion_backend::avx2,
+        pixel_conversion_backend::neon, pixel_conversion_backend::sse2})
+  {
+    if(is_pixel_conversion_backend_supported(pcb))
+    {
+      return pcb;
+    }
+  }
+  return pixel_conversion_backend::scalar;
+}
+
+
+
+std::atomic<pixel_conversion_backend>& get_backend_variable()
+{
+  static std::atomic<pixel_conversion_backend> backend(
+    detect_pixel_conversion_backend());
+  return backend;
+}
+
+
+
+template <pixel_format InPF, pixel_format OutPF>
+size_t convert_pixels_simd(
+  const uint8_t*, uint8_t*, size_t, pixel_conversion_backend)
+{
+  return 0u;
+}
+
+
+
+template <>
+size_t convert_pixels_simd<pixel_format::rgba, pixel_format::r>(
+  const uint8_t* in, uint8_t* out, size_t count, pixel_conversion_backend pcb)
+{
+  switch(pcb)
+  {
+    case pixel_conversion_backend::sse2:
+#if defined(HOU_SYS_PIXEL_CONVERSION_X86)
+      return convert_rgba_to_r_sse2(in, out, count);
+#else
+      return 0u;
+#endif
+    case pixel_conversion_backend::avx2:
+#if defined(HOU_SYS_PIXEL_CONVERSION_X86)
+      return convert_rgba_to_r_avx2(in, out, count);
+#else
+      return 0u;
+#endif
+    case pixel_conversion_backend::neon:
+#if defined(HOU_SYS_PIXEL_CONVERSION_NEON)
+      return convert_rgba_to_r_neon(in, out, count);
+#else
+      return 0u;
+#endif
+    case pixel_conversion_backend::scalar:
+      return 0u;
+  }
+  return 0u;
+}
+
+
+
+template <>
+size_t convert_pixels_simd<pixel_format::rgba, pixel_format::rgb>(
+  const uint8_t* in, uint8_t* out, size_t count, pixel_conversion_backend pcb)
+{
+  switch(pcb)
+  {
+    case pixel_conversion_backend::avx2:
+#if defined(HOU_SYS_PIXEL_CONVERSION_X86)
+      return convert_rgba_to_rgb_avx2(in, out, count);
+#else
+      return 0u;
+#endif
+    case pixel_conversion_backend::neon:
+#if defined(HOU_SYS_PIXEL_CONVERSION_NEON)
+      return convert_rgba_to_rgb_neon(in, out, count);
+#else
+      return 0u;
+#endif
+    case pixel_conversion_backend::scalar:
+    case pixel_conversion_backend::sse2:
+      return 0u;
+  }
+  return 0u;
+}
+
+
+
+template <>
+size_t convert_pixels_simd<pixel_format::rgb, pixel_format::rgba>(
+  const uint8_t* in, uint8_t* out, size_t count, pixel_conversion_backend pcb)
+{
+  switch(pcb)
+  {
+    case pixel_conversion_backend::avx2:
+#if defined(HOU_SYS_PIXEL_CONVERSION_X86)
+      return convert_rgb_to_rgba_avx2(in, out, count);
+#else
+      return 0u;
+#endif
+    case pixel_conversion_backend::neon:
+#if defined(HOU_SYS_PIXEL_CONVERSION_NEON)
+      return convert_rgb_to_rgba_neon(in, out, count);
+#else
+      return 0u;
+#endif
+    case pixel_conversion_backend::scalar:
+    case pixel_conversion_backend::sse2:
+      return 0u;
+  }
+  return 0u;
+}
+
+
+
+#if defined(HOU_SYS_PIXEL_CONVERSION_X86)
+// Computes the luminance of 4 rgba pixels. The result is stored in the
+// lowest byte of each 32 bits element.
+HOU_SYS_TARGET("sse2")
+__m128i compute_luminance_sse2(__m128i px)
+{
+  // Each channel is moved to the lowest 16 bits of the 32 bits elements, so
+  // that it can be multiplied by 16 bits weights. The weighted sum is at most
+  // 255 * 256 and fits in 16 bits.
+  const __m128i channel_mask = _mm_set1_epi32(0xff);
+  __m128i r = _mm_and_si128(px, channel_mask);
+  __m128i g = _mm_and_si128(_mm_srli_epi32(px, 8), channel_mask);
+  __m128i b = _mm_and_si128(_mm_srli_epi32(px, 16), channel_mask);
+  __m128i sum = _mm_add_epi32(
+    _mm_add_epi32(_mm_mullo_epi16(r, _mm_set1_epi32(g_r_weight)),
+      _mm_mullo_epi16(g, _mm_set1_epi32(g_g_weight))),
+    _mm_mullo_epi16(b, _mm_set1_epi32(g_b_weight)));
+  return _mm_srli_epi32(sum, 8);
+}
+
+
+
+HOU_SYS_TARGET("sse2")
+size_t convert_rgba_to_r_sse2(const uint8_t* in, uint8_t* out, size_t count)
+{
+  size_t i = 0u;
+  for(; i + 16u <= count; i += 16u)
+  {
+    const __m128i* src = reinterpret_cast<const __m128i*>(in + 4u * i);
+    __m128i l0 = compute_luminance_sse2(_mm_loadu_si128(src));
+    __m128i l1 = compute_luminance_sse2(_mm_loadu_si128(src + 1));
+    __m128i l2 = compute_luminance_sse2(_mm_loadu_si128(src + 2));
+    __m128i l3 = compute_luminance_sse2(_mm_loadu_si128(src + 3));
+    __m128i l = _mm_packus_epi16(
+      _mm_packs_epi32(l0, l1), _mm_packs_epi32(l2, l3));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), l);
+  }
+  return i;
+}
+
+
+
+// Computes the luminance of 8 rgba pixels. The result is stored in the
+// lowest byte of each 32 bits element.
+HOU_SYS_TARGET("avx2")
+__m256i compute_luminance_avx2(__m256i px)
+{
+  const __m256i channel_mask = _mm256_set1_epi32(0xff);
+  __m256i r = _mm256_and_si256(px, channel_mask);
+  __m256i g = _mm256_and_si256(_mm256_srli_epi32(px, 8), channel_mask);
+  __m256i b = _mm256_and_si256(_mm256_srli_epi32(px, 16), channel_mask);
+  __m256i sum = _mm256_add_epi32(
+    _mm256_add_epi32(_mm256_mullo_epi16(r, _mm256_set1_epi32(g_r_weight)),
+      _mm256_mullo_epi16(g, _mm256_set1_epi32(g_g_weight))),
+    _mm256_mullo_epi16(b, _mm256_set1_epi32(g_b_weight)));
+  return _mm256_srli_epi32(sum, 8);
+}
+
+
+
+// Loads 16 bytes from each address into the two 128 bits lanes.
+HOU_SYS_TARGET("avx2")
+__m256i load_two_lanes_avx2(const uint8_t* lo, const uint8_t* hi)
+{
+  return _mm256_inserti128_si256(
+    _mm256_castsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(lo))),
+    _mm_loadu_si128(reinterpret_cast<const __m128i*>(hi)), 1);
+}
+
+
+
+HOU_SYS_TARGET("avx2")
+size_t convert_rgba_to_r_avx2(const uint8_t* in, uint8_t* out, size_t count)
+{
+  // Packing works within 128 bits lanes, the permutation restores the order
+  // of the pixels.
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  size_t i = 0u;
+  for(; i + 32u <= count; i += 32u)
+  {
+    const __m256i* src = reinterpret_cast<const __m256i*>(in + 4u * i);
+    __m256i l0 = compute_luminance_avx2(_mm256_loadu_si256(src));
+    __m256i l1 = compute_luminance_avx2(_mm256_loadu_si256(src + 1));
+    __m256i l2 = compute_luminance_avx2(_mm256_loadu_si256(src + 2));
+    __m256i l3 = compute_luminance_avx2(_mm256_loadu_si256(src + 3));
+    __m256i l = _mm256_packus_epi16(
+      _mm256_packs_epi32(l0, l1), _mm256_packs_epi32(l2, l3));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),
+      _mm256_permutevar8x32_epi32(l, order));
+  }
+  return i;
+}
+
+
+
+HOU_SYS_TARGET("avx2")
+size_t convert_rgba_to_rgb_avx2(const uint8_t* in, uint8_t* out, size_t count)
+{
+  // Each lane holds 4 pixels, packed into its lowest 12 bytes.
+  const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13,
+    14, -1, -1, -1, -1, 0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+  size_t i = 0u;
+  for(; i + 8u <= count; i += 8u)
+  {
+    __m256i px = _mm256_shuffle_epi8(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 4u * i)),
+      shuffle);
+    uint8_t rgb[32];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgb), px);
+    std::memcpy(out + 3u * i, rgb, 12u);
+    std::memcpy(out + 3u * i + 12u, rgb + 16u, 12u);
+  }
+  return i;
+}
+
+
+
+HOU_SYS_TARGET("avx2")
+size_t convert_rgb_to_rgba_avx2(const uint8_t* in, uint8_t* out, size_t count)
+{
+  // Each lane is loaded with 4 pixels, followed by 4 unused bytes. The last
+  // load reads 4 bytes past the converted pixels, so 2 more input pixels are
+  // required for each iteration.
+  const __m256i shuffle = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8,
+    -1, 9, 10, 11, -1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+  const __m256i alpha = _mm256_set1_epi32(static_cast<int>(0xff000000u));
+  size_t i = 0u;
+  for(; i + 10u <= count; i += 8u)
+  {
+    __m256i px = _mm256_or_si256(
+      _mm256_shuffle_epi8(
+        load_two_lanes_avx2(in + 3u * i, in + 3u * i + 12u), shuffle),
+      alpha);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 4u * i), px);
+  }
+  return i;
+}
+#endif
+
+
+
+#if defined(HOU_SYS_PIXEL_CONVERSION_NEON)
+uint8x8_t compute_luminance_neon(uint8x8_t r, uint8x8_t g, uint8x8_t b)
+{
+  // The weighted sum is at most 255 * 256 and fits in 16 bits.
+  uint16x8_t sum = vmull_u8(r, vdup_n_u8(g_r_weight));
+  sum = vmlal_u8(sum, g, vdup_n_u8(g_g_weight));
+  sum = vmlal_u8(sum, b, vdup_n_u8(g_b_weight));
+  return vshrn_n_u16(sum, 8);
+}
+
+
+
+size_t convert_rgba_to_r_neon(const uint8_t* in, uint8_t* out, size_t count)
+{
+  size_t i = 0u;
+  for(; i + 16u <= count; i += 16u)
+  {
+    uint8x16x4_t px = vld4q_u8(in + 4u * i);
+    uint8x8_t lo = compute_luminance_neon(vget_low_u8(px.val[0]),
+      vget_low_u8(px.val[1]), vget_low_u8(px.val[2]));
+    uint8x8_t hi = compute_luminance_neon(vget_high_u8(px.val[0]),
+      vget_high_u8(px.val[1]), vget_high_u8(px.val[2]));
+    vst1q_u8(out + i, vcombine_u8(lo, hi));
+  }
+  return i;
+}
+
+
+
+size_t convert_rgba_to_rgb_neon(const uint8_t* in, uint8_t* out, size_t count)
+{
+  size_t i = 0u;
+  for(; i + 16u <= count; i += 16u)
+  {
+    uint8x16x4_t px = vld4q_u8(in + 4u * i);
+    uint8x16x3_t rgb = {{px.val[0], px.val[1], px.val[2]}};
+    vst3q_u8(out + 3u * i, rgb);
+  }
+  return i;
+}
+
+
+
+size_t convert_rgb_to_rgba_neon(const uint8_t* in, uint8_t* out, size_t count)
+{
+  size_t i = 0u;
+  for(; i + 16u <= count; i += 16u)
+  {
+    uint8x16x3_t px = vld3q_u8(in + 3u * i);
+    uint8x16x4_t rgba
+      = {{px.val[0], px.val[1], px.val[2], vdupq_n_u8(255u)}};
+    vst4q_u8(out + 4u * i, rgba);
+  }
+  return i;
+}
+#endif
+
+}  // namespace
+
+
+
+template <pixel_format InPF, pixel_format OutPF>
+void convert_pixels(
+  const span<const pixel<InPF>>& in, const span<pixel<OutPF>>& out)
+{
+  static_assert(sizeof(pixel<InPF>) == pixel<InPF>::byte_count
+      && sizeof(pixel<OutPF>) == pixel<OutPF>::byte_count,
+    "Pixels must not contain padding.");
+  HOU_PRECOND(in.size() == out.size());
+
+  size_t converted_count = convert_pixels_simd<InPF, OutPF>(
+    reinterpret_cast<const uint8_t*>(in.data()),
+    reinterpret_cast<uint8_t*>(out.data()), in.size(),
+    get_backend_variable().load(std::memory_order_relaxed));
+  for(size_t i = converted_count; i < in.size(); ++i)
+  {
+    out[i] = pixel<OutPF>(in[i]);
+  }
+}
+
+
+
+bool is_pixel_conversion_backend_supported(pixel_conversion_backend pcb)
+{
+  switch(pcb)
+  {
+    case pixel_conversion_backend::scalar:
+      return true;
+    case pixel_conversion_backend::sse2:
+#if defined(HOU_SYS_PIXEL_CONVERSION_X86)
+      return SDL_HasSSE2() == SDL_TRUE;
+#else
+      return false;
+#endif
+    case pixel_conversion_backend::avx2:
+#if defined(HOU_SYS_PIXEL_CONVERSION_X86)
+      return SDL_HasAVX2() == SDL_TRUE;
+#else
+      return false;
+#endif
+    case pixel_conversion_backend::neon:
+#if defined(HOU_SYS_PIXEL_CONVERSION_NEON)
+      return true;
+#else
+      return false;
+#endif
+  }
+  return false;
+}
+
+
+
+pixel_conversion_backend get_pixel_conversion_backend() noexcept
+{
+  return get_backend_variable().load(std::memory_order_relaxed);
+}
+
+
+
+void set_pixel_conversion_backend(pixel_conversion_backend pcb)
+{
+  HOU_PRECOND(is_pixel_conversion_backend_supported(pcb));
+  get_backend_variable().store(pcb, std::memory_order_relaxed);
+}
+
+
+
+template void convert_pixels<pixel_format::r, pixel_format::r>(
+  const span<const pixel_r>&, const span<pixel_r>&);
+template void convert_pixels<pixel_format::r, pixel_format::rg>(
+  const span<const pixel_r>&, const span<pixel_rg>&);
+template void convert_pixels<pixel_format::r, pixel_format::rgb>(
+  const span<const pixel_r>&, const span<pixel_rgb>&);
+template void convert_pixels<pixel_format::r, pixel_format::rgba>(
+  const span<const pixel_r>&, const span<pixel_rgba>&);
+
+template void convert_pixels<pixel_format::rg, pixel_format::r>(
+  const span<const pixel_rg>&, const span<pixel_r>&);
+template void convert_pixels<pixel_format::rg, pixel_format::rg>(
+  const span<const pixel_rg>&, const span<pixel_rg>&);
+template void convert_pixels<pixel_format::rg, pixel_format::rgb>(
+  const span<const pixel_rg>&, const span<pixel_rgb>&);
+template void convert_pixels<pixel_format::rg, pixel_format::rgba>(
+  const span<const pixel_rg>&, const span<pixel_rgba>&);
+
+template void convert_pixels<pixel_format::rgb, pixel_format::r>(
+  const span<const pixel_rgb>&, const span<pixel_r>&);
+template void convert_pixels<pixel_format::rgb, pixel_format::rg>(
+  const span<const pixel_rgb>&, const span<pixel_rg>&);
+template void convert_pixels<pixel_format::rgb, pixel_format::rgb>(
+  const span<const pixel_rgb>&, const span<pixel_rgb>&);
+template void convert_pixels<pixel_format::rgb, pixel_format::rgba>(
+  const span<const pixel_rgb>&, const span<pixel_rgba>&);
+
+template void convert_pixels<pixel_format::rgba, pixel_format::r>(
+  const span<const pixel_rgba>&, const span<pixel_r>&);
+template void convert_pixels<pixel_format::rgba, pixel_format::rg>(
+  const span<const pixel_rgba>&, const span<pixel_rg>&);
+template void convert_pixels<pixel_format::rgba, pixel_format::rgb>(
+  const span<const pixel_rgba>&, const span<pixel_rgb>&);
+template void convert_pixels<pixel_format::rgba, pixel_format::rgba>(
+  const span<const pixel_rgba>&, const span<pixel_rgba>&);
+
+}  // namespace hou
@@ -0,0 +1,30 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/sys/pixel_conversion_backend.hpp"
+
+#include "hou/cor/core_functions.hpp"
+
+#define PIXEL_CONVERSION_BACKEND_CASE(pcb, os)                                 \
+  case pixel_conversion_backend::pcb:                                          \
+    return (os) << #pcb
+
+
+
+namespace hou
+{
+
+std::ostream& operator<<(std::ostream& os, pixel_conversion_backend pcb)
+{
+  switch(pcb)
+  {
+    PIXEL_CONVERSION_BACKEND_CASE(scalar, os);
+    PIXEL_CONVERSION_BACKEND_CASE(sse2, os);
+    PIXEL_CONVERSION_BACKEND_CASE(avx2, os);
+    PIXEL_CONVERSION_BACKEND_CASE(neon, os);
+  }
+  return STREAM_VALUE(os, pixel_conversion_backend, pcb);
+}
+
+}  // namespace hou
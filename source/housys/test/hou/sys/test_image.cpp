@@ -595,6 +595,167 @@ TYPED_TEST(test_image_death_test, set_sub_image_error_overflow)
 
 
 
+TYPED_TEST(test_image, get_sub_image_whole_rows)
+{
+  using size_type = typename TypeParam::size_type;
+  using offset_type = typename TypeParam::offset_type;
+
+  size_type image_size = TestFixture::generate_size();
+  TypeParam image(image_size, TestFixture::generate_pixels(image_size));
+  EXPECT_EQ(image, image.get_sub_image(offset_type::zero(), image_size));
+
+  // Sub-image made of whole rows, copied as a single block.
+  offset_type sub_image_offset = offset_type::zero();
+  size_type sub_image_size = image_size;
+  sub_image_offset(image_size.size() - 1u) = 1u;
+  sub_image_size(image_size.size() - 1u) -= 2u;
+  TypeParam sub_image = image.get_sub_image(sub_image_offset, sub_image_size);
+  for(size_t i = 0; i < sub_image.get_pixels().size(); ++i)
+  {
+    offset_type coords
+      = TestFixture::compute_pixel_coordinates(i, sub_image_size);
+    EXPECT_EQ(image.get_pixel(sub_image_offset + coords),
+      sub_image.get_pixels()[i]);
+  }
+}
+
+
+
+TYPED_TEST(test_image, blit)
+{
+  using size_type = typename TypeParam::size_type;
+  using offset_type = typename TypeParam::offset_type;
+  using signed_offset_type = vec<int, TypeParam::dimension_count>;
+
+  size_type dst_size;
+  size_type src_size;
+  signed_offset_type dst_offset;
+  offset_type src_offset;
+  size_type region_size;
+  for(size_t i = 0; i < dst_size.size(); ++i)
+  {
+    dst_size(i) = static_cast<uint>((i + 1) * 4);
+    src_size(i) = static_cast<uint>((i + 1) * 5);
+    src_offset(i) = static_cast<uint>(i + 1);
+    region_size(i) = static_cast<uint>((i + 1) * 5);
+    // The region is clipped on the lower bound of the destination along the
+    // first axis, and on the upper bounds along the other axes.
+    dst_offset(i) = i == 0u ? -2 : static_cast<int>(i + 1);
+  }
+
+  TypeParam src(src_size, TestFixture::generate_pixels(src_size));
+  TypeParam dst(dst_size);
+  TypeParam dst_ref(dst_size);
+  for(size_t i = 0; i < dst_ref.get_pixels().size(); ++i)
+  {
+    offset_type dst_coords
+      = TestFixture::compute_pixel_coordinates(i, dst_size);
+    offset_type src_coords;
+    bool inside = true;
+    for(size_t j = 0; j < dst_size.size(); ++j)
+    {
+      int region_coord = static_cast<int>(dst_coords(j)) - dst_offset(j);
+      inside = inside && region_coord >= 0
+        && region_coord < static_cast<int>(region_size(j))
+        && region_coord + static_cast<int>(src_offset(j))
+          < static_cast<int>(src_size(j));
+      src_coords(j) = static_cast<uint>(region_coord + src_offset(j));
+    }
+    if(inside)
+    {
+      dst_ref.set_pixel(dst_coords, src.get_pixel(src_coords));
+    }
+  }
+
+  blit(dst, dst_offset, src, src_offset, region_size);
+  EXPECT_EQ(dst_ref, dst);
+}
+
+
+
+TYPED_TEST(test_image, blit_whole_image)
+{
+  using size_type = typename TypeParam::size_type;
+  using offset_type = typename TypeParam::offset_type;
+  using signed_offset_type = vec<int, TypeParam::dimension_count>;
+
+  size_type size = TestFixture::generate_size();
+  TypeParam src(size, TestFixture::generate_pixels(size));
+  TypeParam dst(size);
+  blit(dst, signed_offset_type::zero(), src, offset_type::zero(), size);
+  EXPECT_EQ(src, dst);
+}
+
+
+
+TYPED_TEST(test_image, blit_outside)
+{
+  using size_type = typename TypeParam::size_type;
+  using offset_type = typename TypeParam::offset_type;
+  using signed_offset_type = vec<int, TypeParam::dimension_count>;
+
+  size_type size = TestFixture::generate_size();
+  TypeParam src(size, TestFixture::generate_pixels(size));
+  TypeParam dst(size);
+  TypeParam dst_ref(size);
+
+  signed_offset_type dst_offset = signed_offset_type::zero();
+  dst_offset(0) = static_cast<int>(size(0));
+  blit(dst, dst_offset, src, offset_type::zero(), size);
+  EXPECT_EQ(dst_ref, dst);
+
+  dst_offset(0) = -static_cast<int>(size(0));
+  blit(dst, dst_offset, src, offset_type::zero(), size);
+  EXPECT_EQ(dst_ref, dst);
+
+  offset_type src_offset = offset_type::zero();
+  src_offset(0) = size(0);
+  blit(dst, signed_offset_type::zero(), src, src_offset, size);
+  EXPECT_EQ(dst_ref, dst);
+}
+
+
+
+TYPED_TEST(test_image, blit_same_image)
+{
+  using size_type = typename TypeParam::size_type;
+  using offset_type = typename TypeParam::offset_type;
+  using signed_offset_type = vec<int, TypeParam::dimension_count>;
+
+  size_type size = TestFixture::generate_size();
+  TypeParam im(size, TestFixture::generate_pixels(size));
+  TypeParam im_ref = im;
+
+  size_type region_size = size;
+  region_size(0) = 2u;
+  offset_type dst_offset_ref = offset_type::zero();
+  dst_offset_ref(0) = 2u;
+  im_ref.set_sub_image(
+    dst_offset_ref, im.get_sub_image(offset_type::zero(), region_size));
+
+  signed_offset_type dst_offset = signed_offset_type::zero();
+  dst_offset(0) = 2;
+  blit(im, dst_offset, im, offset_type::zero(), region_size);
+  EXPECT_EQ(im_ref, im);
+}
+
+
+
+TYPED_TEST(test_image_death_test, blit_same_image_overlap)
+{
+  using size_type = typename TypeParam::size_type;
+  using offset_type = typename TypeParam::offset_type;
+  using signed_offset_type = vec<int, TypeParam::dimension_count>;
+
+  size_type size = TestFixture::generate_size();
+  TypeParam im(size);
+  signed_offset_type dst_offset = signed_offset_type::zero();
+  dst_offset(0) = 1;
+  EXPECT_PRECOND_ERROR(blit(im, dst_offset, im, offset_type::zero(), size));
+}
+
+
+
 TYPED_TEST(test_image, clear)
 {
   using size_type = typename TypeParam::size_type;
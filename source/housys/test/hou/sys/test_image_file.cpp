@@ -5,6 +5,8 @@
 #include "hou/test.hpp"
 #include "hou/sys/test_data.hpp"
 
+#include "hou/sys/binary_file_in.hpp"
+#include "hou/sys/binary_file_out.hpp"
 #include "hou/sys/file.hpp"
 #include "hou/sys/image.hpp"
 #include "hou/sys/image_file.hpp"
@@ -29,6 +31,8 @@ public:
 
 using test_image_file_death_test = test_image_file;
 
+void write_palette_png(const std::string& path, bool transparent);
+
 
 
 const std::string test_image_file::test_image_bmp
@@ -43,6 +47,30 @@ const std::string test_image_file::test_image_jpg
 const std::string test_image_file::test_image_invalid
   = get_data_dir() + u8"TestImage.xcf";
 
+
+
+void write_palette_png(const std::string& path, bool transparent)
+{
+  // Only the chunk headers matter for get_image_info, the CRCs are left to 0.
+  std::vector<uint8_t> data{0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n',
+    // IHDR: 2x1 pixels, 8 bit depth, palette color type.
+    0, 0, 0, 13, 'I', 'H', 'D', 'R', 0, 0, 0, 2, 0, 0, 0, 1, 8, 3, 0, 0, 0,
+    0, 0, 0, 0,
+    // PLTE: 2 entries.
+    0, 0, 0, 6, 'P', 'L', 'T', 'E', 255, 0, 0, 0, 255, 0, 0, 0, 0, 0};
+  if(transparent)
+  {
+    std::vector<uint8_t> trns{
+      0, 0, 0, 1, 't', 'R', 'N', 'S', 128, 0, 0, 0, 0};
+    data.insert(data.end(), trns.begin(), trns.end());
+  }
+  std::vector<uint8_t> tail{0, 0, 0, 0, 'I', 'D', 'A', 'T', 0, 0, 0, 0,
+    0, 0, 0, 0, 'I', 'E', 'N', 'D', 0, 0, 0, 0};
+  data.insert(data.end(), tail.begin(), tail.end());
+  binary_file_out fo(path);
+  fo.write(data);
+}
+
 }  // namespace
 
 
@@ -59,20 +87,147 @@ TEST_F(test_image_file, check_bmp)
 
 TEST_F(test_image_file, check_png)
 {
-  EXPECT_TRUE(bmp_image_file::check(test_image_bmp));
-  EXPECT_FALSE(bmp_image_file::check(test_image_png));
-  EXPECT_FALSE(bmp_image_file::check(test_image_jpg));
-  EXPECT_FALSE(bmp_image_file::check(test_image_invalid));
+  EXPECT_FALSE(png_image_file::check(test_image_bmp));
+  EXPECT_TRUE(png_image_file::check(test_image_png));
+  EXPECT_FALSE(png_image_file::check(test_image_jpg));
+  EXPECT_FALSE(png_image_file::check(test_image_invalid));
 }
 
 
 
 TEST_F(test_image_file, check_jpg)
 {
-  EXPECT_TRUE(bmp_image_file::check(test_image_bmp));
-  EXPECT_FALSE(bmp_image_file::check(test_image_png));
-  EXPECT_FALSE(bmp_image_file::check(test_image_jpg));
-  EXPECT_FALSE(bmp_image_file::check(test_image_invalid));
+  EXPECT_FALSE(jpg_image_file::check(test_image_bmp));
+  EXPECT_FALSE(jpg_image_file::check(test_image_png));
+  EXPECT_TRUE(jpg_image_file::check(test_image_jpg));
+  EXPECT_FALSE(jpg_image_file::check(test_image_invalid));
+}
+
+
+
+TEST_F(test_image_file, check_empty_file)
+{
+  const std::string path = get_output_dir() + "emptyImage.bmp";
+  remove_dir(path);
+  {
+    file f(path, file_open_mode::write, file_type::binary);
+  }
+  EXPECT_FALSE(bmp_image_file::check(path));
+  EXPECT_FALSE(png_image_file::check(path));
+  EXPECT_FALSE(jpg_image_file::check(path));
+  EXPECT_TRUE(remove_dir(path));
+}
+
+
+
+TEST_F(test_image_file, image_file_format_output_stream_operator)
+{
+  EXPECT_OUTPUT("bmp", image_file_format::bmp);
+  EXPECT_OUTPUT("png", image_file_format::png);
+  EXPECT_OUTPUT("jpg", image_file_format::jpg);
+}
+
+
+
+TEST_F(test_image_file, get_image_info_bmp)
+{
+  image_file_info info = get_image_info(test_image_bmp);
+  EXPECT_EQ(image_file_format::bmp, info.format);
+  EXPECT_EQ(vec2u(3u, 2u), info.size);
+  EXPECT_EQ(3u, info.channel_count);
+}
+
+
+
+TEST_F(test_image_file, get_image_info_png)
+{
+  image_file_info info = get_image_info(test_image_png);
+  EXPECT_EQ(image_file_format::png, info.format);
+  EXPECT_EQ(vec2u(3u, 2u), info.size);
+  EXPECT_EQ(4u, info.channel_count);
+}
+
+
+
+TEST_F(test_image_file, get_image_info_palette_png)
+{
+  const std::string path = get_output_dir() + "paletteImage.png";
+  remove_dir(path);
+  write_palette_png(path, false);
+  image_file_info info = get_image_info(path);
+  EXPECT_EQ(image_file_format::png, info.format);
+  EXPECT_EQ(vec2u(2u, 1u), info.size);
+  EXPECT_EQ(3u, info.channel_count);
+  EXPECT_TRUE(remove_dir(path));
+}
+
+
+
+TEST_F(test_image_file, get_image_info_transparent_palette_png)
+{
+  const std::string path = get_output_dir() + "transparentPaletteImage.png";
+  remove_dir(path);
+  write_palette_png(path, true);
+  image_file_info info = get_image_info(path);
+  EXPECT_EQ(image_file_format::png, info.format);
+  EXPECT_EQ(vec2u(2u, 1u), info.size);
+  EXPECT_EQ(4u, info.channel_count);
+  EXPECT_TRUE(remove_dir(path));
+}
+
+
+
+TEST_F(test_image_file, get_image_info_jpg)
+{
+  image_file_info info = get_image_info(test_image_jpg);
+  EXPECT_EQ(image_file_format::jpg, info.format);
+  EXPECT_EQ(vec2u(3u, 2u), info.size);
+  EXPECT_EQ(3u, info.channel_count);
+}
+
+
+
+TEST_F(test_image_file, get_image_info_saved_bmp)
+{
+  const std::string save_path = get_output_dir() + "savedBmpInfo.bmp";
+  remove_dir(save_path);
+  bmp_image_file::write(save_path, image2_rgba(vec2u(5u, 7u)));
+  image_file_info info = get_image_info(save_path);
+  EXPECT_EQ(image_file_format::bmp, info.format);
+  EXPECT_EQ(vec2u(5u, 7u), info.size);
+  EXPECT_TRUE(remove_dir(save_path));
+}
+
+
+
+TEST_F(test_image_file_death_test, get_image_info_invalid_file)
+{
+  EXPECT_ERROR_0(get_image_info(test_image_invalid), invalid_image_data);
+}
+
+
+
+TEST_F(test_image_file_death_test, get_image_info_truncated_jpg)
+{
+  const std::string path = get_output_dir() + "truncatedImage.jpg";
+  remove_dir(path);
+  {
+    std::vector<uint8_t> data = binary_file_in(test_image_jpg)
+      .read_all<std::vector<uint8_t>>();
+    data.resize(64u);
+    binary_file_out fo(path);
+    fo.write(data);
+  }
+  EXPECT_ERROR_0(get_image_info(path), invalid_image_data);
+  EXPECT_TRUE(remove_dir(path));
+}
+
+
+
+TEST_F(test_image_file_death_test, get_image_info_missing_file)
+{
+  const std::string path = get_data_dir() + "NotAnImage.png";
+  EXPECT_ERROR_N(get_image_info(path), file_open_error, path);
 }
 
 
@@ -153,6 +308,105 @@ TEST_F(test_image_file_death_test, load_jpg_rgba_error)
 
 
 
+TEST_F(test_image_file, load_bmp_rgba_from_stream)
+{
+  image2_rgba im_ref = bmp_image_file::read<pixel_format::rgba>(test_image_bmp);
+  binary_file_in fi(test_image_bmp);
+  image2_rgba im = bmp_image_file::read<pixel_format::rgba>(fi);
+  EXPECT_EQ(im_ref, im);
+}
+
+
+
+TEST_F(test_image_file, load_bmp_rgba_from_memory)
+{
+  image2_rgba im_ref = bmp_image_file::read<pixel_format::rgba>(test_image_bmp);
+  std::vector<uint8_t> data
+    = binary_file_in(test_image_bmp).read_all<std::vector<uint8_t>>();
+  image2_rgba im = bmp_image_file::read_from_memory<pixel_format::rgba>(
+    span<const uint8_t>(data));
+  EXPECT_EQ(im_ref, im);
+}
+
+
+
+TEST_F(test_image_file_death_test, load_bmp_rgba_from_memory_error)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(test_image_png).read_all<std::vector<uint8_t>>();
+  EXPECT_ERROR_0(bmp_image_file::read_from_memory<pixel_format::rgba>(
+                   span<const uint8_t>(data)),
+    invalid_image_data);
+}
+
+
+
+TEST_F(test_image_file, load_png_rgba_from_stream)
+{
+  image2_rgba im_ref = png_image_file::read<pixel_format::rgba>(test_image_png);
+  binary_file_in fi(test_image_png);
+  image2_rgba im = png_image_file::read<pixel_format::rgba>(fi);
+  EXPECT_EQ(im_ref, im);
+}
+
+
+
+TEST_F(test_image_file, load_png_rgba_from_memory)
+{
+  image2_rgba im_ref = png_image_file::read<pixel_format::rgba>(test_image_png);
+  std::vector<uint8_t> data
+    = binary_file_in(test_image_png).read_all<std::vector<uint8_t>>();
+  image2_rgba im = png_image_file::read_from_memory<pixel_format::rgba>(
+    span<const uint8_t>(data));
+  EXPECT_EQ(im_ref, im);
+}
+
+
+
+TEST_F(test_image_file_death_test, load_png_rgba_from_memory_error)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(test_image_jpg).read_all<std::vector<uint8_t>>();
+  EXPECT_ERROR_0(png_image_file::read_from_memory<pixel_format::rgba>(
+                   span<const uint8_t>(data)),
+    invalid_image_data);
+}
+
+
+
+TEST_F(test_image_file, load_jpg_rgba_from_stream)
+{
+  image2_rgba im_ref = jpg_image_file::read<pixel_format::rgba>(test_image_jpg);
+  binary_file_in fi(test_image_jpg);
+  image2_rgba im = jpg_image_file::read<pixel_format::rgba>(fi);
+  EXPECT_EQ(im_ref, im);
+}
+
+
+
+TEST_F(test_image_file, load_jpg_rgba_from_memory)
+{
+  image2_rgba im_ref = jpg_image_file::read<pixel_format::rgba>(test_image_jpg);
+  std::vector<uint8_t> data
+    = binary_file_in(test_image_jpg).read_all<std::vector<uint8_t>>();
+  image2_rgba im = jpg_image_file::read_from_memory<pixel_format::rgba>(
+    span<const uint8_t>(data));
+  EXPECT_EQ(im_ref, im);
+}
+
+
+
+TEST_F(test_image_file_death_test, load_jpg_rgba_from_memory_error)
+{
+  std::vector<uint8_t> data
+    = binary_file_in(test_image_png).read_all<std::vector<uint8_t>>();
+  EXPECT_ERROR_0(jpg_image_file::read_from_memory<pixel_format::rgba>(
+                   span<const uint8_t>(data)),
+    invalid_image_data);
+}
+
+
+
 TEST_F(test_image_file, save_bmp_rgba)
 {
   const std::string save_path = get_output_dir() + "savedBmp.bmp";
@@ -0,0 +1,150 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/test.hpp"
+#include "hou/sys/test_data.hpp"
+
+#include "hou/sys/image_file.hpp"
+#include "hou/sys/image_loading.hpp"
+#include "hou/sys/sys_exceptions.hpp"
+
+#include <thread>
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_image_loading : public Test
+{
+public:
+  static const std::string test_image_bmp;
+  static const std::string test_image_png;
+  static const std::string test_image_jpg;
+  static const std::string test_image_invalid;
+
+public:
+  static std::vector<std::string> get_paths(size_t count);
+};
+
+using test_image_loading_death_test = test_image_loading;
+
+
+
+const std::string test_image_loading::test_image_bmp
+  = get_data_dir() + u8"TestImage.bmp";
+
+const std::string test_image_loading::test_image_png
+  = get_data_dir() + u8"TestImage.png";
+
+const std::string test_image_loading::test_image_jpg
+  = get_data_dir() + u8"TestImage.jpg";
+
+const std::string test_image_loading::test_image_invalid
+  = get_data_dir() + u8"TestImage.xcf";
+
+
+
+std::vector<std::string> test_image_loading::get_paths(size_t count)
+{
+  const std::string* files[]
+    = {&test_image_bmp, &test_image_png, &test_image_jpg};
+  std::vector<std::string> paths;
+  for(size_t i = 0; i < count; ++i)
+  {
+    paths.push_back(*files[i % 3u]);
+  }
+  return paths;
+}
+
+}  // namespace
+
+
+
+TEST_F(test_image_loading, read_image)
+{
+  EXPECT_EQ(bmp_image_file::read<pixel_format::rgba>(test_image_bmp),
+    read_image<pixel_format::rgba>(test_image_bmp));
+  EXPECT_EQ(png_image_file::read<pixel_format::rgba>(test_image_png),
+    read_image<pixel_format::rgba>(test_image_png));
+  EXPECT_EQ(jpg_image_file::read<pixel_format::rgba>(test_image_jpg),
+    read_image<pixel_format::rgba>(test_image_jpg));
+}
+
+
+
+TEST_F(test_image_loading_death_test, read_image_invalid_file)
+{
+  EXPECT_ERROR_0(
+    read_image<pixel_format::rgba>(test_image_invalid), invalid_image_data);
+}
+
+
+
+TEST_F(test_image_loading, load_images)
+{
+  std::vector<std::string> paths = get_paths(20u);
+  std::vector<image2_rgb> images_ref;
+  for(const auto& path : paths)
+  {
+    images_ref.push_back(read_image<pixel_format::rgb>(path));
+  }
+  EXPECT_EQ(images_ref, load_images<pixel_format::rgb>(paths, 1u));
+  EXPECT_EQ(images_ref, load_images<pixel_format::rgb>(paths, 4u));
+  EXPECT_EQ(images_ref, load_images<pixel_format::rgb>(paths, 64u));
+}
+
+
+
+TEST_F(test_image_loading, load_no_images)
+{
+  EXPECT_TRUE(load_images<pixel_format::r>({}, 4u).empty());
+}
+
+
+
+TEST_F(test_image_loading, load_images_callback)
+{
+  std::vector<std::string> paths = get_paths(20u);
+  std::vector<size_t> call_counts(paths.size(), 0u);
+  std::thread::id caller_id = std::this_thread::get_id();
+  load_images<pixel_format::rgba>(
+    paths, 4u, [&](size_t index, image2_rgba& im) {
+      ASSERT_LT(index, paths.size());
+      ++call_counts[index];
+      EXPECT_EQ(caller_id, std::this_thread::get_id());
+      EXPECT_EQ(read_image<pixel_format::rgba>(paths[index]), im);
+    });
+  EXPECT_EQ(std::vector<size_t>(paths.size(), 1u), call_counts);
+}
+
+
+
+TEST_F(test_image_loading_death_test, load_images_invalid_file)
+{
+  std::vector<std::string> paths = get_paths(20u);
+  paths[7u] = test_image_invalid;
+  EXPECT_ERROR_0(
+    load_images<pixel_format::rgba>(paths, 4u), invalid_image_data);
+}
+
+
+
+TEST_F(test_image_loading_death_test, load_images_missing_file)
+{
+  std::vector<std::string> paths = get_paths(20u);
+  paths[3u] = get_data_dir() + u8"NotAnImage.png";
+  EXPECT_ERROR_N(
+    load_images<pixel_format::rgba>(paths, 4u), file_open_error, paths[3u]);
+}
+
+
+
+TEST_F(test_image_loading_death_test, load_images_no_threads)
+{
+  EXPECT_PRECOND_ERROR(load_images<pixel_format::rgba>(get_paths(3u), 0u));
+}
@@ -0,0 +1,213 @@
+// Houzi Game Engine
+// Copyright (c) 2018 Davide Corradi
+// Licensed under the MIT license.
+
+#include "hou/test.hpp"
+
+#include "hou/sys/pixel_conversion.hpp"
+
+#include <vector>
+
+using namespace hou;
+using namespace testing;
+
+
+
+namespace
+{
+
+class test_pixel_conversion : public Test
+{
+public:
+  static const std::vector<pixel_conversion_backend>& get_backends();
+
+public:
+  void SetUp() override;
+  void TearDown() override;
+
+private:
+  pixel_conversion_backend m_backend;
+};
+
+class test_pixel_conversion_death_test : public test_pixel_conversion
+{};
+
+template <pixel_format PF>
+std::vector<pixel<PF>> generate_pixels(size_t count);
+
+// Checks that the conversion gives the same result as the pixel conversion
+// constructor, with every supported backend and for several sequence lengths,
+// so that the scalar tail of the SIMD kernels is exercised too.
+template <pixel_format InPF, pixel_format OutPF>
+void check_conversion();
+
+
+
+const std::vector<pixel_conversion_backend>&
+  test_pixel_conversion::get_backends()
+{
+  static const std::vector<pixel_conversion_backend> v
+  {
+    pixel_conversion_backend::scalar,
+    pixel_conversion_backend::sse2,
+    pixel_conversion_backend::avx2,
+    pixel_conversion_backend::neon,
+  };
+  return v;
+}
+
+
+
+void test_pixel_conversion::SetUp()
+{
+  m_backend = get_pixel_conversion_backend();
+}
+
+
+
+void test_pixel_conversion::TearDown()
+{
+  set_pixel_conversion_backend(m_backend);
+}
+
+
+
+template <pixel_format PF>
+std::vector<pixel<PF>> generate_pixels(size_t count)
+{
+  std::vector<pixel<PF>> pixels(count);
+  uint32_t state = 12345u;
+  for(auto& px : pixels)
+  {
+    state = state * 1103515245u + 12345u;
+    px = pixel_rgba(static_cast<uint8_t>(state >> 24),
+      static_cast<uint8_t>(state >> 16), static_cast<uint8_t>(state >> 8),
+      static_cast<uint8_t>(state >> 4));
+  }
+  return pixels;
+}
+
+
+
+template <pixel_format InPF, pixel_format OutPF>
+void check_conversion()
+{
+  for(size_t count : {0u, 1u, 7u, 15u, 16u, 17u, 33u, 64u, 1021u})
+  {
+    std::vector<pixel<InPF>> in = generate_pixels<InPF>(count);
+    std::vector<pixel<OutPF>> out_ref(count);
+    for(size_t i = 0; i < count; ++i)
+    {
+      out_ref[i] = pixel<OutPF>(in[i]);
+    }
+
+    for(auto pcb : test_pixel_conversion::get_backends())
+    {
+      if(!is_pixel_conversion_backend_supported(pcb))
+      {
+        continue;
+      }
+      set_pixel_conversion_backend(pcb);
+      std::vector<pixel<OutPF>> out(count);
+      convert_pixels(span<const pixel<InPF>>(in), span<pixel<OutPF>>(out));
+      EXPECT_EQ(out_ref, out) << "Backend: " << pcb << ", count: " << count;
+    }
+  }
+}
+
+}  // namespace
+
+
+
+TEST_F(test_pixel_conversion, output_stream_operator)
+{
+  EXPECT_OUTPUT("scalar", pixel_conversion_backend::scalar);
+  EXPECT_OUTPUT("sse2", pixel_conversion_backend::sse2);
+  EXPECT_OUTPUT("avx2", pixel_conversion_backend::avx2);
+  EXPECT_OUTPUT("neon", pixel_conversion_backend::neon);
+}
+
+
+
+TEST_F(test_pixel_conversion, scalar_backend_is_supported)
+{
+  EXPECT_TRUE(
+    is_pixel_conversion_backend_supported(pixel_conversion_backend::scalar));
+}
+
+
+
+TEST_F(test_pixel_conversion, set_pixel_conversion_backend)
+{
+  for(auto pcb : get_backends())
+  {
+    if(is_pixel_conversion_backend_supported(pcb))
+    {
+      set_pixel_conversion_backend(pcb);
+      EXPECT_EQ(pcb, get_pixel_conversion_backend());
+    }
+  }
+}
+
+
+
+TEST_F(test_pixel_conversion_death_test, set_unsupported_backend)
+{
+  for(auto pcb : get_backends())
+  {
+    if(!is_pixel_conversion_backend_supported(pcb))
+    {
+      EXPECT_PRECOND_ERROR(set_pixel_conversion_backend(pcb));
+    }
+  }
+}
+
+
+
+TEST_F(test_pixel_conversion, convert_from_r)
+{
+  check_conversion<pixel_format::r, pixel_format::r>();
+  check_conversion<pixel_format::r, pixel_format::rg>();
+  check_conversion<pixel_format::r, pixel_format::rgb>();
+  check_conversion<pixel_format::r, pixel_format::rgba>();
+}
+
+
+
+TEST_F(test_pixel_conversion, convert_from_rg)
+{
+  check_conversion<pixel_format::rg, pixel_format::r>();
+  check_conversion<pixel_format::rg, pixel_format::rg>();
+  check_conversion<pixel_format::rg, pixel_format::rgb>();
+  check_conversion<pixel_format::rg, pixel_format::rgba>();
+}
+
+
+
+TEST_F(test_pixel_conversion, convert_from_rgb)
+{
+  check_conversion<pixel_format::rgb, pixel_format::r>();
+  check_conversion<pixel_format::rgb, pixel_format::rg>();
+  check_conversion<pixel_format::rgb, pixel_format::rgb>();
+  check_conversion<pixel_format::rgb, pixel_format::rgba>();
+}
+
+
+
+TEST_F(test_pixel_conversion, convert_from_rgba)
+{
+  check_conversion<pixel_format::rgba, pixel_format::r>();
+  check_conversion<pixel_format::rgba, pixel_format::rg>();
+  check_conversion<pixel_format::rgba, pixel_format::rgb>();
+  check_conversion<pixel_format::rgba, pixel_format::rgba>();
+}
+
+
+
+TEST_F(test_pixel_conversion_death_test, size_mismatch)
+{
+  std::vector<pixel_rgba> in(4u);
+  std::vector<pixel_r> out(3u);
+  EXPECT_PRECOND_ERROR(
+    convert_pixels(span<const pixel_rgba>(in), span<pixel_r>(out)));
+}